@@ -11,6 +11,8 @@
 
 #include "source/common/protobuf/protobuf.h"
 
+#include "absl/status/status.h"
+
 namespace Envoy {
 namespace Config {
 
@@ -70,6 +72,20 @@ public:
 using DecodedResourcePtr = std::unique_ptr<DecodedResource>;
 using DecodedResourceRef = std::reference_wrapper<DecodedResource>;
 
+/**
+ * A resource that has been unpacked by OpaqueResourceDecoder::preDecodeResource(), possibly off the
+ * main thread, and whose decoding is completed by OpaqueResourceDecoder::finishDecodeResource().
+ */
+struct PreDecodedResource {
+  // The unpacked resource, if unpacking succeeded.
+  ProtobufTypes::MessagePtr resource_;
+  // The error that unpacking the resource failed with, if any.
+  absl::Status unpack_status_;
+  // The protoc-gen-validate error of the resource, if any. It is only reported once the checks that
+  // must run on the main thread have passed, in the same order as decodeResource() would.
+  std::string validation_error_;
+};
+
 class OpaqueResourceDecoder {
 public:
   virtual ~OpaqueResourceDecoder() = default;
@@ -81,6 +97,24 @@ public:
    */
   virtual ProtobufTypes::MessagePtr decodeResource(const ProtobufWkt::Any& resource) PURE;
 
+  /**
+   * Performs the part of decodeResource() that may run concurrently on any thread, i.e. unpacking
+   * the resource and checking its protoc-gen-validate constraints. Errors are not thrown, but
+   * recorded for finishDecodeResource().
+   * @param resource some opaque resource (ProtobufWkt::Any).
+   * @return PreDecodedResource the partially decoded resource.
+   */
+  virtual PreDecodedResource preDecodeResource(const ProtobufWkt::Any& resource) PURE;
+
+  /**
+   * Completes the decoding of a resource started by preDecodeResource(). Must be called on the main
+   * thread.
+   * @param pre_decoded the result of preDecodeResource().
+   * @return ProtobufTypes::MessagePtr the same decoded protobuf message as decodeResource().
+   * @throw EnvoyException if the resource is invalid, as decodeResource() would.
+   */
+  virtual ProtobufTypes::MessagePtr finishDecodeResource(PreDecodedResource&& pre_decoded) PURE;
+
   /**
    * @param resource some opaque resource (Protobuf::Message).
    * @return std::String the resource name in a Protobuf::Message returned by decodeResource(), e.g.
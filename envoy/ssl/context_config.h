@@ -9,6 +9,7 @@
 #include "envoy/common/pure.h"
 #include "envoy/ssl/certificate_validation_context_config.h"
 #include "envoy/ssl/handshaker.h"
+#include "envoy/ssl/session_cache.h"
 #include "envoy/ssl/tls_certificate_config.h"
 
 #include "source/common/network/cidr_range.h"
@@ -194,6 +195,12 @@ public:
    */
   virtual bool disableStatefulSessionResumption() const PURE;
 
+  /**
+   * @return the session cache shared with other contexts to use for stateful TLS session
+   * resumption, or nullptr to use a cache of the context's own.
+   */
+  virtual SessionCacheSharedPtr sharedSessionCache() const PURE;
+
   /**
    * @return True if we allow full scan certificates when there is no cert matching SNI during
    * downstream TLS handshake, false otherwise.
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "envoy/common/pure.h"
+#include "envoy/common/time.h"
+
+#include "absl/strings/string_view.h"
+#include "absl/types/optional.h"
+
+namespace Envoy {
+namespace Ssl {
+
+/**
+ * A cache of TLS sessions for stateful session resumption, which may be shared by several server
+ * contexts. All the methods are thread safe, as the cache is accessed from every worker.
+ */
+class SessionCache {
+public:
+  virtual ~SessionCache() = default;
+
+  /**
+   * Stores a session, replacing any session with the same ID.
+   * @param session_id supplies the ID of the session.
+   * @param session supplies the session, serialized with SSL_SESSION_to_bytes().
+   * @param expire_at supplies the time after which the session can no longer be resumed.
+   */
+  virtual void insert(absl::string_view session_id, std::string&& session,
+                      SystemTime expire_at) PURE;
+
+  /**
+   * @param session_id supplies the ID of the session.
+   * @return the serialized session with the given ID, or absl::nullopt if it is not in the cache
+   *         or has expired.
+   */
+  virtual absl::optional<std::string> lookup(absl::string_view session_id) PURE;
+
+  /**
+   * Removes a session, e.g. because it is no longer resumable.
+   * @param session_id supplies the ID of the session.
+   */
+  virtual void remove(absl::string_view session_id) PURE;
+};
+
+using SessionCacheSharedPtr = std::shared_ptr<SessionCache>;
+
+} // namespace Ssl
+} // namespace Envoy
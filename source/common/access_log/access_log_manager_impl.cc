@@ -1,6 +1,8 @@
 #include "source/common/access_log/access_log_manager_impl.h"
 
+#include <functional>
 #include <string>
+#include <thread>
 
 #include "envoy/common/exception.h"
 
@@ -91,8 +93,10 @@ AccessLogFileImpl::~AccessLogFileImpl() {
 
   // Flush any remaining data. If file was not opened for some reason, skip flushing part.
   if (file_->isOpen()) {
-    if (flush_buffer_.length() > 0) {
-      doWrite(flush_buffer_);
+    Thread::LockGuard flush_lock(flush_lock_);
+    collectWriteBuffers();
+    if (about_to_write_buffer_.length() > 0) {
+      doWrite(about_to_write_buffer_);
     }
     const Api::IoCallBoolResult result = file_->close();
     ASSERT(result.return_value_, fmt::format("unable to close file '{}': {}", file_->path(),
@@ -142,13 +146,13 @@ void AccessLogFileImpl::flushThreadFunc() {
     {
       Thread::LockGuard write_lock(write_lock_);
 
-      // flush_event_ can be woken up either by large enough flush_buffer or by timer.
-      // In case it was timer, flush_buffer_ can be empty.
+      // flush_event_ can be woken up either by large enough write buffers or by timer.
+      // In case it was timer, write buffers can be empty.
       //
       // Note: do not stop waiting when only `do_reopen` is true. In this case, we tried to
       // reopen and failed. We don't want to retry this in a tight loop, so wait for the next
       // event (timer or flush).
-      while (flush_buffer_.length() == 0 && !flush_thread_exit_ && !reopen_file_) {
+      while (buffered_bytes_ == 0 && !flush_thread_exit_ && !reopen_file_) {
         // CondVar::wait() does not throw, so it's safe to pass the mutex rather than the guard.
         flush_event_.wait(write_lock_);
       }
@@ -158,8 +162,7 @@ void AccessLogFileImpl::flushThreadFunc() {
       }
 
       flush_lock = std::unique_lock<Thread::BasicLockable>(flush_lock_);
-      about_to_write_buffer_.move(flush_buffer_);
-      ASSERT(flush_buffer_.length() == 0);
+      collectWriteBuffers();
 
       if (reopen_file_) {
         do_reopen = true;
@@ -193,37 +196,63 @@ void AccessLogFileImpl::flush() {
 
     // flush_lock_ must be held while checking this or else it is
     // possible that flushThreadFunc() has already moved data from
-    // flush_buffer_ to about_to_write_buffer_, has unlocked write_lock_,
+    // write_buffers_ to about_to_write_buffer_, has unlocked write_lock_,
     // but has not yet completed doWrite(). This would allow flush() to
     // return before the pending data has actually been written to disk.
     flush_buffer_lock = std::unique_lock<Thread::BasicLockable>(flush_lock_);
 
-    if (flush_buffer_.length() == 0) {
+    if (buffered_bytes_ == 0) {
       return;
     }
 
-    about_to_write_buffer_.move(flush_buffer_);
-    ASSERT(flush_buffer_.length() == 0);
+    collectWriteBuffers();
   }
 
   doWrite(about_to_write_buffer_);
 }
 
 void AccessLogFileImpl::write(absl::string_view data) {
-  Thread::LockGuard lock(write_lock_);
+  stats_.write_buffered_.inc();
+  stats_.write_total_buffered_.add(data.length());
+  uint64_t previously_buffered;
+  {
+    WriteBuffer& write_buffer = writeBufferForCurrentThread();
+    Thread::LockGuard lock(write_buffer.lock_);
+    write_buffer.buffer_.add(data.data(), data.size());
+    previously_buffered = buffered_bytes_.fetch_add(data.size());
+  }
 
-  if (flush_thread_ == nullptr) {
-    createFlushStructures();
+  // The flush thread is started after the first data is buffered, so that it flushes that data on
+  // its first loop.
+  if (!flush_thread_started_.load(std::memory_order_acquire)) {
+    Thread::LockGuard lock(write_lock_);
+    if (flush_thread_ == nullptr) {
+      createFlushStructures();
+      flush_thread_started_.store(true, std::memory_order_release);
+    }
   }
 
-  stats_.write_buffered_.inc();
-  stats_.write_total_buffered_.add(data.length());
-  flush_buffer_.add(data.data(), data.size());
-  if (flush_buffer_.length() > MIN_FLUSH_SIZE) {
+  // Only wake the flush thread when crossing the threshold. If it is busy writing at that moment,
+  // it finds the buffered data once done, before waiting again.
+  if (previously_buffered <= MIN_FLUSH_SIZE && previously_buffered + data.size() > MIN_FLUSH_SIZE) {
+    Thread::LockGuard lock(write_lock_);
     flush_event_.notifyOne();
   }
 }
 
+AccessLogFileImpl::WriteBuffer& AccessLogFileImpl::writeBufferForCurrentThread() {
+  return write_buffers_[std::hash<std::thread::id>()(std::this_thread::get_id()) %
+                        NUM_WRITE_BUFFERS];
+}
+
+void AccessLogFileImpl::collectWriteBuffers() {
+  for (WriteBuffer& write_buffer : write_buffers_) {
+    Thread::LockGuard lock(write_buffer.lock_);
+    buffered_bytes_ -= write_buffer.buffer_.length();
+    about_to_write_buffer_.move(write_buffer.buffer_);
+  }
+}
+
 void AccessLogFileImpl::createFlushStructures() {
   flush_thread_ = thread_factory_.createThread([this]() -> void { flushThreadFunc(); },
                                                Thread::Options{"AccessLogFlush"});
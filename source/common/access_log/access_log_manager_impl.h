@@ -1,5 +1,7 @@
 #pragma once
 
+#include <array>
+#include <atomic>
 #include <string>
 
 #include "envoy/access_log/access_log.h"
@@ -82,23 +84,36 @@ public:
   void flush() override;
 
 private:
+  // Buffer that written data is appended to. There are several of them, selected by the writing
+  // thread, so that workers logging to the same file rarely contend on the same lock.
+  struct WriteBuffer {
+    Thread::MutexBasicLockable lock_;
+    Buffer::OwnedImpl buffer_ ABSL_GUARDED_BY(lock_);
+  };
+
   void doWrite(Buffer::Instance& buffer);
   void flushThreadFunc();
   Api::IoCallBoolResult open();
   void createFlushStructures();
+  WriteBuffer& writeBufferForCurrentThread();
+  // Moves the data of all write buffers into about_to_write_buffer_. Data written by any single
+  // thread keeps its order. Must be called with flush_lock_ held.
+  void collectWriteBuffers();
 
   // return default flags set which used by open
   static Filesystem::FlagSet defaultFlags();
 
   // Minimum size before the flush thread will be told to flush.
   static const uint64_t MIN_FLUSH_SIZE = 1024 * 64;
+  static constexpr uint32_t NUM_WRITE_BUFFERS = 16;
 
   Filesystem::FilePtr file_;
 
   // These locks are always acquired in the following order if multiple locks are held:
   //    1) write_lock_
   //    2) flush_lock_
-  //    3) file_lock_
+  //    3) WriteBuffer::lock_ of a single write buffer
+  //    4) file_lock_
   Thread::BasicLockable& file_lock_;      // This lock is used only by the flush thread when writing
                                           // to disk. This is used to make sure that file blocks do
                                           // not get interleaved by multiple processes writing to
@@ -108,24 +123,26 @@ private:
                                           // concurrent access to the about_to_write_buffer_, fd_,
                                           // and all other data used during flushing and file
                                           // re-opening.
-  Thread::MutexBasicLockable
-      write_lock_; // The lock is used when filling the flush buffer. It allows
-                   // multiple threads to write to the same file at relatively
-                   // high performance. It is always local to the process.
+  Thread::MutexBasicLockable write_lock_; // This lock guards the flush thread state and is used
+                                          // with flush_event_ to wake the flush thread. Writers
+                                          // only take it to start the flush thread or to signal
+                                          // that MIN_FLUSH_SIZE was reached.
   Thread::ThreadPtr flush_thread_;
+  std::atomic<bool> flush_thread_started_{false};
   Thread::CondVar flush_event_;
   bool flush_thread_exit_ ABSL_GUARDED_BY(write_lock_){false};
   bool reopen_file_ ABSL_GUARDED_BY(write_lock_){false};
-  Buffer::OwnedImpl
-      flush_buffer_ ABSL_GUARDED_BY(write_lock_); // This buffer is used by multiple threads. It
-                                                  // gets filled and then flushed either when max
-                                                  // size is reached or when a timer fires.
+  std::array<WriteBuffer, NUM_WRITE_BUFFERS>
+      write_buffers_; // These buffers are filled by writing threads and then flushed either when
+                      // MIN_FLUSH_SIZE is reached or when a timer fires.
+  std::atomic<uint64_t> buffered_bytes_{0}; // Total length of write_buffers_. Only updated with
+                                            // the lock of the modified write buffer held.
   // TODO(jmarantz): this should be ABSL_GUARDED_BY(flush_lock_) but the analysis cannot poke
   // through the std::make_unique assignment. I do not believe it's possible to annotate this
   // properly now due to limitations in the clang thread annotation analysis.
   Buffer::OwnedImpl about_to_write_buffer_; // This buffer is used only by the flush thread. Data
-                                            // is moved from flush_buffer_ under lock, and then
-                                            // the lock is released so that flush_buffer_ can
+                                            // is moved from write_buffers_ under lock, and then
+                                            // the lock is released so that write_buffers_ can
                                             // continue to fill. This buffer is then used for the
                                             // final write to disk.
   Event::TimerPtr flush_timer_;
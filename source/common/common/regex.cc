@@ -1,5 +1,7 @@
 #include "source/common/common/regex.h"
 
+#include <algorithm>
+
 #include "envoy/common/exception.h"
 #include "envoy/extensions/regex_engines/v3/google_re2.pb.h"
 #include "envoy/extensions/regex_engines/v3/google_re2.pb.validate.h"
@@ -61,6 +63,31 @@ CompiledGoogleReMatcher::CompiledGoogleReMatcher(
   }
 }
 
+CompiledGoogleReSetMatcher::CompiledGoogleReSetMatcher(const std::vector<std::string>& regexes)
+    : set_(re2::RE2::Quiet, re2::RE2::ANCHOR_BOTH) {
+  for (const std::string& regex : regexes) {
+    std::string error;
+    if (set_.Add(regex, &error) < 0) {
+      throwEnvoyExceptionOrPanic(fmt::format("regex '{}': {}", regex, error));
+    }
+  }
+  if (!set_.Compile()) {
+    throwEnvoyExceptionOrPanic("RE2 ran out of memory compiling a regex set");
+  }
+}
+
+bool CompiledGoogleReSetMatcher::match(absl::string_view value, std::vector<int>& matches) const {
+  re2::RE2::Set::ErrorInfo error_info;
+  if (!set_.Match(value, &matches, &error_info) &&
+      error_info.kind != re2::RE2::Set::kNoError) {
+    matches.clear();
+    return false;
+  }
+  // RE2 does not order the matching regexes.
+  std::sort(matches.begin(), matches.end());
+  return true;
+}
+
 CompiledMatcherPtr GoogleReEngine::matcher(const std::string& regex) const {
   return std::make_unique<CompiledGoogleReMatcher>(regex, true);
 }
@@ -2,6 +2,7 @@
 
 #include <memory>
 #include <regex>
+#include <vector>
 
 #include "envoy/common/regex.h"
 #include "envoy/registry/registry.h"
@@ -13,6 +14,7 @@
 #include "source/common/stats/symbol_table.h"
 
 #include "re2/re2.h"
+#include "re2/set.h"
 #include "xds/type/matcher/v3/regex.pb.h"
 
 namespace Envoy {
@@ -41,6 +43,27 @@ private:
   const re2::RE2 regex_;
 };
 
+/**
+ * Matches a value against a set of RE2 regexes in a single pass, with the same full match semantics
+ * as a CompiledGoogleReMatcher per regex. The program size checks of the regexes are left to their
+ * own CompiledGoogleReMatcher.
+ */
+class CompiledGoogleReSetMatcher {
+public:
+  explicit CompiledGoogleReSetMatcher(const std::vector<std::string>& regexes);
+
+  /**
+   * @param value supplies the value to match.
+   * @param matches receives the indices of the regexes which match the value, in increasing order.
+   * @return false if RE2 ran out of memory before completing the match, in which case matches is
+   *         empty and any regex may match the value.
+   */
+  bool match(absl::string_view value, std::vector<int>& matches) const;
+
+private:
+  re2::RE2::Set set_;
+};
+
 class GoogleReEngine : public Engine {
 public:
   CompiledMatcherPtr matcher(const std::string& regex) const override;
@@ -79,6 +102,15 @@ public:
 
     return EngineSingleton::get().matcher(matcher.regex());
   }
+
+  /**
+   * @return whether the regex of a match config is compiled by the Google RE2 engine, so that it
+   *         can also be matched by a CompiledGoogleReSetMatcher.
+   */
+  template <class RegexMatcherType> static bool usesGoogleRe(const RegexMatcherType& matcher) {
+    return matcher.has_google_re2() ||
+           dynamic_cast<const GoogleReEngine*>(EngineSingleton::getExisting()) != nullptr;
+  }
 };
 
 } // namespace Regex
@@ -44,6 +44,32 @@ public:
         version, absl::nullopt, absl::nullopt));
   }
 
+  // Same as fromResource() above, with the decoding of the resource started by
+  // OpaqueResourceDecoder::preDecodeResource(), which is passed the resource unwrapped from its
+  // Resource wrapper, if any.
+  static DecodedResourceImplPtr fromResource(OpaqueResourceDecoder& resource_decoder,
+                                             const ProtobufWkt::Any& resource,
+                                             const std::string& version,
+                                             PreDecodedResource&& pre_decoded) {
+    if (resource.Is<envoy::service::discovery::v3::Resource>()) {
+      envoy::service::discovery::v3::Resource r;
+      MessageUtil::unpackTo(resource, r);
+
+      return std::unique_ptr<DecodedResourceImpl>(new DecodedResourceImpl(
+          resource_decoder, r.name(), r.aliases(),
+          resource_decoder.finishDecodeResource(std::move(pre_decoded)), r.has_resource(), version,
+          r.has_ttl() ? absl::make_optional(std::chrono::milliseconds(
+                            DurationUtil::durationToMilliseconds(r.ttl())))
+                      : absl::nullopt,
+          r.has_metadata() ? absl::make_optional(r.metadata()) : absl::nullopt));
+    }
+
+    return std::unique_ptr<DecodedResourceImpl>(new DecodedResourceImpl(
+        resource_decoder, absl::nullopt, Protobuf::RepeatedPtrField<std::string>(),
+        resource_decoder.finishDecodeResource(std::move(pre_decoded)), true, version, absl::nullopt,
+        absl::nullopt));
+  }
+
   static DecodedResourceImplPtr
   fromResource(OpaqueResourceDecoder& resource_decoder,
                const envoy::service::discovery::v3::Resource& resource) {
@@ -86,7 +112,15 @@ private:
                       const ProtobufWkt::Any& resource, bool has_resource,
                       const std::string& version, absl::optional<std::chrono::milliseconds> ttl,
                       const absl::optional<envoy::config::core::v3::Metadata>& metadata)
-      : resource_(resource_decoder.decodeResource(resource)), has_resource_(has_resource),
+      : DecodedResourceImpl(resource_decoder, name, aliases,
+                            resource_decoder.decodeResource(resource), has_resource, version, ttl,
+                            metadata) {}
+  DecodedResourceImpl(OpaqueResourceDecoder& resource_decoder, absl::optional<std::string> name,
+                      const Protobuf::RepeatedPtrField<std::string>& aliases,
+                      ProtobufTypes::MessagePtr resource, bool has_resource,
+                      const std::string& version, absl::optional<std::chrono::milliseconds> ttl,
+                      const absl::optional<envoy::config::core::v3::Metadata>& metadata)
+      : resource_(std::move(resource)), has_resource_(has_resource),
         name_(name ? *name : resource_decoder.resourceName(*resource_)),
         aliases_(repeatedPtrFieldToVector(aliases)), version_(version), ttl_(ttl),
         metadata_(metadata) {}
@@ -24,6 +24,37 @@ public:
     return typed_message;
   }
 
+  Config::PreDecodedResource preDecodeResource(const ProtobufWkt::Any& resource) override {
+    Config::PreDecodedResource pre_decoded;
+    auto typed_message = std::make_unique<Current>();
+    if (!resource.type_url().empty()) {
+      pre_decoded.unpack_status_ = MessageUtil::unpackToNoThrow(resource, *typed_message);
+      if (!pre_decoded.unpack_status_.ok()) {
+        return pre_decoded;
+      }
+      // The unexpected field checks need the validation visitor and runtime, so they are left to
+      // finishDecodeResource() on the main thread.
+      Validate(*typed_message, &pre_decoded.validation_error_);
+    }
+    pre_decoded.resource_ = std::move(typed_message);
+    return pre_decoded;
+  }
+
+  ProtobufTypes::MessagePtr
+  finishDecodeResource(Config::PreDecodedResource&& pre_decoded) override {
+    if (!pre_decoded.unpack_status_.ok()) {
+      throwEnvoyExceptionOrPanic(std::string(pre_decoded.unpack_status_.message()));
+    }
+    if (!validation_visitor_.skipValidation()) {
+      MessageUtil::checkForUnexpectedFields(*pre_decoded.resource_, validation_visitor_);
+    }
+    if (!pre_decoded.validation_error_.empty()) {
+      ProtoExceptionUtil::throwProtoValidationException(pre_decoded.validation_error_,
+                                                        *pre_decoded.resource_);
+    }
+    return std::move(pre_decoded.resource_);
+  }
+
   std::string resourceName(const Protobuf::Message& resource) override {
     return MessageUtil::getStringField(resource, name_field_);
   }
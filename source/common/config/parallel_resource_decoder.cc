@@ -0,0 +1,69 @@
+#include "source/common/config/parallel_resource_decoder.h"
+
+#include <algorithm>
+
+#include "envoy/service/discovery/v3/discovery.pb.h"
+
+#include "source/common/protobuf/utility.h"
+
+namespace Envoy {
+namespace Config {
+
+namespace {
+
+PreDecodedResource preDecodeResource(OpaqueResourceDecoder& resource_decoder,
+                                     const ProtobufWkt::Any& resource) {
+  if (!resource.Is<envoy::service::discovery::v3::Resource>()) {
+    return resource_decoder.preDecodeResource(resource);
+  }
+  envoy::service::discovery::v3::Resource r;
+  if (!MessageUtil::unpackToNoThrow(resource, r).ok()) {
+    // DecodedResourceImpl::fromResource() reports the error when unpacking the wrapper again.
+    return {};
+  }
+  return resource_decoder.preDecodeResource(r.resource());
+}
+
+} // namespace
+
+ParallelResourceDecoder::ParallelResourceDecoder(OptRef<Thread::ThreadFactory> thread_factory,
+                                                 uint32_t max_threads)
+    : thread_factory_(thread_factory), max_threads_(thread_factory.has_value() ? max_threads : 1) {}
+
+std::vector<PreDecodedResource> ParallelResourceDecoder::preDecodeResources(
+    OpaqueResourceDecoder& resource_decoder,
+    const Protobuf::RepeatedPtrField<ProtobufWkt::Any>& resources) const {
+  const int size = resources.size();
+  const uint32_t num_threads = std::min<uint32_t>(max_threads_, size / MinResourcesPerThread);
+  if (num_threads <= 1) {
+    return {};
+  }
+
+  std::vector<PreDecodedResource> pre_decoded(size);
+  const int range_size = (size + num_threads - 1) / num_threads;
+  const auto decode_range = [&resource_decoder, &resources, &pre_decoded, range_size,
+                             size](uint32_t range) {
+    const int begin = std::min<int>(range * range_size, size);
+    const int end = std::min(begin + range_size, size);
+    for (int i = begin; i < end; ++i) {
+      pre_decoded[i] = preDecodeResource(resource_decoder, resources[i]);
+    }
+  };
+
+  // The calling thread decodes the first range, and then waits for the threads decoding the others.
+  const Thread::Options options{"xds_decoder"};
+  std::vector<Thread::ThreadPtr> threads;
+  threads.reserve(num_threads - 1);
+  for (uint32_t range = 1; range < num_threads; ++range) {
+    threads.push_back(
+        thread_factory_->createThread([&decode_range, range]() { decode_range(range); }, options));
+  }
+  decode_range(0);
+  for (Thread::ThreadPtr& thread : threads) {
+    thread->join();
+  }
+  return pre_decoded;
+}
+
+} // namespace Config
+} // namespace Envoy
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "envoy/common/optref.h"
+#include "envoy/config/subscription.h"
+#include "envoy/thread/thread.h"
+
+#include "source/common/protobuf/protobuf.h"
+
+namespace Envoy {
+namespace Config {
+
+/**
+ * Unpacks the resources of a discovery response and checks their protoc-gen-validate constraints
+ * on up to a fixed number of threads, so that large responses are not decoded serially on the main
+ * thread. The decoding of each resource is then completed in order on the main thread by
+ * DecodedResourceImpl::fromResource(), so errors are reported as if the response had been decoded
+ * serially.
+ */
+class ParallelResourceDecoder {
+public:
+  // Responses are split so that each thread decodes at least this many resources.
+  static constexpr uint32_t MinResourcesPerThread = 16;
+
+  // No thread is kept between responses: up to max_threads - 1 threads are created for each large
+  // response, and exit once it is decoded. The thread calling preDecodeResources() takes part in
+  // the decoding. If thread_factory is not set, all responses are left to be decoded serially.
+  ParallelResourceDecoder(OptRef<Thread::ThreadFactory> thread_factory, uint32_t max_threads);
+
+  /**
+   * @param resource_decoder supplies the decoder of the resources.
+   * @param resources supplies the resources of a discovery response.
+   * @return std::vector<PreDecodedResource> the pre-decoded resources in the order of resources,
+   *         or an empty vector if there are too few resources to use more than one thread, in
+   *         which case they should be decoded serially.
+   */
+  std::vector<PreDecodedResource>
+  preDecodeResources(OpaqueResourceDecoder& resource_decoder,
+                     const Protobuf::RepeatedPtrField<ProtobufWkt::Any>& resources) const;
+
+private:
+  OptRef<Thread::ThreadFactory> thread_factory_;
+  const uint32_t max_threads_;
+};
+
+} // namespace Config
+} // namespace Envoy
@@ -1,5 +1,11 @@
 #include "source/common/formatter/substitution_formatter.h"
 
+#include <cmath>
+#include <iterator>
+
+#include "source/common/common/fmt.h"
+#include "source/common/common/json_escape_string.h"
+
 namespace Envoy {
 namespace Formatter {
 
@@ -54,5 +60,74 @@ const std::regex& SubstitutionFormatParser::commandWithArgsRegex() {
   // clang-format on
 }
 
+void JsonFormatterUtil::appendString(absl::string_view value, std::string& output) {
+  output.push_back('"');
+  appendEscaped(value, output);
+  output.push_back('"');
+}
+
+void JsonFormatterUtil::appendEscaped(absl::string_view value, std::string& output) {
+  const uint64_t required_space = JsonEscaper::extraSpace(value);
+  if (required_space == 0) {
+    // Most values need no escaping, and are copied as is.
+    output.append(value.data(), value.size());
+    return;
+  }
+  output.append(JsonEscaper::escapeString(value, required_space));
+}
+
+void JsonFormatterUtil::appendNumber(double value, std::string& output) {
+  if (!std::isfinite(value)) {
+    output.append("null");
+    return;
+  }
+  fmt::format_to(std::back_inserter(output), "{}", value);
+}
+
+void JsonFormatterUtil::appendValue(const ProtobufWkt::Value& value, std::string& output) {
+  switch (value.kind_case()) {
+  case ProtobufWkt::Value::kNumberValue:
+    appendNumber(value.number_value(), output);
+    break;
+  case ProtobufWkt::Value::kStringValue:
+    appendString(value.string_value(), output);
+    break;
+  case ProtobufWkt::Value::kBoolValue:
+    output.append(value.bool_value() ? "true" : "false");
+    break;
+  case ProtobufWkt::Value::kStructValue: {
+    bool first = true;
+    output.push_back('{');
+    for (const auto& field : value.struct_value().fields()) {
+      if (!first) {
+        output.push_back(',');
+      }
+      first = false;
+      appendString(field.first, output);
+      output.push_back(':');
+      appendValue(field.second, output);
+    }
+    output.push_back('}');
+    break;
+  }
+  case ProtobufWkt::Value::kListValue: {
+    bool first = true;
+    output.push_back('[');
+    for (const auto& element : value.list_value().values()) {
+      if (!first) {
+        output.push_back(',');
+      }
+      first = false;
+      appendValue(element, output);
+    }
+    output.push_back(']');
+    break;
+  }
+  default:
+    output.append("null");
+    break;
+  }
+}
+
 } // namespace Formatter
 } // namespace Envoy
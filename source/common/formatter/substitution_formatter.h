@@ -15,6 +15,7 @@
 #include "source/common/formatter/http_specific_formatter.h"
 #include "source/common/formatter/stream_info_formatter.h"
 #include "source/common/json/json_loader.h"
+#include "source/common/runtime/runtime_features.h"
 
 #include "absl/container/flat_hash_map.h"
 #include "absl/types/optional.h"
@@ -175,6 +176,33 @@ public:
   using CommonFormatterBaseImpl<FormatterContext>::CommonFormatterBaseImpl;
 };
 
+/**
+ * Utilities for serializing structured log entries as JSON directly into a string, without
+ * building an intermediate Struct.
+ */
+class JsonFormatterUtil {
+public:
+  /**
+   * Appends a quoted and escaped JSON string.
+   */
+  static void appendString(absl::string_view value, std::string& output);
+
+  /**
+   * Appends an escaped JSON string, without the quotes.
+   */
+  static void appendEscaped(absl::string_view value, std::string& output);
+
+  /**
+   * Appends a JSON number. NaN and infinities, which JSON cannot represent, are appended as null.
+   */
+  static void appendNumber(double value, std::string& output);
+
+  /**
+   * Appends a JSON value. Struct fields are appended in the iteration order of the Struct.
+   */
+  static void appendValue(const ProtobufWkt::Value& value, std::string& output);
+};
+
 // Helper classes for StructFormatter::StructFormatMapVisitor.
 template <class... Ts> struct StructFormatMapVisitorHelper : Ts... { using Ts::operator()...; };
 template <class... Ts> StructFormatMapVisitorHelper(Ts...) -> StructFormatMapVisitorHelper<Ts...>;
@@ -212,6 +240,19 @@ public:
     return structFormatMapCallback(struct_output_format_, visitor).struct_value();
   }
 
+  /**
+   * Appends the log entry to output as JSON, formatting each value directly into output.
+   * Properties are in the order of the format. This is equivalent to serializing the result of
+   * formatWithContext(), but does not build a Struct.
+   */
+  void formatJsonWithContext(const FormatterContext& context, const StreamInfo::StreamInfo& info,
+                             std::string& output) const {
+    if (!appendJsonMap(struct_output_format_, context, info, output)) {
+      // All the properties were omitted.
+      output.append("{}");
+    }
+  }
+
 private:
   struct StructFormatMapWrapper;
   struct StructFormatListWrapper;
@@ -371,6 +412,97 @@ private:
     return ValueUtil::listValue(output);
   }
 
+  // Methods for formatting directly into JSON. Each returns false, leaving output unchanged, if
+  // the value is omitted.
+  bool appendJsonValue(const StructFormatValue& value, const FormatterContext& context,
+                       const StreamInfo::StreamInfo& info, std::string& output) const {
+    switch (value.index()) {
+    case 0:
+      return appendJsonProviders(
+          absl::get<const std::vector<FormatterProviderBasePtr<FormatterContext>>>(value),
+          context, info, output);
+    case 1:
+      return appendJsonMap(absl::get<const StructFormatMapWrapper>(value), context, info, output);
+    default:
+      appendJsonList(absl::get<const StructFormatListWrapper>(value), context, info, output);
+      return true;
+    }
+  }
+  bool
+  appendJsonProviders(const std::vector<FormatterProviderBasePtr<FormatterContext>>& providers,
+                      const FormatterContext& context, const StreamInfo::StreamInfo& info,
+                      std::string& output) const {
+    ASSERT(!providers.empty());
+    if (providers.size() == 1) {
+      const auto& provider = providers.front();
+      if (preserve_types_) {
+        const ProtobufWkt::Value value = provider->formatValueWithContext(context, info);
+        if (omit_empty_values_ && value.kind_case() == ProtobufWkt::Value::kNullValue) {
+          return false;
+        }
+        JsonFormatterUtil::appendValue(value, output);
+        return true;
+      }
+
+      const auto str = provider->formatWithContext(context, info);
+      if (omit_empty_values_ && !str.has_value()) {
+        return false;
+      }
+      JsonFormatterUtil::appendString(str.value_or(empty_value_), output);
+      return true;
+    }
+    // Multiple providers forces string output.
+    output.push_back('"');
+    for (const auto& provider : providers) {
+      const auto bit = provider->formatWithContext(context, info);
+      JsonFormatterUtil::appendEscaped(bit.value_or(empty_value_), output);
+    }
+    output.push_back('"');
+    return true;
+  }
+  bool appendJsonMap(const StructFormatMapWrapper& format_map, const FormatterContext& context,
+                     const StreamInfo::StreamInfo& info, std::string& output) const {
+    const size_t start = output.size();
+    bool empty = true;
+    output.push_back('{');
+    for (const auto& pair : *format_map.value_) {
+      const size_t field_start = output.size();
+      if (!empty) {
+        output.push_back(',');
+      }
+      JsonFormatterUtil::appendString(pair.first, output);
+      output.push_back(':');
+      if (!appendJsonValue(pair.second, context, info, output)) {
+        output.resize(field_start);
+        continue;
+      }
+      empty = false;
+    }
+    if (omit_empty_values_ && empty) {
+      output.resize(start);
+      return false;
+    }
+    output.push_back('}');
+    return true;
+  }
+  void appendJsonList(const StructFormatListWrapper& format_list, const FormatterContext& context,
+                      const StreamInfo::StreamInfo& info, std::string& output) const {
+    bool empty = true;
+    output.push_back('[');
+    for (const auto& value : *format_list.value_) {
+      const size_t value_start = output.size();
+      if (!empty) {
+        output.push_back(',');
+      }
+      if (!appendJsonValue(value, context, info, output)) {
+        output.resize(value_start);
+        continue;
+      }
+      empty = false;
+    }
+    output.push_back(']');
+  }
+
   const bool omit_empty_values_;
   const bool preserve_types_;
   const std::string empty_value_;
@@ -390,11 +522,24 @@ public:
                               bool omit_empty_values, bool sort_properties,
                               const CommandParsers& commands = {})
       : struct_formatter_(format_mapping, preserve_types, omit_empty_values, commands),
-        sort_properties_(sort_properties) {}
+        sort_properties_(sort_properties),
+        // Typed values may be structs whose properties need sorting too, so sorted entries are
+        // built as a Struct first.
+        direct_serialization_(!sort_properties &&
+                              Runtime::runtimeFeatureEnabled(
+                                  "envoy.reloadable_features.direct_json_access_log_formatting")) {}
 
   // FormatterBase
   std::string formatWithContext(const FormatterContext& context,
                                 const StreamInfo::StreamInfo& info) const override {
+    if (direct_serialization_) {
+      std::string log_line;
+      log_line.reserve(256);
+      struct_formatter_.formatJsonWithContext(context, info, log_line);
+      log_line.push_back('\n');
+      return log_line;
+    }
+
     const ProtobufWkt::Struct output_struct = struct_formatter_.formatWithContext(context, info);
 
     std::string log_line = "";
@@ -414,6 +559,8 @@ public:
 private:
   const StructFormatterBase<FormatterContext> struct_formatter_;
   const bool sort_properties_;
+  // Whether entries are serialized as they are formatted, without building a Struct.
+  const bool direct_serialization_;
 };
 
 template <class FormatterContext>
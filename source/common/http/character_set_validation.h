@@ -3,6 +3,10 @@
 #include <array>
 #include <cstdint>
 
+#include "source/common/common/safe_memcpy.h"
+
+#include "absl/strings/string_view.h"
+
 // A set of tables for validating that a character is in a specific
 // character set. Used to validate RFC compliance for various HTTP protocol elements.
 
@@ -72,5 +76,112 @@ inline constexpr std::array<uint32_t, 8> kUriQueryAndFragmentCharTable = {
     0b00000000000000000000000000000000,
 };
 
+// Header field value character table.
+// From RFC 9110, https://www.rfc-editor.org/rfc/rfc9110.html#section-5.5, with obs-text allowed:
+//
+// SPELLCHECKER(off)
+// field-value    = *field-content
+// field-content  = field-vchar
+//                  [ 1*( SP / HTAB / field-vchar ) field-vchar ]
+// field-vchar    = VCHAR / obs-text
+// obs-text       = %x80-FF
+// SPELLCHECKER(on)
+inline constexpr std::array<uint32_t, 8> kHeaderValueCharTable = {
+    // control characters
+    0b00000000010000000000000000000000,
+    // !"#$%&'()*+,-./0123456789:;<=>?
+    0b11111111111111111111111111111111,
+    //@ABCDEFGHIJKLMNOPQRSTUVWXYZ[\]^_
+    0b11111111111111111111111111111111,
+    //`abcdefghijklmnopqrstuvwxyz{|}~
+    0b11111111111111111111111111111110,
+    // extended ascii
+    0b11111111111111111111111111111111,
+    0b11111111111111111111111111111111,
+    0b11111111111111111111111111111111,
+    0b11111111111111111111111111111111,
+};
+
+// Helpers which inspect 8 bytes per step using plain 64 bit arithmetic (SWAR). They speed up scans
+// of long header values on every supported architecture without depending on a particular vector
+// instruction set. Each predicate only tells whether some byte of the word qualifies; callers fall
+// back to a per byte check to locate it.
+namespace Swar {
+
+inline constexpr uint64_t kOnes = 0x0101010101010101ULL;
+inline constexpr uint64_t kHighBits = 0x8080808080808080ULL;
+
+inline uint64_t load(const char* data) {
+  uint64_t word;
+  safeMemcpyUnsafeSrc(&word, data);
+  return word;
+}
+
+// Returns non-zero iff some byte of `word` is less than `n`, which must not exceed 128.
+inline constexpr uint64_t hasByteLessThan(uint64_t word, uint8_t n) {
+  return (word - kOnes * n) & ~word & kHighBits;
+}
+
+// Returns non-zero iff some byte of `word` equals `c`.
+inline constexpr uint64_t hasByte(uint64_t word, uint8_t c) {
+  return hasByteLessThan(word ^ (kOnes * c), 1);
+}
+
+} // namespace Swar
+
+/**
+ * @return true if every character of `value` is in kHeaderValueCharTable.
+ */
+inline bool headerValueCharsAreValid(absl::string_view value) {
+  const char* data = value.data();
+  size_t remaining = value.size();
+  for (; remaining >= sizeof(uint64_t); data += sizeof(uint64_t), remaining -= sizeof(uint64_t)) {
+    const uint64_t word = Swar::load(data);
+    // Only control characters and DEL are rejected. HTAB is the one allowed control character,
+    // so words flagged here still need the exact per byte check.
+    if ((Swar::hasByteLessThan(word, 0x20) | Swar::hasByte(word, 0x7f)) != 0) {
+      for (size_t i = 0; i < sizeof(uint64_t); ++i) {
+        if (!testCharInTable(kHeaderValueCharTable, data[i])) {
+          return false;
+        }
+      }
+    }
+  }
+  for (; remaining > 0; ++data, --remaining) {
+    if (!testCharInTable(kHeaderValueCharTable, *data)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * @return true if `value` contains a CR or LF character.
+ */
+inline bool containsCrOrLf(absl::string_view value) {
+  const char* data = value.data();
+  size_t remaining = value.size();
+  for (; remaining >= sizeof(uint64_t); data += sizeof(uint64_t), remaining -= sizeof(uint64_t)) {
+    const uint64_t word = Swar::load(data);
+    if ((Swar::hasByte(word, '\r') | Swar::hasByte(word, '\n')) != 0) {
+      return true;
+    }
+  }
+  for (; remaining > 0; ++data, --remaining) {
+    if (*data == '\r' || *data == '\n') {
+      return true;
+    }
+  }
+  return false;
+}
+
+/**
+ * Branch and table free equivalent of absl::ascii_tolower(), which lets compilers vectorize loops
+ * lower casing whole header names.
+ */
+inline constexpr char asciiToLowerBranchless(char c) {
+  return static_cast<char>(c | ((static_cast<uint8_t>(c - 'A') < 26) << 5));
+}
+
 } // namespace Http
 } // namespace Envoy
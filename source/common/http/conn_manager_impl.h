@@ -521,7 +521,9 @@ private:
 
     std::shared_ptr<bool> still_alive_ = std::make_shared<bool>(true);
     std::unique_ptr<Buffer::OwnedImpl> deferred_data_;
-    std::queue<MetadataMapPtr> deferred_metadata_;
+    // Backed by a list rather than the default std::deque, which heap allocates on construction
+    // even though metadata is rarely deferred.
+    std::queue<MetadataMapPtr, std::list<MetadataMapPtr>> deferred_metadata_;
   };
 
   using ActiveStreamPtr = std::unique_ptr<ActiveStream>;
@@ -196,8 +196,9 @@ bool HeaderUtility::matchHeaders(const HeaderMap& request_headers, const HeaderD
 }
 
 bool HeaderUtility::headerValueIsValid(const absl::string_view header_value) {
-  return http2::adapter::HeaderValidator::IsValidHeaderValue(header_value,
-                                                             http2::adapter::ObsTextOption::kAllow);
+  // Same character set as http2::adapter::HeaderValidator::IsValidHeaderValue() with obs-text
+  // allowed, checked a word at a time as values are usually long and valid.
+  return headerValueCharsAreValid(header_value);
 }
 
 bool HeaderUtility::headerNameIsValid(const absl::string_view header_key) {
@@ -5,6 +5,7 @@
 #include <cstdint>
 
 #include "source/common/common/assert.h"
+#include "source/common/http/character_set_validation.h"
 #include "source/common/http/headers.h"
 
 #include "absl/strings/ascii.h"
@@ -25,12 +26,9 @@ constexpr char kResponseFirstByte = 'H';
 constexpr absl::string_view kHttpVersionPrefix = "HTTP/";
 
 // Allowed characters for field names according to Section 5.1
-// and for methods according to Section 9.1 of RFC 9110:
+// and for methods according to Section 9.1 of RFC 9110 are both tchar:
 // https://www.rfc-editor.org/rfc/rfc9110.html
-constexpr absl::string_view kValidCharacters =
-    "!#$%&'*+-.0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ^_`abcdefghijklmnopqrstuvwxyz|~";
-constexpr absl::string_view::iterator kValidCharactersBegin = kValidCharacters.begin();
-constexpr absl::string_view::iterator kValidCharactersEnd = kValidCharacters.end();
+bool isTokenCharacter(char c) { return testCharInTable(kGenericHeaderNameCharTable, c); }
 
 bool isFirstCharacterOfValidMethod(char c) {
   static constexpr char kValidFirstCharacters[] = {'A', 'B', 'C', 'D', 'G', 'H', 'L', 'M',
@@ -45,10 +43,7 @@ bool isFirstCharacterOfValidMethod(char c) {
 // enabled.
 bool isMethodValid(absl::string_view method, bool allow_custom_methods) {
   if (allow_custom_methods) {
-    return !method.empty() &&
-           std::all_of(method.begin(), method.end(), [](absl::string_view::value_type c) {
-             return std::binary_search(kValidCharactersBegin, kValidCharactersEnd, c);
-           });
+    return !method.empty() && std::all_of(method.begin(), method.end(), isTokenCharacter);
   }
 
   static constexpr absl::string_view kValidMethods[] = {
@@ -139,9 +134,7 @@ bool isVersionValid(absl::string_view version_input) {
 }
 
 bool isHeaderNameValid(absl::string_view name) {
-  return std::all_of(name.begin(), name.end(), [](absl::string_view::value_type c) {
-    return std::binary_search(kValidCharactersBegin, kValidCharactersEnd, c);
-  });
+  return std::all_of(name.begin(), name.end(), isTokenCharacter);
 }
 
 } // anonymous namespace
@@ -417,7 +410,7 @@ void BalsaParser::validateAndProcessHeadersOrTrailersImpl(const quiche::BalsaHea
 
     // Remove CR and LF characters to match http-parser behavior.
     auto is_cr_or_lf = [](char c) { return c == '\r' || c == '\n'; };
-    if (std::any_of(value.begin(), value.end(), is_cr_or_lf)) {
+    if (containsCrOrLf(value)) {
       std::string value_without_cr_or_lf;
       value_without_cr_or_lf.reserve(value.size());
       for (char c : value) {
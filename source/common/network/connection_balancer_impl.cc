@@ -34,5 +34,43 @@ ExactConnectionBalancerImpl::pickTargetHandler(BalancedConnectionHandler&) {
   return *min_connection_handler;
 }
 
+void PowerOfTwoChoicesConnectionBalancerImpl::registerHandler(
+    BalancedConnectionHandler& handler) {
+  absl::MutexLock lock(&lock_);
+  handlers_.push_back(&handler);
+}
+
+void PowerOfTwoChoicesConnectionBalancerImpl::unregisterHandler(
+    BalancedConnectionHandler& handler) {
+  absl::MutexLock lock(&lock_);
+  handlers_.erase(std::find(handlers_.begin(), handlers_.end(), &handler));
+}
+
+BalancedConnectionHandler& PowerOfTwoChoicesConnectionBalancerImpl::pickTargetHandler(
+    BalancedConnectionHandler& current_handler) {
+  BalancedConnectionHandler* target_handler = &current_handler;
+  {
+    absl::ReaderMutexLock lock(&lock_);
+    const uint64_t num_handlers = handlers_.size();
+    if (num_handlers > 1) {
+      const uint64_t random = random_.random();
+      // The second choice is offset from the first by 1 to num_handlers - 1, so the two differ.
+      const uint64_t first = (random & 0xFFFFFFFF) % num_handlers;
+      const uint64_t second = (first + 1 + (random >> 32) % (num_handlers - 1)) % num_handlers;
+      const uint64_t first_connections = handlers_[first]->numConnections();
+      const uint64_t second_connections = handlers_[second]->numConnections();
+      BalancedConnectionHandler* candidate =
+          first_connections <= second_connections ? handlers_[first] : handlers_[second];
+      if (std::min(first_connections, second_connections) < current_handler.numConnections()) {
+        target_handler = candidate;
+      }
+    }
+
+    target_handler->incNumConnections();
+  }
+
+  return *target_handler;
+}
+
 } // namespace Network
 } // namespace Envoy
@@ -5,6 +5,7 @@
 #include "envoy/registry/registry.h"
 #include "envoy/server/filter_config.h"
 
+#include "source/common/common/random_generator.h"
 #include "source/common/protobuf/protobuf.h"
 
 #include "absl/synchronization/mutex.h"
@@ -44,6 +45,29 @@ private:
   std::vector<BalancedConnectionHandler*> handlers_ ABSL_GUARDED_BY(lock_);
 };
 
+/**
+ * Implementation of connection balancer that picks the handler with the fewest connections out of
+ * two chosen at random, or keeps the current handler if it has no more connections than that. The
+ * handlers' connection counts are read without holding an exclusive lock, so unlike exact balancing
+ * this doesn't serialize workers accepting connections at the same time, and keeping connections on
+ * the current handler when possible avoids posting them to another worker. Connection counts are
+ * only approximately balanced, but with two choices the most loaded handler stays close to the
+ * average with high probability.
+ */
+class PowerOfTwoChoicesConnectionBalancerImpl : public ConnectionBalancer {
+public:
+  // ConnectionBalancer
+  void registerHandler(BalancedConnectionHandler& handler) override;
+  void unregisterHandler(BalancedConnectionHandler& handler) override;
+  BalancedConnectionHandler& pickTargetHandler(BalancedConnectionHandler& current_handler) override;
+
+private:
+  Random::RandomGeneratorImpl random_;
+  // Only registering and unregistering handlers take the lock exclusively.
+  absl::Mutex lock_;
+  std::vector<BalancedConnectionHandler*> handlers_ ABSL_GUARDED_BY(lock_);
+};
+
 /**
  * A NOP connection balancer implementation that always continues execution after incrementing
  * the handler's connection count.
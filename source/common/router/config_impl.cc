@@ -59,6 +59,9 @@ namespace {
 
 constexpr uint32_t DEFAULT_MAX_DIRECT_RESPONSE_BODY_SIZE_BYTES = 4096;
 
+// Below this many routes a linear scan is about as fast as an index lookup.
+constexpr uint32_t MinRoutesForPathRouteIndex = 32;
+
 void mergeTransforms(Http::HeaderTransforms& dest, const Http::HeaderTransforms& src) {
   dest.headers_to_append_or_add.insert(dest.headers_to_append_or_add.end(),
                                        src.headers_to_append_or_add.begin(),
@@ -1813,9 +1816,103 @@ VirtualHostImpl::VirtualHostImpl(
       routes_.emplace_back(createAndValidateRoute(route, shared_virtual_host_, factory_context,
                                                   validator, validation_clusters));
     }
+    if (routes_.size() >= MinRoutesForPathRouteIndex) {
+      path_route_index_ = std::make_unique<const PathRouteIndex>(routes_);
+    }
   }
 }
 
+PathRouteIndex::PathRouteIndex(absl::Span<const RouteEntryImplBaseConstSharedPtr> routes) {
+  std::vector<std::string> regexes;
+  for (uint32_t i = 0; i < routes.size(); ++i) {
+    const RouteEntryImplBase& route = *routes[i];
+    switch (route.matchType()) {
+    case PathMatchType::Exact:
+      exact_routes_[route.matcher()].push_back(i);
+      break;
+    case PathMatchType::Prefix:
+    case PathMatchType::PathSeparatedPrefix: {
+      // A path separated prefix only matches paths which start with the prefix, so the prefix trie
+      // yields a superset of its matches.
+      PrefixNode* node = &prefix_routes_;
+      for (const char c : route.matcher()) {
+        std::unique_ptr<PrefixNode>& child = node->children_[absl::ascii_tolower(c)];
+        if (child == nullptr) {
+          child = std::make_unique<PrefixNode>();
+        }
+        node = child.get();
+      }
+      node->routes_.push_back(i);
+      break;
+    }
+    case PathMatchType::Regex:
+      // Another regex engine may not have the semantics of RE2.
+      if (static_cast<const RegexRouteEntryImpl&>(route).usesGoogleRe()) {
+        regexes.push_back(route.matcher());
+        regex_routes_.push_back(i);
+      } else {
+        unindexed_routes_.push_back(i);
+      }
+      break;
+    default:
+      unindexed_routes_.push_back(i);
+      break;
+    }
+  }
+  if (!regexes.empty()) {
+    regex_routes_set_ = std::make_unique<const Regex::CompiledGoogleReSetMatcher>(regexes);
+  }
+}
+
+void PathRouteIndex::findCandidates(absl::string_view path, Candidates& candidates) const {
+  candidates.add(unindexed_routes_);
+
+  const auto exact = exact_routes_.find(path);
+  if (exact != exact_routes_.end()) {
+    candidates.add(exact->second);
+  }
+
+  const PrefixNode* node = &prefix_routes_;
+  candidates.add(node->routes_);
+  for (const char c : path) {
+    const auto child = node->children_.find(absl::ascii_tolower(c));
+    if (child == node->children_.end()) {
+      break;
+    }
+    node = child->second.get();
+    candidates.add(node->routes_);
+  }
+
+  if (regex_routes_set_ != nullptr) {
+    std::vector<int> matches;
+    if (regex_routes_set_->match(path, matches)) {
+      for (const int match : matches) {
+        candidates.regex_matches_.push_back(regex_routes_[match]);
+      }
+      candidates.add(candidates.regex_matches_);
+    } else {
+      candidates.add(regex_routes_);
+    }
+  }
+}
+
+absl::optional<uint32_t> PathRouteIndex::Candidates::next() {
+  // Each route is indexed exactly once, so the lists never have a route in common. There are few
+  // lists, so the smallest head is found by a linear scan.
+  absl::Span<const uint32_t>* next_list = nullptr;
+  for (absl::Span<const uint32_t>& list : lists_) {
+    if (!list.empty() && (next_list == nullptr || list.front() < next_list->front())) {
+      next_list = &list;
+    }
+  }
+  if (next_list == nullptr) {
+    return absl::nullopt;
+  }
+  const uint32_t route = next_list->front();
+  next_list->remove_prefix(1);
+  return route;
+}
+
 const std::shared_ptr<const SslRedirectRoute> VirtualHostImpl::SSL_REDIRECT_ROUTE{
     new SslRedirectRoute()};
 
@@ -1904,10 +2001,39 @@ RouteConstSharedPtr VirtualHostImpl::getRouteFromEntries(const RouteCallback& cb
     return nullptr;
   }
 
+  // The index only narrows down candidates for a first-match lookup. Route callbacks observe
+  // whether more routes follow each match, so they always walk the full list.
+  if (path_route_index_ != nullptr && cb == nullptr && headers.Path() != nullptr) {
+    return getRouteFromIndex(headers, stream_info, random_value);
+  }
+
   // Check for a route that matches the request.
   return getRouteFromRoutes(cb, headers, stream_info, random_value, routes_);
 }
 
+RouteConstSharedPtr VirtualHostImpl::getRouteFromIndex(const Http::RequestHeaderMap& headers,
+                                                       const StreamInfo::StreamInfo& stream_info,
+                                                       uint64_t random_value) const {
+  // Mirror the path normalization applied by the route entries before path matching.
+  absl::string_view path = Http::PathUtil::removeQueryAndFragment(headers.getPathValue());
+  if (shared_virtual_host_->globalRouteConfig().ignorePathParametersInPathMatching()) {
+    path = path.substr(0, path.find_first_of(';'));
+  }
+
+  PathRouteIndex::Candidates candidates;
+  path_route_index_->findCandidates(path, candidates);
+  for (absl::optional<uint32_t> index = candidates.next(); index.has_value();
+       index = candidates.next()) {
+    RouteConstSharedPtr route_entry = routes_[*index]->matches(headers, stream_info, random_value);
+    if (route_entry != nullptr) {
+      return route_entry;
+    }
+  }
+
+  ENVOY_LOG(debug, "route was resolved but final route list did not match incoming request");
+  return nullptr;
+}
+
 const VirtualHostImpl* RouteMatcher::findWildcardVirtualHost(
     absl::string_view host, const RouteMatcher::WildcardVirtualHosts& wildcard_virtual_hosts,
     RouteMatcher::SubstringFunction substring_function) const {
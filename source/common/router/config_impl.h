@@ -24,6 +24,8 @@
 
 #include "source/common/common/matchers.h"
 #include "source/common/common/packed_struct.h"
+#include "source/common/common/regex.h"
+#include "source/common/common/utility.h"
 #include "source/common/config/metadata.h"
 #include "source/common/http/hash_policy.h"
 #include "source/common/http/header_utility.h"
@@ -35,6 +37,8 @@
 #include "source/common/router/tls_context_match_criteria_impl.h"
 #include "source/common/stats/symbol_table.h"
 
+#include "absl/container/flat_hash_map.h"
+#include "absl/container/inlined_vector.h"
 #include "absl/container/node_hash_map.h"
 #include "absl/types/optional.h"
 
@@ -355,6 +359,76 @@ private:
 
 using CommonVirtualHostSharedPtr = std::shared_ptr<CommonVirtualHostImpl>;
 
+/**
+ * Index over the routes of a virtual host, built at config load, that narrows the routes which may
+ * match a request path down to a list of candidates in configuration order. Exact path routes are
+ * looked up in a hash table and prefix routes in a trie. Both are keyed case-insensitively so the
+ * candidates are always a superset of the routes whose path matcher accepts the path. The regexes of
+ * the regex routes are matched together in a single pass of an RE2::Set. All other routes
+ * (template, CONNECT, ...) are always candidates. Candidates must still be fully evaluated, which
+ * preserves first-match semantics.
+ */
+class PathRouteIndex {
+public:
+  explicit PathRouteIndex(absl::Span<const RouteEntryImplBaseConstSharedPtr> routes);
+
+  /**
+   * The indices of the routes which may match a path. They are held as lists which are each in
+   * increasing order, and merged lazily so that routes after the first match are never visited.
+   */
+  class Candidates {
+  public:
+    Candidates() = default;
+    // The lists may refer to regex_matches_.
+    Candidates(const Candidates&) = delete;
+    Candidates& operator=(const Candidates&) = delete;
+
+    /**
+     * @return the index of the next candidate route in increasing order, or absl::nullopt once all
+     *         candidates have been returned.
+     */
+    absl::optional<uint32_t> next();
+
+  private:
+    friend class PathRouteIndex;
+
+    void add(absl::Span<const uint32_t> routes) {
+      if (!routes.empty()) {
+        lists_.push_back(routes);
+      }
+    }
+
+    absl::InlinedVector<absl::Span<const uint32_t>, 8> lists_;
+    // The indices of the regex routes whose regex matches the path.
+    absl::InlinedVector<uint32_t, 4> regex_matches_;
+  };
+
+  /**
+   * @param path supplies the request path, without query, fragment or ignored path parameters.
+   * @param candidates receives the routes which may match path. It refers to the lists of the
+   *        index, so must not outlive it.
+   */
+  void findCandidates(absl::string_view path, Candidates& candidates) const;
+
+private:
+  // Every list of route indices is in increasing order, as routes are indexed in configuration
+  // order.
+  struct PrefixNode {
+    std::vector<uint32_t> routes_;
+    // Keyed by the lower-cased next character of the prefix.
+    absl::flat_hash_map<char, std::unique_ptr<PrefixNode>> children_;
+  };
+
+  absl::flat_hash_map<std::string, std::vector<uint32_t>, StringUtil::CaseInsensitiveHash,
+                      StringUtil::CaseInsensitiveCompare>
+      exact_routes_;
+  PrefixNode prefix_routes_;
+  // The route indices of the regexes of regex_routes_set_.
+  std::vector<uint32_t> regex_routes_;
+  std::unique_ptr<const Regex::CompiledGoogleReSetMatcher> regex_routes_set_;
+  std::vector<uint32_t> unindexed_routes_;
+};
+
 /**
  * Virtual host that holds a collection of routes.
  */
@@ -386,7 +460,13 @@ private:
 
   SslRequirements ssl_requirements_;
 
+  RouteConstSharedPtr getRouteFromIndex(const Http::RequestHeaderMap& headers,
+                                        const StreamInfo::StreamInfo& stream_info,
+                                        uint64_t random_value) const;
+
   std::vector<RouteEntryImplBaseConstSharedPtr> routes_;
+  // Only built for virtual hosts with enough routes for the index to pay off.
+  std::unique_ptr<const PathRouteIndex> path_route_index_;
   Matcher::MatchTreeSharedPtr<Http::HttpMatchingData> matcher_;
 };
 
@@ -1335,6 +1415,11 @@ public:
   }
   PathMatchType matchType() const override { return PathMatchType::Regex; }
 
+  // @return whether the path regex is matched by the Google RE2 engine.
+  bool usesGoogleRe() const {
+    return Regex::Utility::usesGoogleRe(path_matcher_->matcher().matcher().safe_regex());
+  }
+
   // Router::Matchable
   RouteConstSharedPtr matches(const Http::RequestHeaderMap& headers,
                               const StreamInfo::StreamInfo& stream_info,
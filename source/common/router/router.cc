@@ -723,9 +723,12 @@ Http::FilterHeadersStatus Filter::decodeHeaders(Http::RequestHeaderMap& headers,
       const auto& policy_ref = *shadow_policy;
       if (FilterUtility::shouldShadow(policy_ref, config_.runtime_, callbacks_->streamId())) {
         active_shadow_policies_.push_back(std::cref(policy_ref));
-        shadow_headers_ = Http::createHeaderMap<Http::RequestHeaderMapImpl>(*downstream_headers_);
       }
     }
+    // All shadows are sent the same request headers, so they only need to be copied once.
+    if (!active_shadow_policies_.empty()) {
+      shadow_headers_ = Http::createHeaderMap<Http::RequestHeaderMapImpl>(*downstream_headers_);
+    }
   }
 
   ENVOY_STREAM_LOG(debug, "router decoding headers:\n{}", *callbacks_, headers);
@@ -757,7 +760,6 @@ Http::FilterHeadersStatus Filter::decodeHeaders(Http::RequestHeaderMap& headers,
       if (!shadow_cluster_name.has_value()) {
         continue;
       }
-      auto shadow_headers = Http::createHeaderMap<Http::RequestHeaderMapImpl>(*shadow_headers_);
       auto options =
           Http::AsyncClient::RequestOptions()
               .setTimeout(timeout_.global_timeout_)
@@ -779,7 +781,8 @@ Http::FilterHeadersStatus Filter::decodeHeaders(Http::RequestHeaderMap& headers,
                                       options);
       } else {
         Http::AsyncClient::OngoingRequest* shadow_stream = config_.shadowWriter().streamingShadow(
-            std::string(shadow_cluster_name.value()), std::move(shadow_headers), options);
+            std::string(shadow_cluster_name.value()),
+            Http::createHeaderMap<Http::RequestHeaderMapImpl>(*shadow_headers_), options);
         if (shadow_stream != nullptr) {
           shadow_streams_.insert(shadow_stream);
           shadow_stream->setDestructorCallback(
@@ -37,7 +37,11 @@ public:
                            const StatNameTagVector& stat_name_tags, SymbolTable& symbol_table);
   ~ThreadLocalHistogramImpl() override;
 
-  void merge(histogram_t* target);
+  /**
+   * Merges the values recorded before the last beginMerge() into target.
+   * @return whether any values were merged.
+   */
+  bool merge(histogram_t* target);
 
   /**
    * Called in the beginning of merge process. Swaps the histogram used for collection so that we do
@@ -67,6 +71,9 @@ private:
   uint64_t otherHistogramIndex() const { return 1 - current_active_; }
   uint64_t current_active_{0};
   histogram_t* histograms_[2];
+  // Whether each of histograms_ holds values which have not been merged yet. This lets merges skip
+  // histograms which were not recorded into during the last interval.
+  bool has_values_[2]{false, false};
   std::atomic<bool> used_;
   std::thread::id created_thread_id_;
   SymbolTable& symbol_table_;
@@ -141,6 +148,9 @@ private:
   mutable Thread::MutexBasicLockable merge_lock_;
   std::list<TlsHistogramSharedPtr> tls_histograms_ ABSL_GUARDED_BY(merge_lock_);
   bool merged_{false};
+  // Whether interval_histogram_ held no values after the last merge, in which case it and the
+  // interval statistics need no refresh until new values are recorded.
+  bool interval_empty_{true};
   std::atomic<bool> shutting_down_{false};
   std::atomic<uint32_t> ref_count_{0};
   const uint64_t id_; // Index into TlsCache::histogram_cache_.
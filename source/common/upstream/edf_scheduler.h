@@ -1,7 +1,9 @@
 #pragma once
+#include <algorithm>
 #include <cstdint>
 #include <iostream>
 #include <queue>
+#include <vector>
 
 #include "envoy/upstream/scheduler.h"
 
@@ -27,6 +29,57 @@ namespace Upstream {
 // weights and an O(log n) pick time.
 template <class C> class EdfScheduler : public Scheduler<C> {
 public:
+  /**
+   * Creates a scheduler in the same state as adding each of the entries in order and then calling
+   * pickAndAdd() 'picks' times. The picks are simulated on plain deadlines and the queue is built
+   * with a single heapify, so this is O(n + picks * log n) without any per-pick allocation, rather
+   * than O((n + picks) * log n) for the equivalent add() and pickAndAdd() calls. calculate_weight
+   * is invoked once per entry, and that weight is used for every simulated pick of the entry.
+   * @param entries supplies the entries to schedule.
+   * @param calculate_weight supplies the weight of an entry.
+   * @param picks supplies the number of picks to advance the schedule by.
+   * @return std::unique_ptr<EdfScheduler<C>> the new scheduler.
+   */
+  template <class T>
+  static std::unique_ptr<EdfScheduler<C>>
+  createWithPicks(const std::vector<std::shared_ptr<T>>& entries,
+                  std::function<double(const C&)> calculate_weight, uint32_t picks) {
+    auto scheduler = std::make_unique<EdfScheduler<C>>();
+    if (entries.empty()) {
+      return scheduler;
+    }
+
+    std::vector<double> weights;
+    std::vector<PrepickEntry> prepick_queue;
+    weights.reserve(entries.size());
+    prepick_queue.reserve(entries.size());
+    for (uint32_t i = 0; i < entries.size(); ++i) {
+      const double weight = calculate_weight(*entries[i]);
+      ASSERT(weight > 0);
+      weights.push_back(weight);
+      prepick_queue.push_back({scheduler->current_time_ + 1.0 / weight, i, i});
+    }
+    scheduler->order_offset_ = entries.size();
+    std::make_heap(prepick_queue.begin(), prepick_queue.end());
+
+    for (uint32_t i = 0; i < picks; ++i) {
+      std::pop_heap(prepick_queue.begin(), prepick_queue.end());
+      PrepickEntry& picked = prepick_queue.back();
+      scheduler->current_time_ = picked.deadline_;
+      picked.deadline_ = scheduler->current_time_ + 1.0 / weights[picked.index_];
+      picked.order_offset_ = scheduler->order_offset_++;
+      std::push_heap(prepick_queue.begin(), prepick_queue.end());
+    }
+
+    std::vector<EdfEntry> queue;
+    queue.reserve(prepick_queue.size());
+    for (const PrepickEntry& entry : prepick_queue) {
+      queue.push_back({entry.deadline_, entry.order_offset_, entries[entry.index_]});
+    }
+    scheduler->queue_ = std::priority_queue<EdfEntry>(std::less<EdfEntry>(), std::move(queue));
+    return scheduler;
+  }
+
   // See scheduler.h for an explanation of each public method.
   std::shared_ptr<C> peekAgain(std::function<double(const C&)> calculate_weight) override {
     std::shared_ptr<C> ret = popEntry();
@@ -106,6 +159,20 @@ private:
     }
   };
 
+  // An entry of the queue simulated by createWithPicks(), referring to the entry by index rather
+  // than holding a weak pointer to it.
+  struct PrepickEntry {
+    double deadline_;
+    uint64_t order_offset_;
+    uint32_t index_;
+
+    // Same ordering as EdfEntry.
+    bool operator<(const PrepickEntry& other) const {
+      return deadline_ > other.deadline_ ||
+             (deadline_ == other.deadline_ && order_offset_ > other.order_offset_);
+    }
+  };
+
   // Current time in EDF scheduler.
   // TODO(htuch): Is it worth the small extra complexity to use integer time for performance
   // reasons?
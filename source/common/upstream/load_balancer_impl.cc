@@ -1085,30 +1085,23 @@ void EdfLoadBalancerBase::refresh(uint32_t priority) {
       // Skip edf creation.
       return;
     }
-    scheduler.edf_ = std::make_unique<EdfScheduler<const Host>>();
-
     // Populate scheduler with host list.
     // TODO(mattklein123): We must build the EDF schedule even if all of the hosts are currently
     // weighted 1. This is because currently we don't refresh host sets if only weights change.
     // We should probably change this to refresh at all times. See the comment in
     // BaseDynamicClusterImpl::updateDynamicHostList about this.
-    for (const auto& host : hosts) {
-      // We use a fixed weight here. While the weight may change without
-      // notification, this will only be stale until this host is next picked,
-      // at which point it is reinserted into the EdfScheduler with its new
-      // weight in chooseHost().
-      scheduler.edf_->add(hostWeight(*host), host);
-    }
-
-    // Cycle through hosts to achieve the intended offset behavior.
+    //
+    // We use a fixed weight here. While the weight may change without notification, this will
+    // only be stale until this host is next picked, at which point it is reinserted into the
+    // EdfScheduler with its new weight in chooseHost().
+    //
+    // Cycle through hosts to achieve the intended offset behavior. The picks are simulated while
+    // building the schedule, so a refresh costs O(n) plus the offset picks on plain deadlines.
     // TODO(htuch): Consider how we can avoid biasing towards earlier hosts in the schedule across
     // refreshes for the weighted case.
-    if (!hosts.empty()) {
-      for (uint32_t i = 0; i < seed_ % hosts.size(); ++i) {
-        auto host =
-            scheduler.edf_->pickAndAdd([this](const Host& host) { return hostWeight(host); });
-      }
-    }
+    scheduler.edf_ = EdfScheduler<const Host>::createWithPicks(
+        hosts, [this](const Host& host) { return hostWeight(host); },
+        hosts.empty() ? 0 : seed_ % hosts.size());
   };
   // Populate EdfSchedulers for each valid HostsSource value for the host set at this priority.
   const auto& host_set = priority_set_.hostSetsPerPriority()[priority];
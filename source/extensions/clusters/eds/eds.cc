@@ -6,6 +6,7 @@
 #include "envoy/service/discovery/v3/discovery.pb.h"
 
 #include "source/common/common/assert.h"
+#include "source/common/common/hash.h"
 #include "source/common/common/utility.h"
 #include "source/common/config/api_version.h"
 #include "source/common/config/decoded_resource_impl.h"
@@ -13,6 +14,22 @@
 namespace Envoy {
 namespace Upstream {
 
+namespace {
+
+// Serializes a message deterministically, so that equal messages have the same bytes.
+std::string serializeDeterministically(const Protobuf::Message& message) {
+  std::string bytes;
+  Protobuf::io::StringOutputStream stream(&bytes);
+  {
+    Protobuf::io::CodedOutputStream coded_stream(&stream);
+    coded_stream.SetSerializationDeterministic(true);
+    message.SerializeToCodedStream(&coded_stream);
+  }
+  return bytes;
+}
+
+} // namespace
+
 EdsClusterImpl::EdsClusterImpl(const envoy::config::cluster::v3::Cluster& cluster,
                                ClusterFactoryContext& cluster_context)
     : BaseDynamicClusterImpl(cluster, cluster_context),
@@ -49,6 +66,11 @@ EdsClusterImpl::~EdsClusterImpl() {
 void EdsClusterImpl::startPreInit() { subscription_->start({edsServiceName()}); }
 
 void EdsClusterImpl::BatchUpdateHelper::batchUpdate(PrioritySet::HostUpdateCb& host_update_cb) {
+  // Get the map of all the latest existing hosts, which is used to filter out the existing
+  // hosts in the process of updating cluster memberships.
+  HostMapConstSharedPtr all_hosts = parent_.prioritySet().crossPriorityHostMap();
+  ASSERT(all_hosts != nullptr);
+
   absl::flat_hash_set<std::string> all_new_hosts;
   PriorityStateManager priority_state_manager(parent_, parent_.local_info_, &host_update_cb);
   for (const auto& locality_lb_endpoint : cluster_load_assignment_.endpoints()) {
@@ -56,6 +78,15 @@ void EdsClusterImpl::BatchUpdateHelper::batchUpdate(PrioritySet::HostUpdateCb& h
 
     priority_state_manager.initializePriorityFor(locality_lb_endpoint);
 
+    // A host is built from its endpoint, locality and priority, so all of these are hashed to find
+    // the host of an unchanged endpoint.
+    EndpointHash locality_hash{};
+    if (reuse_unchanged_hosts_) {
+      const std::string locality = serializeDeterministically(locality_lb_endpoint.locality());
+      locality_hash = {HashUtil::xxHash64(locality, locality_lb_endpoint.priority()),
+                       HashUtil::xxHash64(locality, ~uint64_t{locality_lb_endpoint.priority()})};
+    }
+
     if (locality_lb_endpoint.has_leds_cluster_locality_config()) {
       // The locality uses LEDS, fetch its dynamic data, which must be ready, or otherwise
       // the batchUpdate method should not have been called.
@@ -67,13 +98,13 @@ void EdsClusterImpl::BatchUpdateHelper::batchUpdate(PrioritySet::HostUpdateCb& h
              parent_.leds_localities_[leds_config]->isUpdated());
       for (const auto& [_, lb_endpoint] :
            parent_.leds_localities_[leds_config]->getEndpointsMap()) {
-        updateLocalityEndpoints(lb_endpoint, locality_lb_endpoint, priority_state_manager,
-                                all_new_hosts);
+        updateLocalityEndpoints(lb_endpoint, locality_lb_endpoint, locality_hash, *all_hosts,
+                                priority_state_manager, all_new_hosts);
       }
     } else {
       for (const auto& lb_endpoint : locality_lb_endpoint.lb_endpoints()) {
-        updateLocalityEndpoints(lb_endpoint, locality_lb_endpoint, priority_state_manager,
-                                all_new_hosts);
+        updateLocalityEndpoints(lb_endpoint, locality_lb_endpoint, locality_hash, *all_hosts,
+                                priority_state_manager, all_new_hosts);
       }
     }
   }
@@ -81,11 +112,6 @@ void EdsClusterImpl::BatchUpdateHelper::batchUpdate(PrioritySet::HostUpdateCb& h
   // Track whether we rebuilt any LB structures.
   bool cluster_rebuilt = false;
 
-  // Get the map of all the latest existing hosts, which is used to filter out the existing
-  // hosts in the process of updating cluster memberships.
-  HostMapConstSharedPtr all_hosts = parent_.prioritySet().crossPriorityHostMap();
-  ASSERT(all_hosts != nullptr);
-
   const uint32_t overprovisioning_factor = PROTOBUF_GET_WRAPPED_OR_DEFAULT(
       cluster_load_assignment_.policy(), overprovisioning_factor, kDefaultOverProvisioningFactor);
   const bool weighted_priority_health =
@@ -130,6 +156,8 @@ void EdsClusterImpl::BatchUpdateHelper::batchUpdate(PrioritySet::HostUpdateCb& h
     parent_.info_->configUpdateStats().update_no_rebuild_.inc();
   }
 
+  updateHostsByEndpointHash();
+
   // If we didn't setup to initialize when our first round of health checking is complete, just
   // do it now.
   parent_.onPreInitComplete();
@@ -138,7 +166,19 @@ void EdsClusterImpl::BatchUpdateHelper::batchUpdate(PrioritySet::HostUpdateCb& h
 void EdsClusterImpl::BatchUpdateHelper::updateLocalityEndpoints(
     const envoy::config::endpoint::v3::LbEndpoint& lb_endpoint,
     const envoy::config::endpoint::v3::LocalityLbEndpoints& locality_lb_endpoint,
+    const EndpointHash& locality_hash, const HostMap& all_hosts,
     PriorityStateManager& priority_state_manager, absl::flat_hash_set<std::string>& all_new_hosts) {
+  EndpointHash endpoint_hash{};
+  if (reuse_unchanged_hosts_) {
+    const std::string endpoint = serializeDeterministically(lb_endpoint);
+    endpoint_hash = {HashUtil::xxHash64(endpoint, locality_hash.hash_),
+                     HashUtil::xxHash64(endpoint, locality_hash.check_hash_)};
+    if (reuseHost(endpoint_hash, locality_lb_endpoint, all_hosts, priority_state_manager,
+                  all_new_hosts)) {
+      return;
+    }
+  }
+
   const auto address = parent_.resolveProtoAddress(lb_endpoint.endpoint().address());
   std::vector<Network::Address::InstanceConstSharedPtr> address_list;
   if (!lb_endpoint.endpoint().additional_addresses().empty()) {
@@ -158,6 +198,59 @@ void EdsClusterImpl::BatchUpdateHelper::updateLocalityEndpoints(
                                                  address_list, locality_lb_endpoint, lb_endpoint,
                                                  parent_.time_source_);
   all_new_hosts.emplace(address_as_string);
+  if (reuse_unchanged_hosts_) {
+    built_hosts_.push_back({endpoint_hash, address_as_string});
+  }
+}
+
+bool EdsClusterImpl::BatchUpdateHelper::reuseHost(
+    const EndpointHash& endpoint_hash,
+    const envoy::config::endpoint::v3::LocalityLbEndpoints& locality_lb_endpoint,
+    const HostMap& all_hosts, PriorityStateManager& priority_state_manager,
+    absl::flat_hash_set<std::string>& all_new_hosts) {
+  const auto it = parent_.hosts_by_endpoint_hash_.find(endpoint_hash.hash_);
+  // Two different endpoints may have the same hash.
+  if (it == parent_.hosts_by_endpoint_hash_.end() ||
+      it->second->check_hash_ != endpoint_hash.check_hash_) {
+    return false;
+  }
+  const HostSharedPtr& host = it->second->host_;
+  const auto address_as_string = host->address()->asString();
+  // The host may have been replaced since the last update, e.g. by a host of an endpoint that
+  // moved to another locality, in which case the current host is matched as usual.
+  const auto existing_host = all_hosts.find(address_as_string);
+  if (existing_host == all_hosts.end() || existing_host->second != host) {
+    return false;
+  }
+
+  // When the configuration contains duplicate hosts, only the first one will be retained.
+  if (!all_new_hosts.contains(address_as_string)) {
+    priority_state_manager.registerHostForPriority(host, locality_lb_endpoint);
+    all_new_hosts.emplace(address_as_string);
+    reused_hosts_.emplace(endpoint_hash.hash_, it->second);
+  }
+  return true;
+}
+
+void EdsClusterImpl::BatchUpdateHelper::updateHostsByEndpointHash() {
+  if (!reuse_unchanged_hosts_) {
+    parent_.hosts_by_endpoint_hash_.clear();
+    return;
+  }
+
+  // A built host is only matched against the existing hosts by address when the priority set is
+  // updated, so look up the host that the cluster kept for each address.
+  HostMapConstSharedPtr all_hosts = parent_.prioritySet().crossPriorityHostMap();
+  for (const BuiltHost& built_host : built_hosts_) {
+    const auto host = all_hosts->find(built_host.address_);
+    if (host != all_hosts->end()) {
+      reused_hosts_.emplace(built_host.endpoint_hash_.hash_,
+                            std::make_shared<const EndpointHost>(EndpointHost{
+                                host->second, built_host.endpoint_hash_.check_hash_}));
+    }
+  }
+  // Endpoints that are not part of this update are dropped.
+  parent_.hosts_by_endpoint_hash_ = std::move(reused_hosts_);
 }
 
 absl::Status
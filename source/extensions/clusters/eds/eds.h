@@ -18,10 +18,13 @@
 #include "envoy/upstream/locality.h"
 
 #include "source/common/config/subscription_base.h"
+#include "source/common/runtime/runtime_features.h"
 #include "source/common/upstream/cluster_factory_impl.h"
 #include "source/common/upstream/upstream_impl.h"
 #include "source/extensions/clusters/eds/leds.h"
 
+#include "absl/container/flat_hash_map.h"
+
 namespace Envoy {
 namespace Upstream {
 
@@ -78,12 +81,29 @@ private:
   // Returns true iff all the LEDS based localities were updated.
   bool validateAllLedsUpdated() const;
 
+  // Two hashes of the serialized bytes of an endpoint, locality and priority, with independent
+  // seeds. The first one looks up the host of an endpoint, and the second one tells endpoints apart
+  // when the first one collides, rather than keeping copies of the endpoints to compare them.
+  struct EndpointHash {
+    uint64_t hash_;
+    uint64_t check_hash_;
+  };
+
+  // A host built by a previous update, along with the check hash of the endpoint it was built from.
+  struct EndpointHost {
+    HostSharedPtr host_;
+    uint64_t check_hash_;
+  };
+  using EndpointHostConstSharedPtr = std::shared_ptr<const EndpointHost>;
+
   class BatchUpdateHelper : public PrioritySet::BatchUpdateCb {
   public:
     BatchUpdateHelper(
         EdsClusterImpl& parent,
         const envoy::config::endpoint::v3::ClusterLoadAssignment& cluster_load_assignment)
-        : parent_(parent), cluster_load_assignment_(cluster_load_assignment) {}
+        : parent_(parent), cluster_load_assignment_(cluster_load_assignment),
+          reuse_unchanged_hosts_(Runtime::runtimeFeatureEnabled(
+              "envoy.reloadable_features.eds_reuse_unchanged_hosts")) {}
 
     // Upstream::PrioritySet::BatchUpdateCb
     void batchUpdate(PrioritySet::HostUpdateCb& host_update_cb) override;
@@ -92,11 +112,29 @@ private:
     void updateLocalityEndpoints(
         const envoy::config::endpoint::v3::LbEndpoint& lb_endpoint,
         const envoy::config::endpoint::v3::LocalityLbEndpoints& locality_lb_endpoint,
+        const EndpointHash& locality_hash, const HostMap& all_hosts,
         PriorityStateManager& priority_state_manager,
         absl::flat_hash_set<std::string>& all_new_hosts);
+    // Registers the host built for the same endpoint by a previous update, if it is still the
+    // cluster's host for its address. Returns false if the host must be built from the endpoint.
+    bool reuseHost(const EndpointHash& endpoint_hash,
+                   const envoy::config::endpoint::v3::LocalityLbEndpoints& locality_lb_endpoint,
+                   const HostMap& all_hosts, PriorityStateManager& priority_state_manager,
+                   absl::flat_hash_set<std::string>& all_new_hosts);
+    // Remembers the hosts of this update for the next one, once the priority set is updated.
+    void updateHostsByEndpointHash();
 
     EdsClusterImpl& parent_;
     const envoy::config::endpoint::v3::ClusterLoadAssignment& cluster_load_assignment_;
+    const bool reuse_unchanged_hosts_;
+    // The hosts reused by this update, keyed by endpoint hash.
+    absl::flat_hash_map<uint64_t, EndpointHostConstSharedPtr> reused_hosts_;
+    // A host built by this update.
+    struct BuiltHost {
+      EndpointHash endpoint_hash_;
+      std::string address_;
+    };
+    std::vector<BuiltHost> built_hosts_;
   };
 
   Config::SubscriptionPtr subscription_;
@@ -111,6 +149,10 @@ private:
   // Maps between a LEDS configuration (ConfigSource + collection name) to the locality endpoints
   // data.
   LedsConfigMap leds_localities_;
+  // The host of each endpoint of the last update, keyed by a hash of the endpoint together with its
+  // locality and priority. An endpoint that is unchanged in the next update reuses its host rather
+  // than resolving its address and building a new host only to match it against the existing one.
+  absl::flat_hash_map<uint64_t, EndpointHostConstSharedPtr> hosts_by_endpoint_hash_;
   // TODO(adisuissa): Avoid saving the entire cluster load assignment, only the
   // relevant parts of the config for each locality. Note that this field must
   // be set when LEDS is used.
@@ -122,6 +164,8 @@ private:
 
   // Tracks whether a cached resource is used as the current EDS resource.
   bool using_cached_resource_{false};
+
+  friend class EdsClusterImplPeer;
 };
 
 using EdsClusterImplSharedPtr = std::shared_ptr<EdsClusterImpl>;
@@ -103,9 +103,15 @@ public:
     return read_policy_;
   }
 
-private:
-  absl::string_view hashtag(absl::string_view v, bool enabled);
+  /**
+   * @param v supplies the key of a Redis request.
+   * @param enabled specify whether hashtagging is enabled.
+   * @return absl::string_view the part of the key that is hashed: its hash tag if hashtagging is
+   * enabled and it has one, or else the whole key.
+   */
+  static absl::string_view hashtag(absl::string_view v, bool enabled);
 
+private:
   static bool isReadRequest(const NetworkFilters::Common::Redis::RespValue& request);
 
   const absl::optional<uint64_t> hash_key_;
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "envoy/common/backoff_strategy.h"
+#include "envoy/common/optref.h"
 #include "envoy/config/custom_config_validators.h"
 #include "envoy/config/eds_resources_cache.h"
 #include "envoy/config/xds_config_tracker.h"
@@ -9,6 +10,7 @@
 #include "envoy/grpc/async_client.h"
 #include "envoy/local_info/local_info.h"
 #include "envoy/stats/scope.h"
+#include "envoy/thread/thread.h"
 
 #include "source/common/config/utility.h"
 
@@ -30,6 +32,9 @@ struct GrpcMuxContext {
   BackOffStrategyPtr backoff_strategy_;
   const std::string& target_xds_authority_;
   EdsResourcesCachePtr eds_resources_cache_;
+  // Used to decode the resources of large responses on several threads. If not set, resources
+  // are decoded on the main thread.
+  OptRef<Thread::ThreadFactory> thread_factory_;
 };
 
 } // namespace Config
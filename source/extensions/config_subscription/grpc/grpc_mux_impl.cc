@@ -59,12 +59,14 @@ std::string convertToWildcard(const std::string& resource_name) {
 }
 } // namespace
 
-GrpcMuxImpl::GrpcMuxImpl(GrpcMuxContext& grpc_mux_context, bool skip_subsequent_node)
+GrpcMuxImpl::GrpcMuxImpl(GrpcMuxContext& grpc_mux_context, bool skip_subsequent_node,
+                         uint32_t resource_decoding_threads)
     : grpc_stream_(this, std::move(grpc_mux_context.async_client_),
                    grpc_mux_context.service_method_, grpc_mux_context.dispatcher_,
                    grpc_mux_context.scope_, std::move(grpc_mux_context.backoff_strategy_),
                    grpc_mux_context.rate_limit_settings_),
       local_info_(grpc_mux_context.local_info_), skip_subsequent_node_(skip_subsequent_node),
+      parallel_resource_decoder_(grpc_mux_context.thread_factory_, resource_decoding_threads),
       config_validators_(std::move(grpc_mux_context.config_validators_)),
       xds_config_tracker_(grpc_mux_context.xds_config_tracker_),
       xds_resources_delegate_(grpc_mux_context.xds_resources_delegate_),
@@ -314,8 +316,12 @@ void GrpcMuxImpl::onDiscoveryResponse(
   TRY_ASSERT_MAIN_THREAD {
     std::vector<DecodedResourcePtr> resources;
     OpaqueResourceDecoder& resource_decoder = *api_state.watches_.front()->resource_decoder_;
+    // Empty if the resources are decoded serially below.
+    std::vector<PreDecodedResource> pre_decoded_resources =
+        parallel_resource_decoder_.preDecodeResources(resource_decoder, message->resources());
 
-    for (const auto& resource : message->resources()) {
+    for (int i = 0; i < message->resources_size(); ++i) {
+      const auto& resource = message->resources(i);
       // TODO(snowp): Check the underlying type when the resource is a Resource.
       if (!resource.Is<envoy::service::discovery::v3::Resource>() &&
           type_url != resource.type_url()) {
@@ -325,7 +331,12 @@ void GrpcMuxImpl::onDiscoveryResponse(
       }
 
       auto decoded_resource =
-          DecodedResourceImpl::fromResource(resource_decoder, resource, message->version_info());
+          pre_decoded_resources.empty()
+              ? DecodedResourceImpl::fromResource(resource_decoder, resource,
+                                                  message->version_info())
+              : DecodedResourceImpl::fromResource(resource_decoder, resource,
+                                                  message->version_info(),
+                                                  std::move(pre_decoded_resources[i]));
 
       if (!isHeartbeatResource(type_url, *decoded_resource)) {
         resources.emplace_back(std::move(decoded_resource));
@@ -571,6 +582,10 @@ public:
          const LocalInfo::LocalInfo& local_info, CustomConfigValidatorsPtr&& config_validators,
          BackOffStrategyPtr&& backoff_strategy, XdsConfigTrackerOptRef xds_config_tracker,
          XdsResourcesDelegateOptRef xds_resources_delegate, bool use_eds_resources_cache) override {
+    if (ads_config.resource_decoding_threads() > 1) {
+      ENVOY_LOG_MISC(warn, "resource_decoding_threads is not supported by ADS, resources are "
+                           "decoded on the main thread");
+    }
     GrpcMuxContext grpc_mux_context{
         /*async_client_=*/std::move(async_client),
         /*dispatcher_=*/dispatcher,
@@ -589,9 +604,12 @@ public:
         (use_eds_resources_cache &&
          Runtime::runtimeFeatureEnabled("envoy.restart_features.use_eds_cache_for_ads"))
             ? std::make_unique<EdsResourcesCacheImpl>(dispatcher)
-            : nullptr};
+            : nullptr,
+        // MuxFactory does not provide a thread factory, so ADS responses are decoded serially.
+        /*thread_factory_=*/{}};
     return std::make_shared<Config::GrpcMuxImpl>(grpc_mux_context,
-                                                 ads_config.set_node_on_first_message_only());
+                                                 ads_config.set_node_on_first_message_only(),
+                                                 ads_config.resource_decoding_threads());
   }
 };
 
@@ -39,15 +39,17 @@ GrpcConfigSubscriptionFactory::create(ConfigSubscriptionFactory::SubscriptionDat
       /*xds_config_tracker_=*/data.xds_config_tracker_,
       /*backoff_strategy_=*/std::move(backoff_strategy),
       /*target_xds_authority_=*/control_plane_id,
-      /*eds_resources_cache_=*/nullptr // EDS cache is only used for ADS.
-  };
+      /*eds_resources_cache_=*/nullptr, // EDS cache is only used for ADS.
+      /*thread_factory_=*/data.api_.threadFactory()};
 
   if (Runtime::runtimeFeatureEnabled("envoy.reloadable_features.unified_mux")) {
     mux = std::make_shared<Config::XdsMux::GrpcMuxSotw>(
-        grpc_mux_context, api_config_source.set_node_on_first_message_only());
+        grpc_mux_context, api_config_source.set_node_on_first_message_only(),
+        api_config_source.resource_decoding_threads());
   } else {
     mux = std::make_shared<Config::GrpcMuxImpl>(grpc_mux_context,
-                                                api_config_source.set_node_on_first_message_only());
+                                                api_config_source.set_node_on_first_message_only(),
+                                                api_config_source.resource_decoding_threads());
   }
   return std::make_unique<GrpcSubscriptionImpl>(
       std::move(mux), data.callbacks_, data.resource_decoder_, data.stats_, data.type_url_,
@@ -60,6 +62,10 @@ DeltaGrpcConfigSubscriptionFactory::create(ConfigSubscriptionFactory::Subscripti
   GrpcMuxSharedPtr mux;
   const envoy::config::core::v3::ApiConfigSource& api_config_source =
       data.config_.api_config_source();
+  if (api_config_source.resource_decoding_threads() > 1) {
+    ENVOY_LOG_MISC(warn, "resource_decoding_threads is not supported by delta xDS, resources are "
+                         "decoded on the main thread");
+  }
   CustomConfigValidatorsPtr custom_config_validators = std::make_unique<CustomConfigValidatorsImpl>(
       data.validation_visitor_, data.server_, api_config_source.config_validators());
 
@@ -82,8 +88,8 @@ DeltaGrpcConfigSubscriptionFactory::create(ConfigSubscriptionFactory::Subscripti
       /*xds_config_tracker_=*/data.xds_config_tracker_,
       /*backoff_strategy_=*/std::move(backoff_strategy),
       /*target_xds_authority_=*/"",
-      /*eds_resources_cache_=*/nullptr // EDS cache is only used for ADS.
-  };
+      /*eds_resources_cache_=*/nullptr, // EDS cache is only used for ADS.
+      /*thread_factory_=*/data.api_.threadFactory()};
 
   if (Runtime::runtimeFeatureEnabled("envoy.reloadable_features.unified_mux")) {
     mux = std::make_shared<Config::XdsMux::GrpcMuxDelta>(
@@ -357,6 +357,10 @@ public:
          const LocalInfo::LocalInfo& local_info, CustomConfigValidatorsPtr&& config_validators,
          BackOffStrategyPtr&& backoff_strategy, XdsConfigTrackerOptRef xds_config_tracker,
          OptRef<XdsResourcesDelegate>, bool use_eds_resources_cache) override {
+    if (ads_config.resource_decoding_threads() > 1) {
+      ENVOY_LOG_MISC(warn, "resource_decoding_threads is not supported by ADS, resources are "
+                           "decoded on the main thread");
+    }
     GrpcMuxContext grpc_mux_context{
         /*async_client_=*/std::move(async_client),
         /*dispatcher_=*/dispatcher,
@@ -375,7 +379,9 @@ public:
         (use_eds_resources_cache &&
          Runtime::runtimeFeatureEnabled("envoy.restart_features.use_eds_cache_for_ads"))
             ? std::make_unique<EdsResourcesCacheImpl>(dispatcher)
-            : nullptr};
+            : nullptr,
+        // MuxFactory does not provide a thread factory, so ADS responses are decoded serially.
+        /*thread_factory_=*/{}};
     return std::make_shared<Config::NewGrpcMuxImpl>(grpc_mux_context);
   }
 };
@@ -392,8 +392,11 @@ void GrpcMuxDelta::requestOnDemandUpdate(const std::string& type_url,
   }
 }
 
-GrpcMuxSotw::GrpcMuxSotw(GrpcMuxContext& grpc_mux_context, bool skip_subsequent_node)
-    : GrpcMuxImpl(std::make_unique<SotwSubscriptionStateFactory>(grpc_mux_context.dispatcher_),
+GrpcMuxSotw::GrpcMuxSotw(GrpcMuxContext& grpc_mux_context, bool skip_subsequent_node,
+                         uint32_t resource_decoding_threads)
+    : GrpcMuxImpl(std::make_unique<SotwSubscriptionStateFactory>(grpc_mux_context.dispatcher_,
+                                                                 grpc_mux_context.thread_factory_,
+                                                                 resource_decoding_threads),
                   grpc_mux_context, skip_subsequent_node) {}
 
 Config::GrpcMuxWatchPtr NullGrpcMuxImpl::addWatch(const std::string&,
@@ -415,6 +418,10 @@ public:
          const LocalInfo::LocalInfo& local_info, CustomConfigValidatorsPtr&& config_validators,
          BackOffStrategyPtr&& backoff_strategy, XdsConfigTrackerOptRef xds_config_tracker,
          XdsResourcesDelegateOptRef, bool use_eds_resources_cache) override {
+    if (ads_config.resource_decoding_threads() > 1) {
+      ENVOY_LOG_MISC(warn, "resource_decoding_threads is not supported by ADS, resources are "
+                           "decoded on the main thread");
+    }
     GrpcMuxContext grpc_mux_context{
         /*async_client_=*/std::move(async_client),
         /*dispatcher_=*/dispatcher,
@@ -433,7 +440,9 @@ public:
         (use_eds_resources_cache &&
          Runtime::runtimeFeatureEnabled("envoy.restart_features.use_eds_cache_for_ads"))
             ? std::make_unique<EdsResourcesCacheImpl>(dispatcher)
-            : nullptr};
+            : nullptr,
+        // MuxFactory does not provide a thread factory, so ADS responses are decoded serially.
+        /*thread_factory_=*/{}};
     return std::make_shared<GrpcMuxDelta>(grpc_mux_context,
                                           ads_config.set_node_on_first_message_only());
   }
@@ -450,6 +459,10 @@ public:
          const LocalInfo::LocalInfo& local_info, CustomConfigValidatorsPtr&& config_validators,
          BackOffStrategyPtr&& backoff_strategy, XdsConfigTrackerOptRef xds_config_tracker,
          XdsResourcesDelegateOptRef, bool use_eds_resources_cache) override {
+    if (ads_config.resource_decoding_threads() > 1) {
+      ENVOY_LOG_MISC(warn, "resource_decoding_threads is not supported by ADS, resources are "
+                           "decoded on the main thread");
+    }
     GrpcMuxContext grpc_mux_context{
         /*async_client_=*/std::move(async_client),
         /*dispatcher_=*/dispatcher,
@@ -468,9 +481,12 @@ public:
         (use_eds_resources_cache &&
          Runtime::runtimeFeatureEnabled("envoy.restart_features.use_eds_cache_for_ads"))
             ? std::make_unique<EdsResourcesCacheImpl>(dispatcher)
-            : nullptr};
+            : nullptr,
+        // MuxFactory does not provide a thread factory, so ADS responses are decoded serially.
+        /*thread_factory_=*/{}};
     return std::make_shared<GrpcMuxSotw>(grpc_mux_context,
-                                         ads_config.set_node_on_first_message_only());
+                                         ads_config.set_node_on_first_message_only(),
+                                         ads_config.resource_decoding_threads());
   }
 };
 
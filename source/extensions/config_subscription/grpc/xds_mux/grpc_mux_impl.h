@@ -232,7 +232,8 @@ class GrpcMuxSotw : public GrpcMuxImpl<SotwSubscriptionState, SotwSubscriptionSt
                                        envoy::service::discovery::v3::DiscoveryRequest,
                                        envoy::service::discovery::v3::DiscoveryResponse> {
 public:
-  GrpcMuxSotw(GrpcMuxContext& grpc_mux_context, bool skip_subsequent_node);
+  GrpcMuxSotw(GrpcMuxContext& grpc_mux_context, bool skip_subsequent_node,
+              uint32_t resource_decoding_threads);
 
   // GrpcStreamCallbacks
   void requestOnDemandUpdate(const std::string&, const absl::flat_hash_set<std::string>&) override {
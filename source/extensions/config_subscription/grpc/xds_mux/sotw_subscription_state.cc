@@ -9,11 +9,13 @@ namespace XdsMux {
 
 SotwSubscriptionState::SotwSubscriptionState(
     std::string type_url, UntypedConfigUpdateCallbacks& callbacks, Event::Dispatcher& dispatcher,
-    OpaqueResourceDecoderSharedPtr resource_decoder, XdsConfigTrackerOptRef xds_config_tracker,
-    XdsResourcesDelegateOptRef xds_resources_delegate, const std::string& target_xds_authority)
+    OpaqueResourceDecoderSharedPtr resource_decoder,
+    const ParallelResourceDecoder& parallel_resource_decoder,
+    XdsConfigTrackerOptRef xds_config_tracker, XdsResourcesDelegateOptRef xds_resources_delegate,
+    const std::string& target_xds_authority)
     : BaseSubscriptionState(std::move(type_url), callbacks, dispatcher, xds_config_tracker,
                             xds_resources_delegate, target_xds_authority),
-      resource_decoder_(resource_decoder) {}
+      resource_decoder_(resource_decoder), parallel_resource_decoder_(parallel_resource_decoder) {}
 
 SotwSubscriptionState::~SotwSubscriptionState() = default;
 
@@ -49,7 +51,11 @@ void SotwSubscriptionState::handleGoodResponse(
 
   {
     const auto scoped_update = ttl_.scopedTtlUpdate();
-    for (const auto& any : message.resources()) {
+    // Empty if the resources are decoded serially below.
+    std::vector<PreDecodedResource> pre_decoded_resources =
+        parallel_resource_decoder_.preDecodeResources(*resource_decoder_, message.resources());
+    for (int i = 0; i < message.resources_size(); ++i) {
+      const auto& any = message.resources(i);
       if (!any.Is<envoy::service::discovery::v3::Resource>() &&
           any.type_url() != message.type_url()) {
         throw EnvoyException(fmt::format("type URL {} embedded in an individual Any does not match "
@@ -59,7 +65,10 @@ void SotwSubscriptionState::handleGoodResponse(
       }
 
       auto decoded_resource =
-          DecodedResourceImpl::fromResource(*resource_decoder_, any, message.version_info());
+          pre_decoded_resources.empty()
+              ? DecodedResourceImpl::fromResource(*resource_decoder_, any, message.version_info())
+              : DecodedResourceImpl::fromResource(*resource_decoder_, any, message.version_info(),
+                                                  std::move(pre_decoded_resources[i]));
       setResourceTtl(*decoded_resource);
       if (isHeartbeatResource(*decoded_resource, message.version_info())) {
         continue;
@@ -6,6 +6,7 @@
 #include "source/common/common/assert.h"
 #include "source/common/common/hash.h"
 #include "source/common/config/decoded_resource_impl.h"
+#include "source/common/config/parallel_resource_decoder.h"
 #include "source/extensions/config_subscription/grpc/xds_mux/subscription_state.h"
 
 #include "absl/types/optional.h"
@@ -23,6 +24,7 @@ public:
   SotwSubscriptionState(std::string type_url, UntypedConfigUpdateCallbacks& callbacks,
                         Event::Dispatcher& dispatcher,
                         OpaqueResourceDecoderSharedPtr resource_decoder,
+                        const ParallelResourceDecoder& parallel_resource_decoder,
                         XdsConfigTrackerOptRef xds_config_tracker,
                         XdsResourcesDelegateOptRef xds_resources_delegate,
                         const std::string& target_xds_authority);
@@ -53,6 +55,7 @@ private:
   bool isHeartbeatResource(const DecodedResource& resource, const std::string& version);
 
   OpaqueResourceDecoderSharedPtr resource_decoder_;
+  const ParallelResourceDecoder& parallel_resource_decoder_;
 
   // The version_info carried by the last accepted DiscoveryResponse.
   // Remains empty until one is accepted.
@@ -70,7 +73,11 @@ private:
 
 class SotwSubscriptionStateFactory : public SubscriptionStateFactory<SotwSubscriptionState> {
 public:
-  SotwSubscriptionStateFactory(Event::Dispatcher& dispatcher) : dispatcher_(dispatcher) {}
+  SotwSubscriptionStateFactory(Event::Dispatcher& dispatcher,
+                               OptRef<Thread::ThreadFactory> thread_factory,
+                               uint32_t resource_decoding_threads)
+      : dispatcher_(dispatcher),
+        parallel_resource_decoder_(thread_factory, resource_decoding_threads) {}
   ~SotwSubscriptionStateFactory() override = default;
   std::unique_ptr<SotwSubscriptionState>
   makeSubscriptionState(const std::string& type_url, UntypedConfigUpdateCallbacks& callbacks,
@@ -78,13 +85,15 @@ public:
                         XdsConfigTrackerOptRef xds_config_tracker,
                         XdsResourcesDelegateOptRef xds_resources_delegate,
                         const std::string& target_xds_authority) override {
-    return std::make_unique<SotwSubscriptionState>(type_url, callbacks, dispatcher_,
-                                                   resource_decoder, xds_config_tracker,
-                                                   xds_resources_delegate, target_xds_authority);
+    return std::make_unique<SotwSubscriptionState>(
+        type_url, callbacks, dispatcher_, resource_decoder, parallel_resource_decoder_,
+        xds_config_tracker, xds_resources_delegate, target_xds_authority);
   }
 
 private:
   Event::Dispatcher& dispatcher_;
+  // Shared by the subscription states of the mux, which all decode responses on the main thread.
+  const ParallelResourceDecoder parallel_resource_decoder_;
 };
 
 } // namespace XdsMux
@@ -419,6 +419,12 @@ EXTENSIONS = {
 
     "envoy.key_value.file_based":     "//source/extensions/key_value/file_based:config_lib",
 
+    #
+    # Private key providers
+    #
+
+    "envoy.tls.key_providers.thread_pool":             "//source/extensions/private_key_providers/thread_pool:config",
+
     #
     # RBAC matchers
     #
@@ -1,9 +1,14 @@
 #include "source/extensions/filters/common/rbac/matchers.h"
 
+#include <array>
+#include <functional>
+#include <map>
+
 #include "envoy/config/rbac/v3/rbac.pb.h"
 #include "envoy/upstream/upstream.h"
 
 #include "source/common/config/utility.h"
+#include "source/common/protobuf/utility.h"
 #include "source/extensions/filters/common/rbac/matcher_extension.h"
 
 namespace Envoy {
@@ -12,6 +17,132 @@ namespace Filters {
 namespace Common {
 namespace RBAC {
 
+namespace {
+
+// The number of rules of the same kind from which an OrMatcher merges them into a single matcher.
+// A few rules are cheaper to evaluate one by one than with a lookup.
+constexpr size_t MinRulesToMerge = 4;
+
+/**
+ * Builds the sub-matchers of an OrMatcher. The rules that can be merged are grouped by kind, and
+ * the other rules are created in order, without the repeated ones. Rule is either a Permission or a
+ * Principal.
+ */
+template <class Rule> class OrRulesCompiler {
+public:
+  OrRulesCompiler(std::vector<MatcherConstSharedPtr>& matchers,
+                  std::function<MatcherConstSharedPtr(const Rule&)> create)
+      : matchers_(matchers), create_(std::move(create)) {}
+
+  void addIp(const Rule& rule, const envoy::config::core::v3::CidrRange& range,
+             IPMatcher::Type type) {
+    auto cidr = Network::Address::CidrRange::create(range);
+    if (!cidr.isValid()) {
+      add(rule);
+      return;
+    }
+    ip_ranges_[type].push_back({&rule, std::move(cidr)});
+  }
+
+  void addHeader(const Rule& rule, const envoy::config::route::v3::HeaderMatcher& header) {
+    if (header.invert_match() || header.treat_missing_header_as_empty()) {
+      add(rule);
+      return;
+    }
+    if (header.header_match_specifier_case() ==
+            envoy::config::route::v3::HeaderMatcher::kExactMatch &&
+        !header.exact_match().empty()) {
+      // An empty exact_match matches any value.
+      header_values_[header.name()].push_back({&rule, header.exact_match()});
+    } else if (header.header_match_specifier_case() ==
+                   envoy::config::route::v3::HeaderMatcher::kStringMatch &&
+               header.string_match().match_pattern_case() ==
+                   envoy::type::matcher::v3::StringMatcher::kExact &&
+               !header.string_match().ignore_case()) {
+      header_values_[header.name()].push_back({&rule, header.string_match().exact()});
+    } else {
+      add(rule);
+    }
+  }
+
+  void addAuthenticated(const Rule& rule,
+                        const envoy::config::rbac::v3::Principal::Authenticated& authenticated) {
+    if (!authenticated.has_principal_name() ||
+        authenticated.principal_name().match_pattern_case() !=
+            envoy::type::matcher::v3::StringMatcher::kExact ||
+        authenticated.principal_name().ignore_case()) {
+      add(rule);
+      return;
+    }
+    principal_names_.push_back({&rule, authenticated.principal_name().exact()});
+  }
+
+  void add(const Rule& rule) {
+    if (rules_.insert(rule).second) {
+      matchers_.push_back(create_(rule));
+    }
+  }
+
+  // Creates the matchers of the grouped rules, merged if there are enough of them.
+  void compile() {
+    for (size_t type = 0; type < ip_ranges_.size(); type++) {
+      const auto& ranges = ip_ranges_[type];
+      if (ranges.size() < MinRulesToMerge) {
+        addAll(ranges);
+        continue;
+      }
+      std::vector<Network::Address::CidrRange> cidrs;
+      cidrs.reserve(ranges.size());
+      for (const auto& range : ranges) {
+        cidrs.push_back(range.second);
+      }
+      matchers_.push_back(
+          std::make_shared<const IPSetMatcher>(cidrs, static_cast<IPMatcher::Type>(type)));
+    }
+    for (const auto& [name, values] : header_values_) {
+      if (values.size() < MinRulesToMerge) {
+        addAll(values);
+        continue;
+      }
+      matchers_.push_back(std::make_shared<const HeaderValueSetMatcher>(name, valueSet(values)));
+    }
+    if (principal_names_.size() < MinRulesToMerge) {
+      addAll(principal_names_);
+    } else {
+      matchers_.push_back(
+          std::make_shared<const AuthenticatedSetMatcher>(valueSet(principal_names_)));
+    }
+  }
+
+private:
+  template <class Value> using Group = std::vector<std::pair<const Rule*, Value>>;
+
+  template <class Value> void addAll(const Group<Value>& group) {
+    for (const auto& entry : group) {
+      add(*entry.first);
+    }
+  }
+
+  static absl::flat_hash_set<std::string> valueSet(const Group<std::string>& group) {
+    absl::flat_hash_set<std::string> values;
+    for (const auto& entry : group) {
+      values.insert(entry.second);
+    }
+    return values;
+  }
+
+  std::vector<MatcherConstSharedPtr>& matchers_;
+  const std::function<MatcherConstSharedPtr(const Rule&)> create_;
+  // Indexed by IPMatcher::Type.
+  std::array<Group<Network::Address::CidrRange>, 4> ip_ranges_;
+  // Keyed by header name. A std::map keeps the order of the matchers deterministic.
+  std::map<std::string, Group<std::string>> header_values_;
+  Group<std::string> principal_names_;
+  absl::flat_hash_set<Rule, MessageUtil, MessageUtil> rules_;
+};
+
+} // namespace
+
 MatcherConstSharedPtr Matcher::create(const envoy::config::rbac::v3::Permission& permission,
                                       ProtobufMessage::ValidationVisitor& validation_visitor) {
   switch (permission.rule_case()) {
@@ -111,15 +242,52 @@ bool AndMatcher::matches(const Network::Connection& connection,
 
 OrMatcher::OrMatcher(const Protobuf::RepeatedPtrField<envoy::config::rbac::v3::Permission>& rules,
                      ProtobufMessage::ValidationVisitor& validation_visitor) {
+  OrRulesCompiler<envoy::config::rbac::v3::Permission> compiler(
+      matchers_, [&validation_visitor](const envoy::config::rbac::v3::Permission& rule) {
+        return Matcher::create(rule, validation_visitor);
+      });
   for (const auto& rule : rules) {
-    matchers_.push_back(Matcher::create(rule, validation_visitor));
+    switch (rule.rule_case()) {
+    case envoy::config::rbac::v3::Permission::RuleCase::kDestinationIp:
+      compiler.addIp(rule, rule.destination_ip(), IPMatcher::Type::DownstreamLocal);
+      break;
+    case envoy::config::rbac::v3::Permission::RuleCase::kHeader:
+      compiler.addHeader(rule, rule.header());
+      break;
+    default:
+      compiler.add(rule);
+      break;
+    }
   }
+  compiler.compile();
 }
 
 OrMatcher::OrMatcher(const Protobuf::RepeatedPtrField<envoy::config::rbac::v3::Principal>& ids) {
+  OrRulesCompiler<envoy::config::rbac::v3::Principal> compiler(
+      matchers_, [](const envoy::config::rbac::v3::Principal& id) { return Matcher::create(id); });
   for (const auto& id : ids) {
-    matchers_.push_back(Matcher::create(id));
+    switch (id.identifier_case()) {
+    case envoy::config::rbac::v3::Principal::IdentifierCase::kSourceIp:
+      compiler.addIp(id, id.source_ip(), IPMatcher::Type::ConnectionRemote);
+      break;
+    case envoy::config::rbac::v3::Principal::IdentifierCase::kDirectRemoteIp:
+      compiler.addIp(id, id.direct_remote_ip(), IPMatcher::Type::DownstreamDirectRemote);
+      break;
+    case envoy::config::rbac::v3::Principal::IdentifierCase::kRemoteIp:
+      compiler.addIp(id, id.remote_ip(), IPMatcher::Type::DownstreamRemote);
+      break;
+    case envoy::config::rbac::v3::Principal::IdentifierCase::kHeader:
+      compiler.addHeader(id, id.header());
+      break;
+    case envoy::config::rbac::v3::Principal::IdentifierCase::kAuthenticated:
+      compiler.addAuthenticated(id, id.authenticated());
+      break;
+    default:
+      compiler.add(id);
+      break;
+    }
   }
+  compiler.compile();
 }
 
 bool OrMatcher::matches(const Network::Connection& connection,
@@ -146,24 +314,42 @@ bool HeaderMatcher::matches(const Network::Connection&,
   return Envoy::Http::HeaderUtility::matchHeaders(headers, header_);
 }
 
-bool IPMatcher::matches(const Network::Connection& connection, const Envoy::Http::RequestHeaderMap&,
-                        const StreamInfo::StreamInfo& info) const {
-  Envoy::Network::Address::InstanceConstSharedPtr ip;
-  switch (type_) {
+bool HeaderValueSetMatcher::matches(const Network::Connection&,
+                                    const Envoy::Http::RequestHeaderMap& headers,
+                                    const StreamInfo::StreamInfo&) const {
+  const auto header_value = Envoy::Http::HeaderUtility::getAllOfHeaderAsString(headers, name_);
+  return header_value.result().has_value() && values_.contains(header_value.result().value());
+}
+
+const Envoy::Network::Address::InstanceConstSharedPtr&
+IPMatcher::address(Type type, const Network::Connection& connection,
+                   const StreamInfo::StreamInfo& info) {
+  switch (type) {
   case ConnectionRemote:
-    ip = connection.connectionInfoProvider().remoteAddress();
-    break;
+    return connection.connectionInfoProvider().remoteAddress();
   case DownstreamLocal:
-    ip = info.downstreamAddressProvider().localAddress();
-    break;
+    return info.downstreamAddressProvider().localAddress();
   case DownstreamDirectRemote:
-    ip = info.downstreamAddressProvider().directRemoteAddress();
-    break;
+    return info.downstreamAddressProvider().directRemoteAddress();
   case DownstreamRemote:
-    ip = info.downstreamAddressProvider().remoteAddress();
-    break;
+    return info.downstreamAddressProvider().remoteAddress();
+  }
+  PANIC_DUE_TO_CORRUPT_ENUM;
+}
+
+bool IPMatcher::matches(const Network::Connection& connection, const Envoy::Http::RequestHeaderMap&,
+                        const StreamInfo::StreamInfo& info) const {
+  return range_.isInRange(*address(type_, connection, info));
+}
+
+bool IPSetMatcher::matches(const Network::Connection& connection,
+                           const Envoy::Http::RequestHeaderMap&,
+                           const StreamInfo::StreamInfo& info) const {
+  const auto& ip = IPMatcher::address(type_, connection, info);
+  if (ip->type() != Envoy::Network::Address::Type::Ip) {
+    return false;
   }
-  return range_.isInRange(*ip.get());
+  return !trie_.getData(ip).empty();
 }
 
 bool PortMatcher::matches(const Network::Connection&, const Envoy::Http::RequestHeaderMap&,
@@ -230,6 +416,28 @@ bool AuthenticatedMatcher::matches(const Network::Connection& connection,
   return matcher_.value().match(ssl->subjectPeerCertificate());
 }
 
+bool AuthenticatedSetMatcher::matches(const Network::Connection& connection,
+                                      const Envoy::Http::RequestHeaderMap&,
+                                      const StreamInfo::StreamInfo&) const {
+  const auto& ssl = connection.ssl();
+  if (!ssl) { // connection was not authenticated
+    return false;
+  }
+
+  // Same order as AuthenticatedMatcher: URI SANs, DNS SANs, then the subject.
+  for (const std::string& uri : ssl->uriSanPeerCertificate()) {
+    if (principal_names_.contains(uri)) {
+      return true;
+    }
+  }
+  for (const std::string& dns : ssl->dnsSansPeerCertificate()) {
+    if (principal_names_.contains(dns)) {
+      return true;
+    }
+  }
+  return principal_names_.contains(ssl->subjectPeerCertificate());
+}
+
 bool MetadataMatcher::matches(const Network::Connection&, const Envoy::Http::RequestHeaderMap&,
                               const StreamInfo::StreamInfo& info) const {
   return matcher_.match(info.dynamicMetadata());
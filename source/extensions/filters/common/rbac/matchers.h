@@ -13,8 +13,11 @@
 #include "source/common/common/matchers.h"
 #include "source/common/http/header_utility.h"
 #include "source/common/network/cidr_range.h"
+#include "source/common/network/lc_trie.h"
 #include "source/extensions/filters/common/expr/evaluator.h"
 
+#include "absl/container/flat_hash_set.h"
+
 namespace Envoy {
 namespace Extensions {
 namespace Filters {
@@ -88,6 +91,11 @@ private:
 /**
  * A composite matcher where only one sub-matcher must match for this to return true. Evaluation
  * short-circuits on the first match.
+ *
+ * Large sets of rules are compiled when the matcher is created: the IP rules of the same kind are
+ * merged into an IPSetMatcher, the exact header matches of the same header into a
+ * HeaderValueSetMatcher and the exact principal names into an AuthenticatedSetMatcher, and repeated
+ * rules are dropped. This does not change the result of the matcher.
  */
 class OrMatcher : public Matcher {
 public:
@@ -136,6 +144,24 @@ private:
   const Envoy::Http::HeaderUtility::HeaderData header_;
 };
 
+/**
+ * Matches if the value of an HTTP header is exactly one of a set of values. Multiple values of the
+ * header are concatenated with ',', as for HeaderMatcher. Will always fail to match on any non-HTTP
+ * connection.
+ */
+class HeaderValueSetMatcher : public Matcher {
+public:
+  HeaderValueSetMatcher(const std::string& name, absl::flat_hash_set<std::string> values)
+      : name_(name), values_(std::move(values)) {}
+
+  bool matches(const Network::Connection& connection, const Envoy::Http::RequestHeaderMap& headers,
+               const StreamInfo::StreamInfo&) const override;
+
+private:
+  const Envoy::Http::LowerCaseString name_;
+  const absl::flat_hash_set<std::string> values_;
+};
+
 /**
  * Perform a match against an IP CIDR range. This rule can be applied to connection remote,
  * downstream local address, downstream direct remote address or downstream remote address.
@@ -145,16 +171,39 @@ public:
   enum Type { ConnectionRemote = 0, DownstreamLocal, DownstreamDirectRemote, DownstreamRemote };
 
   IPMatcher(const envoy::config::core::v3::CidrRange& range, Type type)
-      : range_(Network::Address::CidrRange::create(range)), type_(type) {}
+      : IPMatcher(Network::Address::CidrRange::create(range), type) {}
+  IPMatcher(const Network::Address::CidrRange& range, Type type) : range_(range), type_(type) {}
 
   bool matches(const Network::Connection& connection, const Envoy::Http::RequestHeaderMap& headers,
                const StreamInfo::StreamInfo& info) const override;
 
+  /**
+   * @return the address of the given type, which may be nullptr.
+   */
+  static const Network::Address::InstanceConstSharedPtr&
+  address(Type type, const Network::Connection& connection, const StreamInfo::StreamInfo& info);
+
 private:
   const Network::Address::CidrRange range_;
   const Type type_;
 };
 
+/**
+ * Perform a match against many IP CIDR ranges at once, with a lookup in an LC-Trie.
+ */
+class IPSetMatcher : public Matcher {
+public:
+  IPSetMatcher(const std::vector<Network::Address::CidrRange>& ranges, IPMatcher::Type type)
+      : trie_({{true, ranges}}), type_(type) {}
+
+  bool matches(const Network::Connection& connection, const Envoy::Http::RequestHeaderMap& headers,
+               const StreamInfo::StreamInfo& info) const override;
+
+private:
+  const Network::LcTrie::LcTrie<bool> trie_;
+  const IPMatcher::Type type_;
+};
+
 /**
  * Matches the port number of the destination (local) address.
  */
@@ -202,6 +251,21 @@ private:
       matcher_;
 };
 
+/**
+ * Matches if the principal name, as used by AuthenticatedMatcher, is exactly one of a set of names.
+ */
+class AuthenticatedSetMatcher : public Matcher {
+public:
+  AuthenticatedSetMatcher(absl::flat_hash_set<std::string> principal_names)
+      : principal_names_(std::move(principal_names)) {}
+
+  bool matches(const Network::Connection& connection, const Envoy::Http::RequestHeaderMap& headers,
+               const StreamInfo::StreamInfo&) const override;
+
+private:
+  const absl::flat_hash_set<std::string> principal_names_;
+};
+
 /**
  * Matches a Policy which is a collection of permission and principal matchers. If any action
  * matches a permission, the principals are then checked for a match.
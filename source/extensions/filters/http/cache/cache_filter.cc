@@ -33,12 +33,15 @@ using CacheResponseCodeDetails = ConstSingleton<CacheResponseCodeDetailValues>;
 
 CacheFilter::CacheFilter(const envoy::extensions::filters::http::cache::v3::CacheConfig& config,
                          const std::string&, Stats::Scope&, TimeSource& time_source,
-                         std::shared_ptr<HttpCache> http_cache)
+                         std::shared_ptr<HttpCache> http_cache,
+                         RequestCoalescerSharedPtr request_coalescer)
     : time_source_(time_source), cache_(http_cache),
+      request_coalescer_(std::move(request_coalescer)),
       vary_allow_list_(config.allowed_vary_headers()) {}
 
 void CacheFilter::onDestroy() {
   filter_state_ = FilterState::Destroyed;
+  coalescing_timer_.reset();
   if (lookup_ != nullptr) {
     lookup_->onDestroy();
   }
@@ -53,6 +56,10 @@ void CacheFilter::onDestroy() {
     insert_queue_->setSelfOwned(std::move(insert_queue_));
     insert_queue_.reset();
   }
+  // Wake any requests waiting on this one to fill the cache. With a cache that completes inserts
+  // synchronously the entry is in place by now; otherwise a waiter which still misses will go
+  // upstream itself.
+  fill_.reset();
 }
 
 void CacheFilter::onStreamComplete() {
@@ -91,6 +98,9 @@ Http::FilterHeadersStatus CacheFilter::decodeHeaders(Http::RequestHeaderMap& hea
   LookupRequest lookup_request(headers, time_source_.systemTime(), vary_allow_list_);
   request_allows_inserts_ = !lookup_request.requestCacheControl().no_store_;
   is_head_request_ = headers.getMethodValue() == Http::Headers::get().MethodValues.Head;
+  if (request_coalescer_ != nullptr) {
+    key_ = lookup_request.key();
+  }
   lookup_ = cache_->makeLookupContext(std::move(lookup_request), *decoder_callbacks_);
 
   ASSERT(lookup_);
@@ -114,6 +124,14 @@ Http::FilterHeadersStatus CacheFilter::encodeHeaders(Http::ResponseHeaderMap& he
     return Http::FilterHeadersStatus::Continue;
   }
 
+  if (waiting_for_fill_) {
+    // A local reply was generated while waiting on another request's fill.
+    waiting_for_fill_ = false;
+    coalescing_timer_.reset();
+    filter_state_ = FilterState::NotServingFromCache;
+    return Http::FilterHeadersStatus::Continue;
+  }
+
   if (lookup_result_ == nullptr) {
     // Filter chain iteration is paused while a lookup is outstanding, but the filter chain manager
     // can still generate a local reply. One case where this can happen is when a downstream idle
@@ -153,10 +171,13 @@ Http::FilterHeadersStatus CacheFilter::encodeHeaders(Http::ResponseHeaderMap& he
                                              [this]() {
                                                insert_queue_ = nullptr;
                                                insert_status_ = InsertStatus::InsertAbortedByCache;
+                                               fill_.reset();
                                              });
       // Add metadata associated with the cached response. Right now this is only response_time;
       const ResponseMetadata metadata = {time_source_.systemTime()};
       insert_queue_->insertHeaders(headers, metadata, end_stream);
+    } else {
+      fill_.reset();
     }
     if (end_stream) {
       insert_status_ = InsertStatus::InsertSucceeded;
@@ -165,6 +186,9 @@ Http::FilterHeadersStatus CacheFilter::encodeHeaders(Http::ResponseHeaderMap& he
     // insertion yet.
   } else {
     insert_status_ = InsertStatus::NoInsertResponseNotCacheable;
+    // Requests waiting on this one will not find the response in the cache, so let them go
+    // upstream now.
+    fill_.reset();
   }
   filter_state_ = FilterState::NotServingFromCache;
   return Http::FilterHeadersStatus::Continue;
@@ -381,6 +405,9 @@ void CacheFilter::onHeaders(LookupResult&& result, Http::RequestHeaderMap& reque
   case CacheEntryStatus::FoundNotModified:
     PANIC("unsupported code");
   case CacheEntryStatus::RequiresValidation:
+    if (waitForInFlightFill(request_headers)) {
+      return;
+    }
     // If a cache entry requires validation, inject validation headers in the
     // request and let it pass through as if no cache entry was found. If the
     // cache entry was valid, the response status should be 304 (unmodified)
@@ -395,6 +422,9 @@ void CacheFilter::onHeaders(LookupResult&& result, Http::RequestHeaderMap& reque
     handleCacheHit();
     return;
   case CacheEntryStatus::Unusable:
+    if (waitForInFlightFill(request_headers)) {
+      return;
+    }
     decoder_callbacks_->continueDecoding();
     return;
   case CacheEntryStatus::LookupError:
@@ -409,6 +439,68 @@ void CacheFilter::onHeaders(LookupResult&& result, Http::RequestHeaderMap& reque
   decoder_callbacks_->continueDecoding();
 }
 
+bool CacheFilter::waitForInFlightFill(Http::RequestHeaderMap& request_headers) {
+  if (request_coalescer_ == nullptr || coalesced_ || !request_allows_inserts_ ||
+      is_head_request_) {
+    return false;
+  }
+  coalesced_ = true;
+
+  // As in getHeaders, the fill may finish on another worker after this filter is destroyed, so the
+  // filter is only reached through a weak_ptr from a callback posted to its own dispatcher.
+  CacheFilterWeakPtr self = weak_from_this();
+  fill_ = request_coalescer_->startFillOrWait(
+      key_, [self, &request_headers, &dispatcher = decoder_callbacks_->dispatcher()]() {
+        dispatcher.post([self, &request_headers]() {
+          if (CacheFilterSharedPtr cache_filter = self.lock()) {
+            cache_filter->onFillDone(request_headers);
+          }
+        });
+      });
+  if (fill_ != nullptr) {
+    return false;
+  }
+
+  ENVOY_STREAM_LOG(debug, "CacheFilter waiting on an in-flight fill of the same key",
+                   *decoder_callbacks_);
+  waiting_for_fill_ = true;
+  coalescing_timer_ = decoder_callbacks_->dispatcher().createTimer(
+      [this, &request_headers]() { onCoalescingTimeout(request_headers); });
+  coalescing_timer_->enableTimer(request_coalescer_->timeout());
+  return true;
+}
+
+void CacheFilter::onFillDone(Http::RequestHeaderMap& request_headers) {
+  if (!waiting_for_fill_ || filter_state_ != FilterState::Initial) {
+    // The wait timed out, or the stream ended, before the fill finished.
+    return;
+  }
+  waiting_for_fill_ = false;
+  coalescing_timer_.reset();
+
+  ENVOY_STREAM_LOG(debug, "CacheFilter in-flight fill done, repeating lookup", *decoder_callbacks_);
+  lookup_->onDestroy();
+  lookup_result_.reset();
+  lookup_ = cache_->makeLookupContext(
+      LookupRequest(request_headers, time_source_.systemTime(), vary_allow_list_),
+      *decoder_callbacks_);
+  getHeaders(request_headers);
+}
+
+void CacheFilter::onCoalescingTimeout(Http::RequestHeaderMap& request_headers) {
+  ASSERT(waiting_for_fill_);
+  waiting_for_fill_ = false;
+  request_coalescer_->stats().coalesced_request_timeouts_.inc();
+
+  ENVOY_STREAM_LOG(debug, "CacheFilter timed out waiting on an in-flight fill",
+                   *decoder_callbacks_);
+  if (lookup_result_->cache_entry_status_ == CacheEntryStatus::RequiresValidation) {
+    handleCacheHitWithValidation(request_headers);
+  } else {
+    decoder_callbacks_->continueDecoding();
+  }
+}
+
 // TODO(toddmgreer): Handle downstream backpressure.
 void CacheFilter::onBody(Buffer::InstancePtr&& body) {
   // Can be called during decoding if a valid cache hit is found,
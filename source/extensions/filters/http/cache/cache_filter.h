@@ -5,6 +5,7 @@
 #include <string>
 #include <vector>
 
+#include "envoy/event/timer.h"
 #include "envoy/extensions/filters/http/cache/v3/cache.pb.h"
 
 #include "source/common/common/logger.h"
@@ -12,6 +13,7 @@
 #include "source/extensions/filters/http/cache/cache_headers_utils.h"
 #include "source/extensions/filters/http/cache/cache_insert_queue.h"
 #include "source/extensions/filters/http/cache/http_cache.h"
+#include "source/extensions/filters/http/cache/request_coalescer.h"
 #include "source/extensions/filters/http/common/pass_through_filter.h"
 
 namespace Envoy {
@@ -55,7 +57,8 @@ class CacheFilter : public Http::PassThroughFilter,
 public:
   CacheFilter(const envoy::extensions::filters::http::cache::v3::CacheConfig& config,
               const std::string& stats_prefix, Stats::Scope& scope, TimeSource& time_source,
-              std::shared_ptr<HttpCache> http_cache);
+              std::shared_ptr<HttpCache> http_cache,
+              RequestCoalescerSharedPtr request_coalescer);
   // Http::StreamFilterBase
   void onDestroy() override;
   void onStreamComplete() override;
@@ -85,6 +88,18 @@ private:
   // Set required state in the CacheFilter for handling a cache hit.
   void handleCacheHit();
 
+  // Called on a cache miss, or a hit requiring validation, when request coalescing is enabled.
+  // Returns true if another request is already filling the cache for this key, in which case
+  // decoding stays paused until that fill finishes or the coalescing timeout fires. Otherwise this
+  // request becomes the one filling the cache for the key, and false is returned.
+  bool waitForInFlightFill(Http::RequestHeaderMap& request_headers);
+
+  // Looks the request up again once the fill it was waiting on has finished.
+  void onFillDone(Http::RequestHeaderMap& request_headers);
+
+  // Gives up waiting on an in-flight fill and handles the original lookup result.
+  void onCoalescingTimeout(Http::RequestHeaderMap& request_headers);
+
   // Set up the required state in the CacheFilter for handling a range
   // request.
   void handleCacheHitWithRangeRequest();
@@ -136,6 +151,15 @@ private:
   LookupContextPtr lookup_;
   LookupResultPtr lookup_result_;
 
+  // Set when concurrent misses for the same key should be coalesced.
+  const RequestCoalescerSharedPtr request_coalescer_;
+  // The key of the request, kept for request coalescing.
+  Key key_;
+  // Held while this request is filling the cache for key_ on behalf of any coalesced requests.
+  RequestCoalescer::FillPtr fill_;
+  // Bounds the time spent waiting on another request's fill.
+  Event::TimerPtr coalescing_timer_;
+
   // Tracks what body bytes still need to be read from the cache. This is
   // currently only one Range, but will expand when full range support is added. Initialized by
   // onHeaders for Range Responses, otherwise initialized by encodeCachedResponse.
@@ -158,6 +182,11 @@ private:
   FilterState filter_state_ = FilterState::Initial;
 
   bool is_head_request_ = false;
+  // True once the request has either waited on, or started, a fill; a request is coalesced at most
+  // once.
+  bool coalesced_ = false;
+  // True while decoding is paused waiting on another request's fill.
+  bool waiting_for_fill_ = false;
   // The status of the insert operation or header update, or decision not to insert or update.
   // If it's too early to determine the final status, this is empty.
   absl::optional<InsertStatus> insert_status_;
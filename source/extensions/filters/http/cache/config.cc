@@ -26,10 +26,21 @@ Http::FilterFactoryCb CacheFilterFactory::createFilterFactoryFromProtoTyped(
     cache = http_cache_factory->getCache(config, context);
   }
 
-  return [config, stats_prefix, &context,
-          cache](Http::FilterChainFactoryCallbacks& callbacks) -> void {
+  // Shared by the filters on all workers, so that misses for the same key are coalesced across
+  // workers.
+  RequestCoalescerSharedPtr request_coalescer;
+  const uint64_t request_coalescing_timeout_ms =
+      PROTOBUF_GET_MS_OR_DEFAULT(config, request_coalescing_timeout, 0);
+  if (cache != nullptr && request_coalescing_timeout_ms > 0) {
+    request_coalescer = std::make_shared<RequestCoalescer>(
+        std::chrono::milliseconds(request_coalescing_timeout_ms), context.scope(), stats_prefix);
+  }
+
+  return [config, stats_prefix, &context, cache,
+          request_coalescer](Http::FilterChainFactoryCallbacks& callbacks) -> void {
     callbacks.addStreamFilter(std::make_shared<CacheFilter>(
-        config, stats_prefix, context.scope(), context.serverFactoryContext().timeSource(), cache));
+        config, stats_prefix, context.scope(), context.serverFactoryContext().timeSource(), cache,
+        request_coalescer));
   };
 }
 
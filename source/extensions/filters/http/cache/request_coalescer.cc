@@ -0,0 +1,51 @@
+#include "source/extensions/filters/http/cache/request_coalescer.h"
+
+#include "source/common/common/assert.h"
+
+#include "absl/strings/str_cat.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace Cache {
+
+RequestCoalescer::Fill::~Fill() { coalescer_->finishFill(key_); }
+
+RequestCoalescer::RequestCoalescer(std::chrono::milliseconds timeout, Stats::Scope& scope,
+                                   const std::string& stats_prefix)
+    : timeout_(timeout), stats_{ALL_REQUEST_COALESCING_STATS(
+                             POOL_COUNTER_PREFIX(scope, absl::StrCat(stats_prefix, "cache.")))} {}
+
+RequestCoalescer::FillPtr RequestCoalescer::startFillOrWait(const Key& key,
+                                                            FillDoneCallback on_fill_done) {
+  {
+    absl::MutexLock lock(&mutex_);
+    auto [it, inserted] = fills_.try_emplace(key);
+    if (!inserted) {
+      it->second.push_back(std::move(on_fill_done));
+      stats_.coalesced_requests_.inc();
+      return nullptr;
+    }
+  }
+  return std::make_unique<Fill>(shared_from_this(), key);
+}
+
+void RequestCoalescer::finishFill(const Key& key) {
+  std::vector<FillDoneCallback> waiters;
+  {
+    absl::MutexLock lock(&mutex_);
+    auto it = fills_.find(key);
+    ASSERT(it != fills_.end());
+    waiters = std::move(it->second);
+    fills_.erase(it);
+  }
+  // Called without the lock held, so that a waiter can start a new fill from its callback.
+  for (const FillDoneCallback& on_fill_done : waiters) {
+    on_fill_done();
+  }
+}
+
+} // namespace Cache
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "envoy/stats/scope.h"
+#include "envoy/stats/stats_macros.h"
+
+#include "source/common/protobuf/utility.h"
+#include "source/extensions/filters/http/cache/key.pb.h"
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/synchronization/mutex.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace Cache {
+
+/**
+ * All request coalescing stats. @see stats_macros.h
+ */
+#define ALL_REQUEST_COALESCING_STATS(COUNTER)                                                      \
+  COUNTER(coalesced_requests)                                                                      \
+  COUNTER(coalesced_request_timeouts)
+
+/**
+ * Struct definition for request coalescing stats. @see stats_macros.h
+ */
+struct RequestCoalescingStats {
+  ALL_REQUEST_COALESCING_STATS(GENERATE_COUNTER_STRUCT)
+};
+
+// Tracks the cache keys that are currently being fetched from upstream to fill the cache, so that
+// concurrent misses for the same key can wait for that fill and then be served from the cache,
+// rather than all being sent upstream. A single RequestCoalescer is shared by every worker using a
+// filter config, so it is thread-safe.
+class RequestCoalescer : public std::enable_shared_from_this<RequestCoalescer> {
+public:
+  // Called once the fill that a request is waiting on has finished, whether or not it succeeded.
+  // It may be called on any thread.
+  using FillDoneCallback = std::function<void()>;
+
+  // Held by the request that is filling the cache for a key. Destroying it finishes the fill and
+  // notifies every request waiting on it.
+  class Fill {
+  public:
+    Fill(std::shared_ptr<RequestCoalescer> coalescer, const Key& key)
+        : coalescer_(std::move(coalescer)), key_(key) {}
+    ~Fill();
+
+  private:
+    const std::shared_ptr<RequestCoalescer> coalescer_;
+    const Key key_;
+  };
+  using FillPtr = std::unique_ptr<Fill>;
+
+  RequestCoalescer(std::chrono::milliseconds timeout, Stats::Scope& scope,
+                   const std::string& stats_prefix);
+
+  /**
+   * Starts a fill for key if there isn't one in flight already.
+   * @param key supplies the cache key of the request.
+   * @param on_fill_done supplies the callback to call when the in-flight fill finishes, if there
+   *        is one.
+   * @return FillPtr the new fill, which the caller should complete by fetching the response from
+   *         upstream and inserting it into the cache; or nullptr if another request is already
+   *         filling key, in which case on_fill_done will be called once it is done.
+   */
+  FillPtr startFillOrWait(const Key& key, FillDoneCallback on_fill_done);
+
+  // How long a request waits on an in-flight fill before going upstream itself.
+  std::chrono::milliseconds timeout() const { return timeout_; }
+  RequestCoalescingStats& stats() { return stats_; }
+
+private:
+  void finishFill(const Key& key);
+
+  const std::chrono::milliseconds timeout_;
+  RequestCoalescingStats stats_;
+  absl::Mutex mutex_;
+  // The callbacks of the requests waiting on each key that is being filled.
+  absl::flat_hash_map<Key, std::vector<FillDoneCallback>, MessageUtil, MessageUtil>
+      fills_ ABSL_GUARDED_BY(mutex_);
+};
+
+using RequestCoalescerSharedPtr = std::shared_ptr<RequestCoalescer>;
+
+} // namespace Cache
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
@@ -1,8 +1,13 @@
 #include "source/extensions/filters/http/compressor/compressor_filter.h"
 
 #include "source/common/buffer/buffer_impl.h"
+#include "source/common/common/enum_to_int.h"
 #include "source/common/http/header_map_impl.h"
 #include "source/common/http/utility.h"
+#include "source/common/protobuf/utility.h"
+
+#include "absl/strings/match.h"
+#include "absl/strings/str_cat.h"
 
 namespace Envoy {
 namespace Extensions {
@@ -30,6 +35,10 @@ Http::RegisterCustomInlineHeader<Http::CustomInlineHeaderRegistry::Type::Respons
 // Default minimum length of an upstream response that allows compression.
 const uint64_t DefaultMinimumContentLength = 30;
 
+// Defaults of the compressed response cache.
+const uint32_t DefaultCompressedResponseCacheMaxEntries = 1024;
+const uint32_t DefaultCompressedResponseCacheMaxBodyBytes = 65536;
+
 // Default content types will be used if any is provided by the user.
 const std::vector<std::string>& defaultContentEncoding() {
   CONSTRUCT_ON_FIRST_USE(std::vector<std::string>, {"text/html",
@@ -73,6 +82,41 @@ void compressAndUpdateStats(const Compression::Compressor::CompressorPtr& compre
 
 } // namespace
 
+CompressedResponseCache::CompressedResponseCache(
+    const envoy::extensions::filters::http::compressor::v3::Compressor::CompressedResponseCache&
+        proto_config)
+    : max_entries_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(proto_config, max_entries,
+                                                   DefaultCompressedResponseCacheMaxEntries)),
+      max_body_bytes_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(proto_config, max_body_bytes,
+                                                      DefaultCompressedResponseCacheMaxBodyBytes)) {
+}
+
+CompressedResponseCache::BodySharedPtr CompressedResponseCache::lookup(const std::string& key) {
+  absl::MutexLock lock(&mutex_);
+  auto it = entries_.find(key);
+  if (it == entries_.end()) {
+    return nullptr;
+  }
+  lru_.splice(lru_.end(), lru_, it->second.lru_entry_);
+  return it->second.body_;
+}
+
+void CompressedResponseCache::insert(const std::string& key, BodySharedPtr body) {
+  absl::MutexLock lock(&mutex_);
+  auto it = entries_.find(key);
+  if (it != entries_.end()) {
+    lru_.splice(lru_.end(), lru_, it->second.lru_entry_);
+    it->second.body_ = std::move(body);
+    return;
+  }
+  if (entries_.size() >= max_entries_) {
+    entries_.erase(lru_.front());
+    lru_.pop_front();
+  }
+  lru_.push_back(key);
+  entries_.emplace(key, Entry{std::move(body), std::prev(lru_.end())});
+}
+
 CompressorFilterConfig::DirectionConfig::DirectionConfig(
     const envoy::extensions::filters::http::compressor::v3::Compressor::CommonDirectionConfig&
         proto_config,
@@ -130,7 +174,12 @@ CompressorFilterConfig::ResponseDirectionConfig::ResponseDirectionConfig(
           proto_config.has_response_direction_config()
               ? proto_config.response_direction_config().remove_accept_encoding_header()
               : proto_config.remove_accept_encoding_header()),
-      response_stats_{generateResponseStats(stats_prefix, scope)} {}
+      response_stats_{generateResponseStats(stats_prefix, scope)},
+      compressed_response_cache_(
+          proto_config.response_direction_config().has_compressed_response_cache()
+              ? std::make_unique<CompressedResponseCache>(
+                    proto_config.response_direction_config().compressed_response_cache())
+              : nullptr) {}
 
 const envoy::extensions::filters::http::compressor::v3::Compressor::CommonDirectionConfig
 CompressorFilterConfig::ResponseDirectionConfig::commonConfig(
@@ -209,6 +258,13 @@ Http::FilterHeadersStatus CompressorFilter::decodeHeaders(Http::RequestHeaderMap
       removeAcceptEncodingHeader(response_config, per_route_config)) {
     headers.removeInline(accept_encoding_handle.handle());
   }
+  // Only the full responses to GET requests are cached. A response to a range request has the
+  // same ETag as the full response, but a different body.
+  if (response_config.compressedResponseCache() != nullptr &&
+      headers.getMethodValue() == Http::Headers::get().MethodValues.Get &&
+      headers.get(Http::Headers::get().Range).empty()) {
+    resource_ = absl::StrCat(headers.getHostValue(), headers.getPathValue());
+  }
 
   const auto& request_config = config_->requestDirectionConfig();
 
@@ -288,12 +344,16 @@ Http::FilterHeadersStatus CompressorFilter::encodeHeaders(Http::ResponseHeaderMa
       isEtagAllowed(headers) && !headers.getInline(response_content_encoding_handle.handle());
   if (!end_stream && isAcceptEncodingAllowed(isEnabledAndContentLengthBigEnough, headers) &&
       isCompressible && isTransferEncodingAllowed(headers)) {
+    // The ETag header may be removed below.
+    lookupCompressedResponse(headers);
     sanitizeEtagHeader(headers);
     headers.removeContentLength();
     headers.setInline(response_content_encoding_handle.handle(), config_->contentEncoding());
     config.stats().compressed_.inc();
-    // Finally instantiate the compressor.
-    response_compressor_ = config_->makeCompressor();
+    // Finally instantiate the compressor, unless the response is served from the cache.
+    if (cached_response_ == nullptr) {
+      response_compressor_ = config_->makeCompressor();
+    }
   } else {
     config.stats().not_compressed_.inc();
   }
@@ -309,26 +369,102 @@ Http::FilterHeadersStatus CompressorFilter::encodeHeaders(Http::ResponseHeaderMa
 }
 
 Http::FilterDataStatus CompressorFilter::encodeData(Buffer::Instance& data, bool end_stream) {
-  if (response_compressor_ != nullptr) {
+  if (cached_response_ != nullptr) {
+    config_->responseDirectionConfig().stats().total_uncompressed_bytes_.add(data.length());
+    data.drain(data.length());
+    if (end_stream) {
+      addCachedResponse(data);
+    }
+  } else if (response_compressor_ != nullptr) {
     compressAndUpdateStats(response_compressor_, config_->responseDirectionConfig().stats(), data,
                            end_stream);
+    onCompressedResponseData(data, end_stream);
   }
   return Http::FilterDataStatus::Continue;
 }
 
 Http::FilterTrailersStatus CompressorFilter::encodeTrailers(Http::ResponseTrailerMap&) {
-  if (response_compressor_ != nullptr) {
+  if (cached_response_ != nullptr) {
+    Buffer::OwnedImpl cached_buffer;
+    addCachedResponse(cached_buffer);
+    encoder_callbacks_->addEncodedData(cached_buffer, true);
+  } else if (response_compressor_ != nullptr) {
     Buffer::OwnedImpl empty_buffer;
     // The presence of trailers means the stream is ended, but encodeData()
     // is never called with end_stream=true, thus let the compression library know
     // that the stream is ended.
     compressAndUpdateStats(response_compressor_, config_->responseDirectionConfig().stats(),
                            empty_buffer, true);
+    onCompressedResponseData(empty_buffer, true);
     encoder_callbacks_->addEncodedData(empty_buffer, true);
   }
   return Http::FilterTrailersStatus::Continue;
 }
 
+void CompressorFilter::lookupCompressedResponse(const Http::ResponseHeaderMap& headers) {
+  CompressedResponseCache* cache = config_->responseDirectionConfig().compressedResponseCache();
+  const Http::HeaderEntry* etag = headers.getInline(etag_handle.handle());
+  if (cache == nullptr || etag == nullptr || resource_.empty() ||
+      Http::Utility::getResponseStatus(headers) != enumToInt(Http::Code::OK) ||
+      !isVaryOnlyOnAcceptEncoding(headers)) {
+    return;
+  }
+  // Only a strong ETag guarantees that the responses have the same body.
+  const absl::string_view etag_value = etag->value().getStringView();
+  if (etag_value.empty() || absl::StartsWithIgnoreCase(etag_value, "w/")) {
+    return;
+  }
+
+  std::string key = absl::StrCat(resource_, "\n", etag_value);
+  cached_response_ = cache->lookup(key);
+  if (cached_response_ != nullptr) {
+    config_->responseDirectionConfig().responseStats().cache_hit_.inc();
+  } else {
+    config_->responseDirectionConfig().responseStats().cache_miss_.inc();
+    response_cache_key_ = std::move(key);
+  }
+}
+
+void CompressorFilter::onCompressedResponseData(Buffer::Instance& data, bool end_stream) {
+  if (response_cache_key_.empty()) {
+    return;
+  }
+  CompressedResponseCache& cache = *config_->responseDirectionConfig().compressedResponseCache();
+  if (compressed_response_.size() + data.length() > cache.maxBodyBytes()) {
+    response_cache_key_.clear();
+    std::string().swap(compressed_response_);
+    return;
+  }
+  for (const Buffer::RawSlice& slice : data.getRawSlices()) {
+    compressed_response_.append(static_cast<const char*>(slice.mem_), slice.len_);
+  }
+  if (end_stream) {
+    cache.insert(response_cache_key_,
+                 std::make_shared<const std::string>(std::move(compressed_response_)));
+    response_cache_key_.clear();
+  }
+}
+
+bool CompressorFilter::isVaryOnlyOnAcceptEncoding(const Http::ResponseHeaderMap& headers) const {
+  // The body of a response that varies on other request headers is not identified by its ETag.
+  const Http::HeaderEntry* vary = headers.getInline(vary_handle.handle());
+  if (vary == nullptr) {
+    return true;
+  }
+  for (absl::string_view token : StringUtil::splitToken(vary->value().getStringView(), ",")) {
+    if (!absl::EqualsIgnoreCase(StringUtil::trim(token),
+                                Http::CustomHeaders::get().VaryValues.AcceptEncoding)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void CompressorFilter::addCachedResponse(Buffer::Instance& data) {
+  data.add(*cached_response_);
+  config_->responseDirectionConfig().stats().total_compressed_bytes_.add(cached_response_->size());
+}
+
 bool CompressorFilter::hasCacheControlNoTransform(Http::ResponseHeaderMap& headers) const {
   const Http::HeaderEntry* cache_control = headers.getInline(cache_control_handle.handle());
   if (cache_control) {
@@ -1,5 +1,9 @@
 #pragma once
 
+#include <list>
+#include <memory>
+#include <string>
+
 #include "envoy/compression/compressor/factory.h"
 #include "envoy/extensions/filters/http/compressor/v3/compressor.pb.h"
 #include "envoy/stats/stats_macros.h"
@@ -8,6 +12,8 @@
 #include "source/common/runtime/runtime_protos.h"
 #include "source/extensions/filters/http/common/pass_through_filter.h"
 
+#include "absl/container/flat_hash_map.h"
+#include "absl/synchronization/mutex.h"
 #include "absl/types/optional.h"
 
 namespace Envoy {
@@ -39,6 +45,9 @@ namespace Compressor {
  *
  * "header_gzip" is specific to the gzip filter and is deprecated since it duplicates
  * "header_compressor_used".
+ *
+ * "cache_hit" and "cache_miss" count the compressed responses which could be cached, by whether
+ * they were served from the compressed response cache.
  */
 #define RESPONSE_COMPRESSOR_STATS(COUNTER)                                                         \
   COUNTER(no_accept_header)                                                                        \
@@ -47,7 +56,9 @@ namespace Compressor {
   COUNTER(header_compressor_overshadowed)                                                          \
   COUNTER(header_wildcard)                                                                         \
   COUNTER(header_not_valid)                                                                        \
-  COUNTER(not_compressed_etag)
+  COUNTER(not_compressed_etag)                                                                     \
+  COUNTER(cache_hit)                                                                               \
+  COUNTER(cache_miss)
 
 /**
  * Struct definitions for compressor stats. @see stats_macros.h
@@ -59,6 +70,44 @@ struct ResponseCompressorStats {
   RESPONSE_COMPRESSOR_STATS(GENERATE_COUNTER_STRUCT)
 };
 
+/**
+ * A cache of compressed response bodies, shared by the workers, which evicts the least recently
+ * used body once it is full.
+ */
+class CompressedResponseCache {
+public:
+  CompressedResponseCache(
+      const envoy::extensions::filters::http::compressor::v3::Compressor::CompressedResponseCache&
+          proto_config);
+
+  using BodySharedPtr = std::shared_ptr<const std::string>;
+
+  /**
+   * @return the cached body for the key, or nullptr if there is none.
+   */
+  BodySharedPtr lookup(const std::string& key);
+
+  /**
+   * Caches a body, replacing the body cached for the key if any.
+   */
+  void insert(const std::string& key, BodySharedPtr body);
+
+  uint32_t maxBodyBytes() const { return max_body_bytes_; }
+
+private:
+  struct Entry {
+    BodySharedPtr body_;
+    std::list<std::string>::iterator lru_entry_;
+  };
+
+  const uint32_t max_entries_;
+  const uint32_t max_body_bytes_;
+  absl::Mutex mutex_;
+  absl::flat_hash_map<std::string, Entry> entries_ ABSL_GUARDED_BY(mutex_);
+  // Keys from the least to the most recently used.
+  std::list<std::string> lru_ ABSL_GUARDED_BY(mutex_);
+};
+
 /**
  * Configuration for the compressor filter.
  */
@@ -121,6 +170,10 @@ public:
     const ResponseCompressorStats& responseStats() const { return response_stats_; }
     bool disableOnEtagHeader() const { return disable_on_etag_header_; }
     bool removeAcceptEncodingHeader() const { return remove_accept_encoding_header_; }
+    // nullptr if compressed responses are not cached.
+    CompressedResponseCache* compressedResponseCache() const {
+      return compressed_response_cache_.get();
+    }
 
   private:
     static ResponseCompressorStats generateResponseStats(const std::string& prefix,
@@ -136,6 +189,7 @@ public:
     const bool disable_on_etag_header_;
     const bool remove_accept_encoding_header_;
     const ResponseCompressorStats response_stats_;
+    const std::unique_ptr<CompressedResponseCache> compressed_response_cache_;
   };
 
   CompressorFilterConfig() = delete;
@@ -209,6 +263,10 @@ private:
 
   void sanitizeEtagHeader(Http::ResponseHeaderMap& headers);
   void insertVaryHeader(Http::ResponseHeaderMap& headers);
+  void lookupCompressedResponse(const Http::ResponseHeaderMap& headers);
+  bool isVaryOnlyOnAcceptEncoding(const Http::ResponseHeaderMap& headers) const;
+  void onCompressedResponseData(Buffer::Instance& data, bool end_stream);
+  void addCachedResponse(Buffer::Instance& data);
 
   class EncodingDecision : public StreamInfo::FilterState::Object {
   public:
@@ -235,6 +293,14 @@ private:
   Envoy::Compression::Compressor::CompressorPtr request_compressor_;
   const CompressorFilterConfigSharedPtr config_;
   std::unique_ptr<std::string> accept_encoding_;
+  // The request's ":authority" and ":path", set only if compressed responses are cached and the
+  // request is a GET without a range.
+  std::string resource_;
+  // The key of the compressed response, while it is cached.
+  std::string response_cache_key_;
+  std::string compressed_response_;
+  // The cached compressed response being served.
+  CompressedResponseCache::BodySharedPtr cached_response_;
 };
 
 } // namespace Compressor
@@ -27,7 +27,7 @@ Http::FilterFactoryCb ExtAuthzFilterConfig::createFilterFactoryFromProtoTyped(
 
   const auto filter_config = std::make_shared<FilterConfig>(
       proto_config, context.scope(), server_context.runtime(), server_context.httpContext(),
-      stats_prefix, server_context.bootstrap());
+      stats_prefix, server_context.bootstrap(), server_context.threadLocal());
   // The callback is created in main thread and executed in worker thread, variables except factory
   // context must be captured by value into the callback.
   Http::FilterFactoryCb callback;
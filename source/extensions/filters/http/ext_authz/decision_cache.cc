@@ -0,0 +1,183 @@
+#include "source/extensions/filters/http/ext_authz/decision_cache.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "source/common/common/utility.h"
+#include "source/common/http/header_utility.h"
+#include "source/common/protobuf/utility.h"
+
+#include "absl/strings/numbers.h"
+#include "absl/strings/str_cat.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace ExtAuthz {
+
+namespace {
+
+constexpr uint32_t DefaultMaxEntries = 10000;
+constexpr uint64_t DefaultTtlMs = 10000;
+// The longest TTL that the authorization server may set.
+constexpr double MaxServerTtlSeconds = 24 * 60 * 60;
+
+// Appends a value to the key, prefixed with its length so that the values can not run into each
+// other. A missing value is told apart from an empty one.
+void appendKeyValue(std::string& key, absl::optional<absl::string_view> value) {
+  if (!value.has_value()) {
+    key.append("-;");
+    return;
+  }
+  absl::StrAppend(&key, value->size(), ":", *value, ";");
+}
+
+} // namespace
+
+DecisionCache::DecisionCache(
+    const envoy::extensions::filters::http::ext_authz::v3::DecisionCache& config,
+    ThreadLocal::SlotAllocator& tls)
+    : ttl_(PROTOBUF_GET_MS_OR_DEFAULT(config, ttl, DefaultTtlMs)),
+      denied_ttl_(PROTOBUF_GET_MS_OR_DEFAULT(config, denied_ttl, 0)),
+      ttl_metadata_field_(config.ttl_metadata_field()) {
+  if (config.key_headers().empty() && config.key_metadata().empty()) {
+    ExceptionUtil::throwEnvoyException(
+        "ext_authz decision cache requires key_headers or key_metadata.");
+  }
+  for (const std::string& header : config.key_headers()) {
+    key_headers_.emplace_back(header);
+  }
+  for (const auto& metadata_key : config.key_metadata()) {
+    key_metadata_.emplace_back(metadata_key);
+  }
+
+  const uint32_t max_entries =
+      PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, max_entries, DefaultMaxEntries);
+  if (config.shared()) {
+    shared_entries_ = std::make_unique<Entries>(max_entries);
+    return;
+  }
+  tls_ = ThreadLocal::TypedSlot<ThreadLocalEntries>::makeUnique(tls);
+  tls_->set([max_entries](Event::Dispatcher&) {
+    return std::make_shared<ThreadLocalEntries>(max_entries);
+  });
+}
+
+std::string DecisionCache::key(const Http::RequestHeaderMap& headers,
+                               const envoy::config::core::v3::Metadata& dynamic_metadata) const {
+  std::string key;
+  for (const Http::LowerCaseString& header : key_headers_) {
+    const auto values = Http::HeaderUtility::getAllOfHeaderAsString(headers, header);
+    appendKeyValue(key, values.result());
+  }
+  for (const Config::MetadataKey& metadata_key : key_metadata_) {
+    const ProtobufWkt::Value& value =
+        Config::Metadata::metadataValue(&dynamic_metadata, metadata_key);
+    switch (value.kind_case()) {
+    case ProtobufWkt::Value::KIND_NOT_SET:
+      appendKeyValue(key, absl::nullopt);
+      break;
+    case ProtobufWkt::Value::kStringValue:
+      appendKeyValue(key, value.string_value());
+      break;
+    default:
+      appendKeyValue(key, MessageUtil::getJsonStringFromMessageOrError(value));
+      break;
+    }
+  }
+  return key;
+}
+
+Filters::Common::ExtAuthz::ResponsePtr DecisionCache::lookup(const std::string& key,
+                                                              MonotonicTime now) {
+  ResponseConstSharedPtr response;
+  if (shared_entries_ != nullptr) {
+    absl::MutexLock lock(&shared_mutex_);
+    response = shared_entries_->lookup(key, now);
+  } else {
+    response = (*tls_)->entries_.lookup(key, now);
+  }
+  // The filter consumes the decision, so it gets a copy, made outside of the lock.
+  return response != nullptr ? std::make_unique<Filters::Common::ExtAuthz::Response>(*response)
+                             : nullptr;
+}
+
+void DecisionCache::insert(const std::string& key,
+                           const Filters::Common::ExtAuthz::Response& response, MonotonicTime now) {
+  if (response.status == Filters::Common::ExtAuthz::CheckStatus::Error) {
+    return;
+  }
+  const std::chrono::milliseconds ttl = decisionTtl(response);
+  if (ttl.count() <= 0) {
+    return;
+  }
+
+  auto cached_response = std::make_shared<const Filters::Common::ExtAuthz::Response>(response);
+  if (shared_entries_ != nullptr) {
+    absl::MutexLock lock(&shared_mutex_);
+    shared_entries_->insert(key, std::move(cached_response), now + ttl);
+  } else {
+    (*tls_)->entries_.insert(key, std::move(cached_response), now + ttl);
+  }
+}
+
+std::chrono::milliseconds
+DecisionCache::decisionTtl(const Filters::Common::ExtAuthz::Response& response) const {
+  if (!ttl_metadata_field_.empty()) {
+    const auto& fields = response.dynamic_metadata.fields();
+    const auto it = fields.find(ttl_metadata_field_);
+    if (it != fields.end()) {
+      double seconds = std::numeric_limits<double>::quiet_NaN();
+      if (it->second.kind_case() == ProtobufWkt::Value::kNumberValue) {
+        seconds = it->second.number_value();
+      } else if (it->second.kind_case() == ProtobufWkt::Value::kStringValue &&
+                 !absl::SimpleAtod(it->second.string_value(), &seconds)) {
+        seconds = std::numeric_limits<double>::quiet_NaN();
+      }
+      // A TTL that is not a finite, non-negative number is ignored, and a long one is capped so
+      // that it converts to milliseconds without overflowing.
+      if (std::isfinite(seconds) && seconds >= 0) {
+        return std::chrono::milliseconds(
+            static_cast<int64_t>(std::min(seconds, MaxServerTtlSeconds) * 1000));
+      }
+    }
+  }
+  return response.status == Filters::Common::ExtAuthz::CheckStatus::OK ? ttl_ : denied_ttl_;
+}
+
+DecisionCache::ResponseConstSharedPtr DecisionCache::Entries::lookup(const std::string& key,
+                                                                     MonotonicTime now) {
+  auto it = entries_.find(key);
+  if (it == entries_.end()) {
+    return nullptr;
+  }
+  if (it->second.expire_at_ <= now) {
+    erase(it);
+    return nullptr;
+  }
+  lru_.splice(lru_.end(), lru_, it->second.lru_entry_);
+  return it->second.response_;
+}
+
+void DecisionCache::Entries::insert(const std::string& key, ResponseConstSharedPtr response,
+                                    MonotonicTime expire_at) {
+  auto it = entries_.find(key);
+  if (it != entries_.end()) {
+    erase(it);
+  } else if (entries_.size() >= max_entries_) {
+    erase(entries_.find(lru_.front()));
+  }
+  lru_.push_back(key);
+  entries_.emplace(key, Entry{std::move(response), expire_at, std::prev(lru_.end())});
+}
+
+void DecisionCache::Entries::erase(absl::flat_hash_map<std::string, Entry>::iterator it) {
+  lru_.erase(it->second.lru_entry_);
+  entries_.erase(it);
+}
+
+} // namespace ExtAuthz
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
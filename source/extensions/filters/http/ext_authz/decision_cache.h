@@ -0,0 +1,108 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "envoy/common/time.h"
+#include "envoy/config/core/v3/base.pb.h"
+#include "envoy/extensions/filters/http/ext_authz/v3/ext_authz.pb.h"
+#include "envoy/http/header_map.h"
+#include "envoy/thread_local/thread_local.h"
+
+#include "source/common/config/metadata.h"
+#include "source/extensions/filters/common/ext_authz/ext_authz.h"
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/synchronization/mutex.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace ExtAuthz {
+
+/**
+ * A cache of the decisions of the authorization server, keyed on the values of the configured
+ * request headers and dynamic metadata. By default each worker has a cache of its own, which is
+ * used without locking; a shared cache is guarded by a lock instead.
+ */
+class DecisionCache {
+public:
+  DecisionCache(const envoy::extensions::filters::http::ext_authz::v3::DecisionCache& config,
+                ThreadLocal::SlotAllocator& tls);
+
+  /**
+   * @return the cache key of a request.
+   */
+  std::string key(const Http::RequestHeaderMap& headers,
+                  const envoy::config::core::v3::Metadata& dynamic_metadata) const;
+
+  /**
+   * @return a copy of the decision cached under the key, or nullptr if there is none or it has
+   *         expired.
+   */
+  Filters::Common::ExtAuthz::ResponsePtr lookup(const std::string& key, MonotonicTime now);
+
+  /**
+   * Caches a decision of the authorization server for its TTL. Errors, and decisions with a TTL of
+   * zero, are not cached.
+   */
+  void insert(const std::string& key, const Filters::Common::ExtAuthz::Response& response,
+              MonotonicTime now);
+
+private:
+  using ResponseConstSharedPtr = std::shared_ptr<const Filters::Common::ExtAuthz::Response>;
+
+  // The least recently used decisions are evicted first.
+  class Entries {
+  public:
+    explicit Entries(uint32_t max_entries) : max_entries_(max_entries) {}
+
+    ResponseConstSharedPtr lookup(const std::string& key, MonotonicTime now);
+    void insert(const std::string& key, ResponseConstSharedPtr response, MonotonicTime expire_at);
+
+  private:
+    struct Entry {
+      ResponseConstSharedPtr response_;
+      MonotonicTime expire_at_;
+      std::list<std::string>::iterator lru_entry_;
+    };
+
+    void erase(absl::flat_hash_map<std::string, Entry>::iterator it);
+
+    const uint32_t max_entries_;
+    absl::flat_hash_map<std::string, Entry> entries_;
+    // Keys from the least to the most recently used decision.
+    std::list<std::string> lru_;
+  };
+
+  struct ThreadLocalEntries : public ThreadLocal::ThreadLocalObject {
+    explicit ThreadLocalEntries(uint32_t max_entries) : entries_(max_entries) {}
+
+    Entries entries_;
+  };
+
+  std::chrono::milliseconds decisionTtl(const Filters::Common::ExtAuthz::Response& response) const;
+
+  std::vector<Http::LowerCaseString> key_headers_;
+  std::vector<Config::MetadataKey> key_metadata_;
+  const std::chrono::milliseconds ttl_;
+  const std::chrono::milliseconds denied_ttl_;
+  const std::string ttl_metadata_field_;
+
+  // Set if the cache is shared by the workers.
+  absl::Mutex shared_mutex_;
+  std::unique_ptr<Entries> shared_entries_ ABSL_PT_GUARDED_BY(shared_mutex_);
+  // Set otherwise.
+  ThreadLocal::TypedSlotPtr<ThreadLocalEntries> tls_;
+};
+
+using DecisionCachePtr = std::unique_ptr<DecisionCache>;
+
+} // namespace ExtAuthz
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
@@ -73,6 +73,10 @@ void Filter::initiateCall(const Http::RequestHeaderMap& headers) {
     return;
   }
 
+  if (lookupCachedDecision(headers)) {
+    return;
+  }
+
   auto&& maybe_merged_per_route_config =
       Http::Utility::getMergedPerFilterConfig<FilterConfigPerRoute>(
           decoder_callbacks_, [](FilterConfigPerRoute& cfg_base, const FilterConfigPerRoute& cfg) {
@@ -267,11 +271,44 @@ void Filter::onDestroy() {
   }
 }
 
+bool Filter::lookupCachedDecision(const Http::RequestHeaderMap& headers) {
+  DecisionCache* decision_cache = config_->decisionCache();
+  if (decision_cache == nullptr) {
+    return false;
+  }
+
+  decision_cache_key_ =
+      decision_cache->key(headers, decoder_callbacks_->streamInfo().dynamicMetadata());
+  Filters::Common::ExtAuthz::ResponsePtr response = decision_cache->lookup(
+      decision_cache_key_, decoder_callbacks_->dispatcher().timeSource().monotonicTime());
+  if (response == nullptr) {
+    stats_.decision_cache_miss_.inc();
+    return false;
+  }
+
+  ENVOY_STREAM_LOG(trace, "ext_authz filter found the decision in the cache", *decoder_callbacks_);
+  stats_.decision_cache_hit_.inc();
+  decision_cache_key_.clear();
+  // The cached decision is applied as if the authorization server had answered synchronously.
+  state_ = State::Calling;
+  filter_return_ = FilterReturn::StopDecoding;
+  cluster_ = decoder_callbacks_->clusterInfo();
+  initiating_call_ = true;
+  onComplete(std::move(response));
+  initiating_call_ = false;
+  return true;
+}
+
 void Filter::onComplete(Filters::Common::ExtAuthz::ResponsePtr&& response) {
   state_ = State::Complete;
   using Filters::Common::ExtAuthz::CheckStatus;
   Stats::StatName empty_stat_name;
 
+  if (!decision_cache_key_.empty()) {
+    config_->decisionCache()->insert(decision_cache_key_, *response,
+                                     decoder_callbacks_->dispatcher().timeSource().monotonicTime());
+  }
+
   if (!response->dynamic_metadata.fields().empty()) {
     // Add duration of call to dynamic metadata if applicable
     if (start_time_.has_value() && response->status == CheckStatus::OK) {
@@ -24,6 +24,7 @@
 #include "source/extensions/filters/common/ext_authz/ext_authz.h"
 #include "source/extensions/filters/common/ext_authz/ext_authz_grpc_impl.h"
 #include "source/extensions/filters/common/ext_authz/ext_authz_http_impl.h"
+#include "source/extensions/filters/http/ext_authz/decision_cache.h"
 
 namespace Envoy {
 namespace Extensions {
@@ -39,7 +40,9 @@ namespace ExtAuthz {
   COUNTER(denied)                                                                                  \
   COUNTER(error)                                                                                   \
   COUNTER(disabled)                                                                                \
-  COUNTER(failure_mode_allowed)
+  COUNTER(failure_mode_allowed)                                                                    \
+  COUNTER(decision_cache_hit)                                                                      \
+  COUNTER(decision_cache_miss)
 
 /**
  * Wrapper struct for ext_authz filter stats. @see stats_macros.h
@@ -57,7 +60,8 @@ class FilterConfig {
 public:
   FilterConfig(const envoy::extensions::filters::http::ext_authz::v3::ExtAuthz& config,
                Stats::Scope& scope, Runtime::Loader& runtime, Http::Context& http_context,
-               const std::string& stats_prefix, envoy::config::bootstrap::v3::Bootstrap& bootstrap)
+               const std::string& stats_prefix, envoy::config::bootstrap::v3::Bootstrap& bootstrap,
+               ThreadLocal::SlotAllocator& tls)
       : allow_partial_message_(config.with_request_body().allow_partial_message()),
         failure_mode_allow_(config.failure_mode_allow()),
         failure_mode_allow_header_add_(config.failure_mode_allow_header_add()),
@@ -98,6 +102,9 @@ public:
         charge_cluster_response_stats_(
             PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, charge_cluster_response_stats, true)),
         stats_(generateStats(stats_prefix, config.stat_prefix(), scope)),
+        decision_cache_(config.has_decision_cache()
+                            ? std::make_unique<DecisionCache>(config.decision_cache(), tls)
+                            : nullptr),
         ext_authz_ok_(pool_.add(createPoolStatName(config.stat_prefix(), "ok"))),
         ext_authz_denied_(pool_.add(createPoolStatName(config.stat_prefix(), "denied"))),
         ext_authz_error_(pool_.add(createPoolStatName(config.stat_prefix(), "error"))),
@@ -198,6 +205,10 @@ public:
     return request_header_matchers_;
   }
 
+  // @return the cache of the decisions of the authorization server, or nullptr if it is not
+  //         configured.
+  DecisionCache* decisionCache() const { return decision_cache_.get(); }
+
 private:
   static Http::Code toErrorCode(uint64_t status) {
     const auto code = static_cast<Http::Code>(status);
@@ -254,6 +265,8 @@ private:
   // The stats for the filter.
   ExtAuthzFilterStats stats_;
 
+  const DecisionCachePtr decision_cache_;
+
   Filters::Common::ExtAuthz::MatcherSharedPtr request_header_matchers_;
 
 public:
@@ -352,6 +365,9 @@ private:
   absl::optional<MonotonicTime> start_time_;
   void addResponseHeaders(Http::HeaderMap& header_map, const Http::HeaderVector& headers);
   void initiateCall(const Http::RequestHeaderMap& headers);
+  // Applies the cached decision of the authorization server for the request, if any.
+  // @return whether a cached decision was found.
+  bool lookupCachedDecision(const Http::RequestHeaderMap& headers);
   void continueDecoding();
   bool isBufferFull(uint64_t num_bytes_processing) const;
 
@@ -391,6 +407,8 @@ private:
   bool buffer_data_{};
   bool skip_check_{false};
   envoy::service::auth::v3::CheckRequest check_request_{};
+  // The key under which the decision of the authorization server is cached, if any.
+  std::string decision_cache_key_;
 };
 
 } // namespace ExtAuthz
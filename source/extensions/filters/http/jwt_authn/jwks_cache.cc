@@ -58,8 +58,13 @@ public:
     audiences_ = std::make_unique<::google::jwt_verify::CheckAudience>(audiences);
     bool enable_jwt_cache = jwt_provider_.has_jwt_cache_config();
     const auto& config = jwt_provider_.jwt_cache_config();
-    tls_.set([enable_jwt_cache, config](Envoy::Event::Dispatcher& dispatcher) {
-      return std::make_shared<ThreadLocalCache>(enable_jwt_cache, config, dispatcher.timeSource());
+    SharedJwtCacheSharedPtr shared_jwt_cache;
+    if (enable_jwt_cache && config.shared()) {
+      shared_jwt_cache = std::make_shared<SharedJwtCache>(config, time_source_, stats);
+    }
+    tls_.set([enable_jwt_cache, config, shared_jwt_cache](Envoy::Event::Dispatcher& dispatcher) {
+      return std::make_shared<ThreadLocalCache>(enable_jwt_cache, config, dispatcher.timeSource(),
+                                                shared_jwt_cache);
     });
 
     const auto inline_jwks = Config::DataSource::read(jwt_provider_.local_jwks(), true,
@@ -108,8 +113,9 @@ private:
   struct ThreadLocalCache : public ThreadLocal::ThreadLocalObject {
     ThreadLocalCache(bool enable_jwt_cache,
                      const envoy::extensions::filters::http::jwt_authn::v3::JwtCacheConfig& config,
-                     TimeSource& time_source)
-        : jwt_cache_(JwtCache::create(enable_jwt_cache, config, time_source)) {}
+                     TimeSource& time_source, SharedJwtCacheSharedPtr shared_jwt_cache)
+        : jwt_cache_(JwtCache::create(enable_jwt_cache, config, time_source,
+                                      std::move(shared_jwt_cache))) {}
 
     // The jwks object.
     JwksConstSharedPtr jwks_;
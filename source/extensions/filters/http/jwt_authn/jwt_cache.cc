@@ -1,6 +1,7 @@
 #include "source/extensions/filters/http/jwt_authn/jwt_cache.h"
 
 #include "source/common/common/assert.h"
+#include "source/common/common/hash.h"
 
 #include "simple_lru_cache/simple_lru_cache_inl.h"
 
@@ -16,11 +17,14 @@ namespace {
 constexpr int kJwtCacheDefaultSize = 100;
 // The maximum size of JWT to be cached.
 constexpr int kMaxJwtSizeForCache = 4 * 1024; // 4KiB
+// The number of independently locked shards of the shared JWT cache.
+constexpr uint32_t kSharedJwtCacheShards = 16;
 
 class JwtCacheImpl : public JwtCache {
 public:
-  JwtCacheImpl(bool enable_cache, const JwtCacheConfig& config, TimeSource& time_source)
-      : time_source_(time_source) {
+  JwtCacheImpl(bool enable_cache, const JwtCacheConfig& config, TimeSource& time_source,
+               SharedJwtCacheSharedPtr shared_cache)
+      : time_source_(time_source), shared_cache_(std::move(shared_cache)) {
     if (enable_cache) {
       // if cache_size is 0, it is not specified in the config, use default
       auto cache_size =
@@ -52,11 +56,24 @@ public:
         jwt_lru_cache_->remove(token);
       }
     }
+    if (shared_cache_) {
+      // The JWT was verified by another worker. A copy of it is cached by this worker, which is
+      // much cheaper than verifying its signature again.
+      const auto shared_jwt = shared_cache_->lookup(token);
+      if (shared_jwt) {
+        auto* const jwt = new ::google::jwt_verify::Jwt(*shared_jwt);
+        jwt_lru_cache_->insert(token, jwt, 1);
+        return jwt;
+      }
+    }
     return nullptr;
   }
 
   void insert(const std::string& token, std::unique_ptr<::google::jwt_verify::Jwt>&& jwt) override {
     if (jwt_lru_cache_ && token.size() <= kMaxJwtSizeForCache) {
+      if (shared_cache_) {
+        shared_cache_->insert(token, std::make_shared<::google::jwt_verify::Jwt>(*jwt));
+      }
       // pass the ownership of jwt to cache
       jwt_lru_cache_->insert(token, jwt.release(), 1);
     }
@@ -65,12 +82,67 @@ public:
 private:
   std::unique_ptr<SimpleLRUCache<std::string, ::google::jwt_verify::Jwt>> jwt_lru_cache_;
   TimeSource& time_source_;
+  const SharedJwtCacheSharedPtr shared_cache_;
 };
 } // namespace
 
+SharedJwtCache::SharedJwtCache(const JwtCacheConfig& config, TimeSource& time_source,
+                               JwtAuthnFilterStats& stats)
+    : max_entries_per_shard_(
+          ((config.jwt_cache_size() == 0 ? kJwtCacheDefaultSize : config.jwt_cache_size()) +
+           kSharedJwtCacheShards - 1) /
+          kSharedJwtCacheShards),
+      time_source_(time_source), stats_(stats) {
+  for (uint32_t i = 0; i < kSharedJwtCacheShards; ++i) {
+    shards_.push_back(std::make_unique<Shard>());
+  }
+}
+
+SharedJwtCache::Shard& SharedJwtCache::shard(const std::string& token) {
+  return *shards_[HashUtil::xxHash64(token) % shards_.size()];
+}
+
+std::shared_ptr<const ::google::jwt_verify::Jwt>
+SharedJwtCache::lookup(const std::string& token) {
+  Shard& shard = this->shard(token);
+  absl::MutexLock lock(&shard.mutex_);
+  auto it = shard.entries_.find(token);
+  if (it == shard.entries_.end()) {
+    return nullptr;
+  }
+  if (it->second.jwt_->verifyTimeConstraint(DateUtil::nowToSeconds(time_source_)) ==
+      ::google::jwt_verify::Status::JwtExpired) {
+    erase(shard, it);
+    return nullptr;
+  }
+  shard.lru_.splice(shard.lru_.end(), shard.lru_, it->second.lru_entry_);
+  stats_.jwt_cache_shared_hit_.inc();
+  return it->second.jwt_;
+}
+
+void SharedJwtCache::insert(const std::string& token,
+                            std::shared_ptr<::google::jwt_verify::Jwt> jwt) {
+  Shard& shard = this->shard(token);
+  absl::MutexLock lock(&shard.mutex_);
+  auto it = shard.entries_.find(token);
+  if (it != shard.entries_.end()) {
+    erase(shard, it);
+  } else if (shard.entries_.size() >= max_entries_per_shard_) {
+    erase(shard, shard.entries_.find(shard.lru_.front()));
+  }
+  shard.lru_.push_back(token);
+  shard.entries_.emplace(token, Entry{std::move(jwt), std::prev(shard.lru_.end())});
+}
+
+void SharedJwtCache::erase(Shard& shard, absl::flat_hash_map<std::string, Entry>::iterator it) {
+  shard.lru_.erase(it->second.lru_entry_);
+  shard.entries_.erase(it);
+}
+
 JwtCachePtr JwtCache::create(bool enable_cache, const JwtCacheConfig& config,
-                             TimeSource& time_source) {
-  return std::make_unique<JwtCacheImpl>(enable_cache, config, time_source);
+                             TimeSource& time_source, SharedJwtCacheSharedPtr shared_cache) {
+  return std::make_unique<JwtCacheImpl>(enable_cache, config, time_source,
+                                        std::move(shared_cache));
 }
 
 } // namespace JwtAuthn
@@ -1,11 +1,17 @@
 #pragma once
 #include <chrono>
+#include <list>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "envoy/extensions/filters/http/jwt_authn/v3/config.pb.h"
 
 #include "source/common/common/utility.h"
+#include "source/extensions/filters/http/jwt_authn/stats.h"
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/synchronization/mutex.h"
 
 #include "jwt_verify_lib/jwt.h"
 #include "jwt_verify_lib/verify.h"
@@ -19,6 +25,46 @@ namespace JwtAuthn {
 
 // Cache key is the JWT string, value is parsed JWT struct.
 
+// A cache of verified JWTs shared by the JwtCache of every worker thread, so that a JWT is
+// verified once per process rather than once per worker. It is split into shards by the hash of
+// the JWT, each with its own lock and least recently used eviction.
+class SharedJwtCache {
+public:
+  SharedJwtCache(const JwtCacheConfig& config, TimeSource& time_source, JwtAuthnFilterStats& stats);
+
+  // Lookup a JWT token in the cache, if found and not expired return its parsed jwt struct.
+  // If no found, return nullptr.
+  std::shared_ptr<const ::google::jwt_verify::Jwt> lookup(const std::string& token);
+
+  // Insert a JWT token and its parsed JWT struct to the cache. The jwt object is not modified once
+  // it is inserted.
+  void insert(const std::string& token, std::shared_ptr<::google::jwt_verify::Jwt> jwt);
+
+private:
+  struct Entry {
+    std::shared_ptr<::google::jwt_verify::Jwt> jwt_;
+    std::list<std::string>::iterator lru_entry_;
+  };
+
+  struct Shard {
+    absl::Mutex mutex_;
+    absl::flat_hash_map<std::string, Entry> entries_ ABSL_GUARDED_BY(mutex_);
+    // Tokens from the least to the most recently used.
+    std::list<std::string> lru_ ABSL_GUARDED_BY(mutex_);
+  };
+
+  Shard& shard(const std::string& token);
+  static void erase(Shard& shard, absl::flat_hash_map<std::string, Entry>::iterator it)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(shard.mutex_);
+
+  const uint32_t max_entries_per_shard_;
+  TimeSource& time_source_;
+  JwtAuthnFilterStats& stats_;
+  std::vector<std::unique_ptr<Shard>> shards_;
+};
+
+using SharedJwtCacheSharedPtr = std::shared_ptr<SharedJwtCache>;
+
 class JwtCache;
 using JwtCachePtr = std::unique_ptr<JwtCache>;
 
@@ -35,9 +81,11 @@ public:
   virtual void insert(const std::string& token,
                       std::unique_ptr<::google::jwt_verify::Jwt>&& jwt) PURE;
 
-  // JwtCache factory function.
+  // JwtCache factory function. If shared_cache is set, the JWTs missing from the cache are looked
+  // up in it, and the inserted JWTs are also inserted into it.
   static JwtCachePtr create(bool enable_cache, const JwtCacheConfig& config,
-                            TimeSource& time_source);
+                            TimeSource& time_source,
+                            SharedJwtCacheSharedPtr shared_cache = nullptr);
 };
 
 } // namespace JwtAuthn
@@ -1,8 +1,11 @@
 #include "source/extensions/filters/network/redis_proxy/command_splitter_impl.h"
 
 #include "source/common/common/logger.h"
+#include "source/common/runtime/runtime_features.h"
 #include "source/extensions/filters/network/common/redis/supported_commands.h"
 
+#include "absl/container/flat_hash_map.h"
+
 namespace Envoy {
 namespace Extensions {
 namespace NetworkFilters {
@@ -240,26 +243,71 @@ SplitRequestPtr MGETRequest::create(Router& router, Common::Redis::RespValuePtr&
   std::unique_ptr<MGETRequest> request_ptr{
       new MGETRequest(callbacks, command_stats, time_source, delay_command_latency)};
 
-  request_ptr->num_pending_responses_ = incoming_request->asArray().size() - 1;
-  request_ptr->pending_requests_.reserve(request_ptr->num_pending_responses_);
-
+  const uint32_t num_keys = incoming_request->asArray().size() - 1;
   request_ptr->pending_response_ = std::make_unique<Common::Redis::RespValue>();
   request_ptr->pending_response_->type(Common::Redis::RespType::Array);
-  std::vector<Common::Redis::RespValue> responses(request_ptr->num_pending_responses_);
+  std::vector<Common::Redis::RespValue> responses(num_keys);
   request_ptr->pending_response_->asArray().swap(responses);
 
   Common::Redis::RespValueSharedPtr base_request = std::move(incoming_request);
-  for (uint32_t i = 1; i < base_request->asArray().size(); i++) {
-    request_ptr->pending_requests_.emplace_back(*request_ptr, i - 1);
+
+  // Group the keys into fragments. Keys of the same route whose hashed parts are the same are
+  // always sent to the same server, or Redis cluster slot, so they can be fetched together.
+  const bool merge_fragments =
+      num_keys > 1 &&
+      Runtime::runtimeFeatureEnabled("envoy.reloadable_features.redis_merge_mget_fragments");
+  absl::flat_hash_map<std::pair<const Route*, absl::string_view>, uint32_t> fragment_by_hashed_key;
+  std::vector<RouteSharedPtr> fragment_routes;
+  fragment_routes.reserve(num_keys);
+  request_ptr->fragment_keys_.reserve(num_keys);
+  for (uint32_t i = 0; i < num_keys; i++) {
+    std::string& key = base_request->asArray()[i + 1].asString();
+    RouteSharedPtr route = router.upstreamPool(key, stream_info);
+    if (route && merge_fragments) {
+      const absl::string_view hashed_key = route->upstream(Common::Redis::SupportedCommands::get())
+                                               ->hashedKey(key);
+      const auto [it, inserted] = fragment_by_hashed_key.try_emplace(
+          std::make_pair(route.get(), hashed_key), fragment_routes.size());
+      if (!inserted) {
+        request_ptr->fragment_keys_[it->second].push_back(i);
+        continue;
+      }
+    }
+    fragment_routes.push_back(std::move(route));
+    request_ptr->fragment_keys_.push_back({i});
+  }
+
+  request_ptr->num_pending_responses_ = fragment_routes.size();
+  request_ptr->pending_requests_.reserve(request_ptr->num_pending_responses_);
+
+  for (uint32_t fragment = 0; fragment < fragment_routes.size(); fragment++) {
+    request_ptr->pending_requests_.emplace_back(*request_ptr, fragment);
     PendingRequest& pending_request = request_ptr->pending_requests_.back();
 
-    const auto route = router.upstreamPool(base_request->asArray()[i].asString(), stream_info);
-    if (route) {
+    const RouteSharedPtr& route = fragment_routes[fragment];
+    const absl::InlinedVector<uint32_t, 1>& keys = request_ptr->fragment_keys_[fragment];
+    const uint32_t first_key = keys[0] + 1;
+    if (route && keys.size() == 1) {
       // Create composite array for a single get.
       const Common::Redis::RespValue single_mget(
-          base_request, Common::Redis::Utility::GetRequest::instance(), i, i);
+          base_request, Common::Redis::Utility::GetRequest::instance(), first_key, first_key);
       pending_request.handle_ =
-          makeFragmentedRequest(route, "get", base_request->asArray()[i].asString(), single_mget,
+          makeFragmentedRequest(route, Common::Redis::SupportedCommands::get(),
+                                base_request->asArray()[first_key].asString(), single_mget,
+                                pending_request, callbacks.transaction());
+    } else if (route) {
+      std::vector<Common::Redis::RespValue> values(keys.size() + 1);
+      values[0].type(Common::Redis::RespType::BulkString);
+      values[0].asString() = Common::Redis::SupportedCommands::mget();
+      for (uint32_t i = 0; i < keys.size(); i++) {
+        values[i + 1] = base_request->asArray()[keys[i] + 1];
+      }
+      Common::Redis::RespValue merged_mget;
+      merged_mget.type(Common::Redis::RespType::Array);
+      merged_mget.asArray().swap(values);
+      pending_request.handle_ =
+          makeFragmentedRequest(route, Common::Redis::SupportedCommands::mget(),
+                                base_request->asArray()[first_key].asString(), merged_mget,
                                 pending_request, callbacks.transaction());
     }
 
@@ -278,14 +326,40 @@ SplitRequestPtr MGETRequest::create(Router& router, Common::Redis::RespValuePtr&
 void MGETRequest::onChildResponse(Common::Redis::RespValuePtr&& value, uint32_t index) {
   pending_requests_[index].handle_ = nullptr;
 
-  pending_response_->asArray()[index].type(value->type());
-  switch (value->type()) {
+  const absl::InlinedVector<uint32_t, 1>& keys = fragment_keys_[index];
+  if (keys.size() == 1) {
+    setKeyResponse(keys[0], *value);
+  } else if (value->type() == Common::Redis::RespType::Array &&
+             value->asArray().size() == keys.size()) {
+    for (uint32_t i = 0; i < keys.size(); i++) {
+      setKeyResponse(keys[i], value->asArray()[i]);
+    }
+  } else {
+    // The merged MGET failed as a whole, so each of its keys gets the same result.
+    for (const uint32_t key : keys) {
+      Common::Redis::RespValue key_value(*value);
+      setKeyResponse(key, key_value);
+    }
+  }
+
+  ASSERT(num_pending_responses_ > 0);
+  if (--num_pending_responses_ == 0) {
+    updateStats(error_count_ == 0);
+    ENVOY_LOG(debug, "response: '{}'", pending_response_->toString());
+    callbacks_.onResponse(std::move(pending_response_));
+  }
+}
+
+void MGETRequest::setKeyResponse(uint32_t key_index, Common::Redis::RespValue& value) {
+  Common::Redis::RespValue& key_response = pending_response_->asArray()[key_index];
+  key_response.type(value.type());
+  switch (value.type()) {
   case Common::Redis::RespType::Array:
   case Common::Redis::RespType::Integer:
   case Common::Redis::RespType::SimpleString:
   case Common::Redis::RespType::CompositeArray: {
-    pending_response_->asArray()[index].type(Common::Redis::RespType::Error);
-    pending_response_->asArray()[index].asString() = Response::get().UpstreamProtocolError;
+    key_response.type(Common::Redis::RespType::Error);
+    key_response.asString() = Response::get().UpstreamProtocolError;
     error_count_++;
     break;
   }
@@ -294,19 +368,12 @@ void MGETRequest::onChildResponse(Common::Redis::RespValuePtr&& value, uint32_t
     FALLTHRU;
   }
   case Common::Redis::RespType::BulkString: {
-    pending_response_->asArray()[index].asString().swap(value->asString());
+    key_response.asString().swap(value.asString());
     break;
   }
   case Common::Redis::RespType::Null:
     break;
   }
-
-  ASSERT(num_pending_responses_ > 0);
-  if (--num_pending_responses_ == 0) {
-    updateStats(error_count_ == 0);
-    ENVOY_LOG(debug, "response: '{}'", pending_response_->toString());
-    callbacks_.onResponse(std::move(pending_response_));
-  }
 }
 
 SplitRequestPtr MSETRequest::create(Router& router, Common::Redis::RespValuePtr&& incoming_request,
@@ -18,6 +18,8 @@
 #include "source/extensions/filters/network/redis_proxy/conn_pool_impl.h"
 #include "source/extensions/filters/network/redis_proxy/router.h"
 
+#include "absl/container/inlined_vector.h"
+
 namespace Envoy {
 namespace Extensions {
 namespace NetworkFilters {
@@ -266,7 +268,8 @@ protected:
 
 /**
  * MGETRequest takes each key from the command and sends a GET for each to the appropriate Redis
- * server. The response contains the result from each command.
+ * server. Keys that are always sent to the same server, because they have the same hash tag, are
+ * fetched with a single MGET instead. The response contains the result for each key.
  */
 class MGETRequest : public FragmentedRequest {
 public:
@@ -282,6 +285,11 @@ private:
 
   // RedisProxy::CommandSplitter::FragmentedRequest
   void onChildResponse(Common::Redis::RespValuePtr&& value, uint32_t index) override;
+
+  void setKeyResponse(uint32_t key_index, Common::Redis::RespValue& value);
+
+  // The indexes in the response of the keys fetched by each pending request.
+  std::vector<absl::InlinedVector<uint32_t, 1>> fragment_keys_;
 };
 
 /**
@@ -64,6 +64,14 @@ public:
   virtual Common::Redis::Client::PoolRequest*
   makeRequest(const std::string& hash_key, RespVariant&& request, PoolCallbacks& callbacks,
               Common::Redis::Client::Transaction& transaction) PURE;
+
+  /**
+   * @param hash_key supplies the key to use for consistent hashing.
+   * @return absl::string_view the part of hash_key that is hashed to pick an upstream host.
+   *         Requests whose keys have the same hashed part are sent to the same host, or for a Redis
+   *         cluster, the same slot.
+   */
+  virtual absl::string_view hashedKey(absl::string_view hash_key) PURE;
 };
 
 using InstanceSharedPtr = std::shared_ptr<Instance>;
@@ -95,6 +95,10 @@ InstanceImpl::makeRequest(const std::string& key, RespVariant&& request, PoolCal
                                                        transaction);
 }
 
+absl::string_view InstanceImpl::hashedKey(absl::string_view key) {
+  return tls_->getTyped<ThreadLocalPool>().hashedKey(key);
+}
+
 // This method is always called from a InstanceSharedPtr we don't have to worry about tls_->getTyped
 // failing due to InstanceImpl going away.
 Common::Redis::Client::PoolRequest*
@@ -285,6 +289,12 @@ InstanceImpl::ThreadLocalPool::threadLocalActiveClient(Upstream::HostConstShared
   return client;
 }
 
+absl::string_view InstanceImpl::ThreadLocalPool::hashedKey(absl::string_view key) const {
+  // A Redis cluster always hashes the hash tag of a key, see RedisLoadBalancerContextImpl.
+  return Clusters::Redis::RedisLoadBalancerContextImpl::hashtag(
+      key, is_redis_cluster_ || config_->enableHashtagging());
+}
+
 Common::Redis::Client::PoolRequest*
 InstanceImpl::ThreadLocalPool::makeRequest(const std::string& key, RespVariant&& request,
                                            PoolCallbacks& callbacks,
@@ -94,6 +94,8 @@ UdpProxyFilterConfigImpl::UdpProxyFilterConfigImpl(
       session_timeout_(PROTOBUF_GET_MS_OR_DEFAULT(config, idle_timeout, 60 * 1000)),
       use_original_src_ip_(config.use_original_src_ip()),
       use_per_packet_load_balancing_(config.use_per_packet_load_balancing()),
+      batch_upstream_writes_(config.batch_upstream_writes() && !use_original_src_ip_ &&
+                             Api::OsSysCallsSingleton::get().supportsUdpGso()),
       stats_(generateStats(config.stat_prefix(), context.scope())),
       // Default prefer_gro to true for upstream client traffic.
       upstream_socket_config_(config.upstream_socket_config(), true),
@@ -300,7 +300,10 @@ UdpProxyFilter::UdpActiveSession::UdpActiveSession(
     ClusterInfo& cluster, Network::UdpRecvData::LocalPeerAddresses&& addresses,
     const Upstream::HostConstSharedPtr& host)
     : ActiveSession(cluster, std::move(addresses), std::move(host)),
-      use_original_src_ip_(cluster.filter_.config_->usingOriginalSrcIp()) {}
+      use_original_src_ip_(cluster.filter_.config_->usingOriginalSrcIp()),
+      batch_upstream_writes_(cluster.filter_.config_->batchUpstreamWrites()) {}
+
+UdpProxyFilter::UdpActiveSession::~UdpActiveSession() { flushUpstreamWrites(); }
 
 UdpProxyFilter::ActiveSession::~ActiveSession() {
   ENVOY_BUG(on_session_complete_called_, "onSessionComplete() not called");
@@ -490,6 +493,17 @@ void UdpProxyFilter::UdpActiveSession::writeUpstream(Network::UdpRecvData& data)
             tx_buffer_length, addresses_.peer_->asStringView(), addresses_.local_->asStringView(),
             host_->address()->asStringView());
 
+  if (batch_upstream_writes_ && !upstream_gso_disabled_) {
+    if (tx_buffer_length <= maxGsoSegmentSize()) {
+      batchUpstreamWrite(data);
+      return;
+    }
+    // A datagram that would not fit the MTU as a GSO segment is sent on its own, without a segment
+    // size, so that the kernel can fragment it.
+    flushUpstreamWrites();
+    setUpstreamGsoSegmentSize(0);
+  }
+
   const Network::Address::Ip* local_ip = use_original_src_ip_ ? addresses_.peer_->ip() : nullptr;
   Api::IoCallUint64Result rc = Network::Utility::writeToSocket(
       udp_socket_->ioHandle(), *data.buffer_, local_ip, *host_->address());
@@ -502,6 +516,133 @@ void UdpProxyFilter::UdpActiveSession::writeUpstream(Network::UdpRecvData& data)
   }
 }
 
+namespace {
+// The kernel limits on a single GSO write: the number of segments, and the total UDP payload of
+// an IPv4 datagram.
+constexpr uint32_t MaxGsoSegments = 64;
+constexpr uint64_t MaxGsoPayloadSize = 65507;
+// The kernel rejects GSO segments that do not fit the MTU. These are the largest UDP payloads
+// that fit the common 1500 byte MTU, after the IP and UDP headers.
+constexpr uint64_t MaxGsoSegmentSizeV4 = 1500 - 20 - 8;
+constexpr uint64_t MaxGsoSegmentSizeV6 = 1500 - 40 - 8;
+} // namespace
+
+uint64_t UdpProxyFilter::UdpActiveSession::maxGsoSegmentSize() const {
+  return host_->address()->ip() != nullptr &&
+                 host_->address()->ip()->version() == Network::Address::IpVersion::v4
+             ? MaxGsoSegmentSizeV4
+             : MaxGsoSegmentSizeV6;
+}
+
+bool UdpProxyFilter::UdpActiveSession::setUpstreamGsoSegmentSize(int segment_size) {
+  if (upstream_gso_segment_size_ == segment_size) {
+    return true;
+  }
+  const Api::SysCallIntResult rc = udp_socket_->ioHandle().setOption(
+      SOL_UDP, UDP_SEGMENT, &segment_size, sizeof(segment_size));
+  if (SOCKET_FAILURE(rc.return_value_)) {
+    // Don't try again on every write.
+    ENVOY_LOG(debug, "cannot set the UDP segment size, disabling GSO: ({}) {}", rc.errno_,
+              errorDetails(rc.errno_));
+    upstream_gso_disabled_ = true;
+    return false;
+  }
+  upstream_gso_segment_size_ = segment_size;
+  return true;
+}
+
+void UdpProxyFilter::UdpActiveSession::batchUpstreamWrite(Network::UdpRecvData& data) {
+  const uint64_t length = data.buffer_->length();
+  // A GSO write splits its payload into segments of the same size, so only a datagram that is no
+  // longer than the ones before it can join the batch, and a shorter one must be the last.
+  if (pending_upstream_datagrams_ > 0 &&
+      (length > pending_upstream_segment_size_ ||
+       pending_upstream_datagrams_ == MaxGsoSegments ||
+       pending_upstream_writes_.length() + length > MaxGsoPayloadSize)) {
+    flushUpstreamWrites();
+  }
+
+  if (pending_upstream_datagrams_ == 0) {
+    pending_upstream_segment_size_ = length;
+    if (flush_upstream_writes_cb_ == nullptr) {
+      flush_upstream_writes_cb_ =
+          cluster_.filter_.read_callbacks_->udpListener().dispatcher().createSchedulableCallback(
+              [this]() { flushUpstreamWrites(); });
+    }
+    // Every datagram read by the listener in this iteration is processed before the callback runs.
+    flush_upstream_writes_cb_->scheduleCallbackCurrentIteration();
+  }
+  pending_upstream_writes_.move(*data.buffer_);
+  ++pending_upstream_datagrams_;
+
+  if (length < pending_upstream_segment_size_) {
+    flushUpstreamWrites();
+  }
+}
+
+void UdpProxyFilter::UdpActiveSession::flushUpstreamWrites() {
+  if (pending_upstream_datagrams_ == 0) {
+    return;
+  }
+
+  // The segment size set on the socket applies to every write, so it has to match a batch of
+  // several datagrams, and must not be smaller than a single datagram that is sent on its own.
+  const int segment_size = static_cast<int>(pending_upstream_segment_size_);
+  bool use_gso = !upstream_gso_disabled_;
+  if (use_gso && (pending_upstream_datagrams_ > 1
+                      ? upstream_gso_segment_size_ != segment_size
+                      : (upstream_gso_segment_size_ != 0 &&
+                         upstream_gso_segment_size_ < segment_size))) {
+    use_gso = setUpstreamGsoSegmentSize(segment_size);
+  }
+
+  if (use_gso) {
+    const Api::IoCallUint64Result rc = writeUpstreamBatch(pending_upstream_writes_,
+                                                          pending_upstream_datagrams_);
+    if (!rc.ok() && rc.err_->getSystemErrorCode() == EINVAL) {
+      // The kernel rejected the segment size, e.g. because the path MTU is lower than expected,
+      // and would keep rejecting it.
+      ENVOY_LOG(debug, "UDP GSO write rejected, disabling GSO");
+      upstream_gso_disabled_ = true;
+      use_gso = false;
+    } else {
+      recordUpstreamBatch(rc, pending_upstream_writes_.length(), pending_upstream_datagrams_);
+    }
+  }
+
+  if (!use_gso) {
+    // The datagrams can't be segmented by the kernel, so write them one at a time.
+    setUpstreamGsoSegmentSize(0);
+    while (pending_upstream_writes_.length() > 0) {
+      Buffer::OwnedImpl datagram;
+      datagram.move(pending_upstream_writes_,
+                    std::min(pending_upstream_segment_size_, pending_upstream_writes_.length()));
+      recordUpstreamBatch(writeUpstreamBatch(datagram, 1), datagram.length(), 1);
+    }
+  }
+  pending_upstream_writes_.drain(pending_upstream_writes_.length());
+  pending_upstream_datagrams_ = 0;
+}
+
+Api::IoCallUint64Result
+UdpProxyFilter::UdpActiveSession::writeUpstreamBatch(const Buffer::Instance& buffer,
+                                                     uint32_t datagrams) {
+  ENVOY_LOG(trace, "writing {} datagrams upstream in {} bytes", datagrams, buffer.length());
+  return Network::Utility::writeToSocket(udp_socket_->ioHandle(), buffer, nullptr,
+                                         *host_->address());
+}
+
+void UdpProxyFilter::UdpActiveSession::recordUpstreamBatch(const Api::IoCallUint64Result& rc,
+                                                           uint64_t bytes, uint32_t datagrams) {
+  if (!rc.ok()) {
+    cluster_.cluster_stats_.sess_tx_errors_.add(datagrams);
+  } else {
+    cluster_.cluster_stats_.sess_tx_batches_.inc();
+    cluster_.cluster_stats_.sess_tx_datagrams_.add(datagrams);
+    cluster_.cluster_.info()->trafficStats()->upstream_cx_tx_bytes_total_.add(bytes);
+  }
+}
+
 bool UdpProxyFilter::ActiveSession::onContinueFilterChain(ActiveReadFilter* filter) {
   ASSERT(filter != nullptr);
 
@@ -3,6 +3,7 @@
 #include "envoy/access_log/access_log.h"
 #include "envoy/config/accesslog/v3/accesslog.pb.h"
 #include "envoy/event/file_event.h"
+#include "envoy/event/schedulable_cb.h"
 #include "envoy/event/timer.h"
 #include "envoy/extensions/filters/udp/udp_proxy/v3/udp_proxy.pb.h"
 #include "envoy/http/header_evaluator.h"
@@ -13,6 +14,7 @@
 
 #include "source/common/access_log/access_log_impl.h"
 #include "source/common/api/os_sys_calls_impl.h"
+#include "source/common/buffer/buffer_impl.h"
 #include "source/common/common/empty_string.h"
 #include "source/common/common/linked_object.h"
 #include "source/common/common/random_generator.h"
@@ -71,6 +73,7 @@ struct UdpProxyDownstreamStats {
   COUNTER(sess_rx_datagrams)                                                                       \
   COUNTER(sess_rx_datagrams_dropped)                                                               \
   COUNTER(sess_rx_errors)                                                                          \
+  COUNTER(sess_tx_batches)                                                                         \
   COUNTER(sess_tx_datagrams)                                                                       \
   COUNTER(sess_tunnel_success)                                                                     \
   COUNTER(sess_tunnel_failure)                                                                     \
@@ -125,6 +128,7 @@ public:
   virtual std::chrono::milliseconds sessionTimeout() const PURE;
   virtual bool usingOriginalSrcIp() const PURE;
   virtual bool usingPerPacketLoadBalancing() const PURE;
+  virtual bool batchUpstreamWrites() const PURE;
   virtual const Udp::HashPolicy* hashPolicy() const PURE;
   virtual UdpProxyDownstreamStats& stats() const PURE;
   virtual TimeSource& timeSource() const PURE;
@@ -625,7 +629,7 @@ private:
   public:
     UdpActiveSession(ClusterInfo& parent, Network::UdpRecvData::LocalPeerAddresses&& addresses,
                      const Upstream::HostConstSharedPtr& host);
-    ~UdpActiveSession() override = default;
+    ~UdpActiveSession() override;
 
     // ActiveSession
     bool createUpstream() override;
@@ -653,6 +657,15 @@ private:
   private:
     void onReadReady();
     void createUdpSocket(const Upstream::HostConstSharedPtr& host);
+    void batchUpstreamWrite(Network::UdpRecvData& data);
+    void flushUpstreamWrites();
+    Api::IoCallUint64Result writeUpstreamBatch(const Buffer::Instance& buffer, uint32_t datagrams);
+    void recordUpstreamBatch(const Api::IoCallUint64Result& rc, uint64_t bytes,
+                             uint32_t datagrams);
+    // Sets UDP_SEGMENT on the upstream socket, or disables GSO for the session if it can't be set.
+    bool setUpstreamGsoSegmentSize(int segment_size);
+    // The largest datagram that is batched, as a GSO segment must fit the MTU.
+    uint64_t maxGsoSegmentSize() const;
 
     // The socket is used for writing packets to the selected upstream host as well as receiving
     // packets from the upstream host. Note that a a local ephemeral port is bound on the first
@@ -661,6 +674,19 @@ private:
     // The socket has been connected to avoid port exhaustion.
     bool connected_{};
     const bool use_original_src_ip_;
+    const bool batch_upstream_writes_;
+    // When batching upstream writes, the datagrams written during the current event loop iteration.
+    // They are sent with a single GSO write once the iteration is done, so all but the last of them
+    // are pending_upstream_segment_size_ bytes long.
+    Buffer::OwnedImpl pending_upstream_writes_;
+    uint64_t pending_upstream_segment_size_{};
+    uint32_t pending_upstream_datagrams_{};
+    // The UDP_SEGMENT size currently set on the socket, or 0 if it is not set.
+    int upstream_gso_segment_size_{};
+    // Set once the kernel fails to set or use a segment size, after which datagrams are written
+    // one at a time.
+    bool upstream_gso_disabled_{};
+    Event::SchedulableCallbackPtr flush_upstream_writes_cb_;
   };
 
   /**
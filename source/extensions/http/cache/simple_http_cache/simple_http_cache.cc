@@ -12,6 +12,13 @@ namespace HttpFilters {
 namespace Cache {
 namespace {
 
+constexpr uint32_t DefaultNumShards = 16;
+
+// Rounded up, so that a budget smaller than the number of shards does not leave them unbounded.
+uint64_t maxBytesPerShard(uint64_t max_bytes, uint32_t num_shards) {
+  return max_bytes / num_shards + (max_bytes % num_shards != 0 ? 1 : 0);
+}
+
 // Returns a Key with the vary header added to custom_fields.
 // It is an error to call this with headers that don't include vary.
 // Returns nullopt if the vary headers in the response are not
@@ -137,98 +144,112 @@ private:
 };
 } // namespace
 
+SimpleHttpCache::SimpleHttpCache(
+    const envoy::extensions::http::cache::simple_http_cache::v3::SimpleHttpCacheConfig& config,
+    Stats::Scope& scope)
+    : stats_{ALL_SIMPLE_HTTP_CACHE_STATS(POOL_COUNTER_PREFIX(scope, "cache.simple."),
+                                         POOL_GAUGE_PREFIX(scope, "cache.simple."))},
+      max_bytes_(config.max_bytes()),
+      max_bytes_per_shard_(maxBytesPerShard(
+          max_bytes_, PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, num_shards, DefaultNumShards))) {
+  const uint32_t num_shards = PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, num_shards, DefaultNumShards);
+  shards_.reserve(num_shards);
+  for (uint32_t i = 0; i < num_shards; i++) {
+    shards_.push_back(std::make_unique<Shard>());
+  }
+}
+
 LookupContextPtr SimpleHttpCache::makeLookupContext(LookupRequest&& request,
                                                     Http::StreamDecoderFilterCallbacks&) {
   return std::make_unique<SimpleLookupContext>(*this, std::move(request));
 }
 
+SimpleHttpCache::Shard& SimpleHttpCache::shardFor(const Key& key) {
+  return *shards_[stableHashKey(key) % shards_.size()];
+}
+
 void SimpleHttpCache::updateHeaders(const LookupContext& lookup_context,
                                     const Http::ResponseHeaderMap& response_headers,
                                     const ResponseMetadata& metadata,
                                     std::function<void(bool)> on_complete) {
   const auto& simple_lookup_context = static_cast<const SimpleLookupContext&>(lookup_context);
-  const Key& key = simple_lookup_context.request().key();
-  absl::WriterMutexLock lock(&mutex_);
-  auto iter = map_.find(key);
-  if (iter == map_.end() || !iter->second.response_headers_) {
-    on_complete(false);
-    return;
+  const LookupRequest& request = simple_lookup_context.request();
+  absl::optional<Key> varied_key;
+  bool updated =
+      updateHeadersInShard(request, request.key(), response_headers, metadata, &varied_key);
+  if (varied_key.has_value()) {
+    updated = updateHeadersInShard(request, varied_key.value(), response_headers, metadata,
+                                   nullptr);
   }
-  if (VaryHeaderUtils::hasVary(*iter->second.response_headers_)) {
-    absl::optional<Key> varied_key =
-        variedRequestKey(simple_lookup_context.request(), *iter->second.response_headers_);
-    if (!varied_key.has_value()) {
-      on_complete(false);
-      return;
-    }
-    iter = map_.find(varied_key.value());
-    if (iter == map_.end() || !iter->second.response_headers_) {
-      on_complete(false);
-      return;
-    }
+  on_complete(updated);
+}
+
+bool SimpleHttpCache::updateHeadersInShard(const LookupRequest& request, const Key& key,
+                                           const Http::ResponseHeaderMap& response_headers,
+                                           const ResponseMetadata& metadata,
+                                           absl::optional<Key>* varied_key) {
+  Shard& shard = shardFor(key);
+  absl::MutexLock lock(&shard.mutex_);
+  auto iter = shard.map_.find(key);
+  if (iter == shard.map_.end() || !iter->second.entry_.response_headers_) {
+    return false;
+  }
+  StoredEntry& stored = iter->second;
+  if (varied_key != nullptr && VaryHeaderUtils::hasVary(*stored.entry_.response_headers_)) {
+    *varied_key = variedRequestKey(request, *stored.entry_.response_headers_);
+    return false;
   }
-  Entry& entry = iter->second;
 
-  applyHeaderUpdate(response_headers, *entry.response_headers_);
-  entry.metadata_ = metadata;
-  on_complete(true);
+  applyHeaderUpdate(response_headers, *stored.entry_.response_headers_);
+  stored.entry_.metadata_ = metadata;
+  touchLocked(shard, stored);
+  resizeLocked(shard, stored, entrySize(key, stored.entry_));
+  return true;
 }
 
 SimpleHttpCache::Entry SimpleHttpCache::lookup(const LookupRequest& request) {
-  absl::ReaderMutexLock lock(&mutex_);
-  auto iter = map_.find(request.key());
-  if (iter == map_.end()) {
-    return Entry{};
+  absl::optional<Key> varied_key;
+  Entry entry = lookupInShard(request, request.key(), &varied_key);
+  if (varied_key.has_value()) {
+    // The entry for the request key only flags that the response varies. The varied response is
+    // stored under its own key, which is likely to live in another shard.
+    entry = lookupInShard(request, varied_key.value(), nullptr);
   }
-  ASSERT(iter->second.response_headers_);
-
-  if (VaryHeaderUtils::hasVary(*iter->second.response_headers_)) {
-    return varyLookup(request, iter->second.response_headers_);
+  if (entry.response_headers_) {
+    stats_.lookup_hit_.inc();
   } else {
-    Http::ResponseTrailerMapPtr trailers_map;
-    if (iter->second.trailers_) {
-      trailers_map = Http::createHeaderMap<Http::ResponseTrailerMapImpl>(*iter->second.trailers_);
-    }
-    return SimpleHttpCache::Entry{
-        Http::createHeaderMap<Http::ResponseHeaderMapImpl>(*iter->second.response_headers_),
-        iter->second.metadata_, iter->second.body_, std::move(trailers_map)};
+    stats_.lookup_miss_.inc();
   }
+  return entry;
 }
 
-bool SimpleHttpCache::insert(const Key& key, Http::ResponseHeaderMapPtr&& response_headers,
-                             ResponseMetadata&& metadata, std::string&& body,
-                             Http::ResponseTrailerMapPtr&& trailers) {
-  absl::WriterMutexLock lock(&mutex_);
-  map_[key] = SimpleHttpCache::Entry{std::move(response_headers), std::move(metadata),
-                                     std::move(body), std::move(trailers)};
-  return true;
-}
-
-SimpleHttpCache::Entry
-SimpleHttpCache::varyLookup(const LookupRequest& request,
-                            const Http::ResponseHeaderMapPtr& response_headers) {
-  // This method should be called from lookup, which holds the mutex for reading.
-  mutex_.AssertReaderHeld();
-
-  absl::optional<Key> varied_key = variedRequestKey(request, *response_headers);
-  if (!varied_key.has_value()) {
-    return SimpleHttpCache::Entry{};
+SimpleHttpCache::Entry SimpleHttpCache::lookupInShard(const LookupRequest& request, const Key& key,
+                                                      absl::optional<Key>* varied_key) {
+  Shard& shard = shardFor(key);
+  absl::MutexLock lock(&shard.mutex_);
+  auto iter = shard.map_.find(key);
+  if (iter == shard.map_.end()) {
+    return Entry{};
   }
-  Key& varied_request_key = varied_key.value();
+  StoredEntry& stored = iter->second;
+  ASSERT(stored.entry_.response_headers_);
+  touchLocked(shard, stored);
 
-  auto iter = map_.find(varied_request_key);
-  if (iter == map_.end()) {
-    return SimpleHttpCache::Entry{};
-  }
-  ASSERT(iter->second.response_headers_);
-  Http::ResponseTrailerMapPtr trailers_map;
-  if (iter->second.trailers_) {
-    trailers_map = Http::createHeaderMap<Http::ResponseTrailerMapImpl>(*iter->second.trailers_);
+  if (varied_key != nullptr && VaryHeaderUtils::hasVary(*stored.entry_.response_headers_)) {
+    *varied_key = variedRequestKey(request, *stored.entry_.response_headers_);
+    return Entry{};
   }
+  return copyEntry(stored.entry_);
+}
 
-  return SimpleHttpCache::Entry{
-      Http::createHeaderMap<Http::ResponseHeaderMapImpl>(*iter->second.response_headers_),
-      iter->second.metadata_, iter->second.body_, std::move(trailers_map)};
+bool SimpleHttpCache::insert(const Key& key, Http::ResponseHeaderMapPtr&& response_headers,
+                             ResponseMetadata&& metadata, std::string&& body,
+                             Http::ResponseTrailerMapPtr&& trailers) {
+  Shard& shard = shardFor(key);
+  absl::MutexLock lock(&shard.mutex_);
+  return insertLocked(shard, key,
+                      Entry{std::move(response_headers), std::move(metadata), std::move(body),
+                            std::move(trailers)});
 }
 
 bool SimpleHttpCache::varyInsert(const Key& request_key,
@@ -237,8 +258,6 @@ bool SimpleHttpCache::varyInsert(const Key& request_key,
                                  const Http::RequestHeaderMap& request_headers,
                                  const VaryAllowList& vary_allow_list,
                                  Http::ResponseTrailerMapPtr&& trailers) {
-  absl::WriterMutexLock lock(&mutex_);
-
   absl::btree_set<absl::string_view> vary_header_values =
       VaryHeaderUtils::getVaryValues(*response_headers);
   ASSERT(!vary_header_values.empty());
@@ -251,29 +270,112 @@ bool SimpleHttpCache::varyInsert(const Key& request_key,
     // Skip the insert if we are unable to create a vary key.
     return false;
   }
+  // The varied response may be evicted as soon as it is inserted, so the vary values must not
+  // reference its headers past this point.
+  std::string vary_values = absl::StrJoin(vary_header_values, ",");
 
   varied_request_key.add_custom_fields(vary_identifier.value());
-  map_[varied_request_key] = SimpleHttpCache::Entry{
-      std::move(response_headers), std::move(metadata), std::move(body), std::move(trailers)};
+  {
+    Shard& shard = shardFor(varied_request_key);
+    absl::MutexLock lock(&shard.mutex_);
+    if (!insertLocked(shard, varied_request_key,
+                      Entry{std::move(response_headers), std::move(metadata), std::move(body),
+                            std::move(trailers)})) {
+      return false;
+    }
+  }
 
   // Add a special entry to flag that this request generates varied responses.
-  auto iter = map_.find(request_key);
-  if (iter == map_.end()) {
+  Shard& shard = shardFor(request_key);
+  absl::MutexLock lock(&shard.mutex_);
+  if (!shard.map_.contains(request_key)) {
     Envoy::Http::ResponseHeaderMapPtr vary_only_map =
         Envoy::Http::createHeaderMap<Envoy::Http::ResponseHeaderMapImpl>({});
-    vary_only_map->setCopy(Envoy::Http::CustomHeaders::get().Vary,
-                           absl::StrJoin(vary_header_values, ","));
-    // TODO(cbdm): In a cache that evicts entries, we could maintain a list of the "varykey"s that
-    // we have inserted as the body for this first lookup. This way, we would know which keys we
-    // have inserted for that resource. For the first entry simply use vary_identifier as the
-    // entry_list; for future entries append vary_identifier to existing list.
+    vary_only_map->setCopy(Envoy::Http::CustomHeaders::get().Vary, vary_values);
+    // TODO(cbdm): We could maintain a list of the "varykey"s that we have inserted as the body
+    // for this first lookup. This way, we would know which keys we have inserted for that
+    // resource, and could evict them together with this entry. For the first entry simply use
+    // vary_identifier as the entry_list; for future entries append vary_identifier to existing
+    // list.
     std::string entry_list;
-    map_[request_key] =
-        SimpleHttpCache::Entry{std::move(vary_only_map), {}, std::move(entry_list), {}};
+    insertLocked(shard, request_key,
+                 Entry{std::move(vary_only_map), {}, std::move(entry_list), {}});
+  }
+  return true;
+}
+
+bool SimpleHttpCache::insertLocked(Shard& shard, const Key& key, Entry&& entry) {
+  const uint64_t size = entrySize(key, entry);
+  if (max_bytes_per_shard_ != 0 && size > max_bytes_per_shard_) {
+    stats_.insert_rejected_.inc();
+    return false;
+  }
+
+  auto [iter, inserted] = shard.map_.try_emplace(key);
+  StoredEntry& stored = iter->second;
+  if (inserted) {
+    shard.lru_.push_front(&iter->first);
+    stored.lru_pos_ = shard.lru_.begin();
+    stats_.size_count_.inc();
+  } else {
+    touchLocked(shard, stored);
   }
+  stored.entry_ = std::move(entry);
+  stats_.insert_.inc();
+  resizeLocked(shard, stored, size);
   return true;
 }
 
+void SimpleHttpCache::touchLocked(Shard& shard, StoredEntry& stored) {
+  shard.lru_.splice(shard.lru_.begin(), shard.lru_, stored.lru_pos_);
+}
+
+void SimpleHttpCache::resizeLocked(Shard& shard, StoredEntry& stored, uint64_t new_size) {
+  shard.size_bytes_ = shard.size_bytes_ - stored.size_ + new_size;
+  stats_.size_bytes_.sub(stored.size_);
+  stats_.size_bytes_.add(new_size);
+  stored.size_ = new_size;
+  evictLocked(shard);
+}
+
+void SimpleHttpCache::evictLocked(Shard& shard) {
+  if (max_bytes_per_shard_ == 0) {
+    return;
+  }
+  while (shard.size_bytes_ > max_bytes_per_shard_) {
+    ASSERT(!shard.lru_.empty());
+    auto iter = shard.map_.find(*shard.lru_.back());
+    ASSERT(iter != shard.map_.end());
+    shard.size_bytes_ -= iter->second.size_;
+    stats_.size_bytes_.sub(iter->second.size_);
+    stats_.size_count_.dec();
+    stats_.eviction_.inc();
+    shard.lru_.pop_back();
+    shard.map_.erase(iter);
+  }
+}
+
+uint64_t SimpleHttpCache::entrySize(const Key& key, const Entry& entry) {
+  uint64_t size = key.ByteSizeLong() + entry.body_.size();
+  if (entry.response_headers_) {
+    size += entry.response_headers_->byteSize();
+  }
+  if (entry.trailers_) {
+    size += entry.trailers_->byteSize();
+  }
+  return size;
+}
+
+SimpleHttpCache::Entry SimpleHttpCache::copyEntry(const Entry& entry) {
+  Http::ResponseTrailerMapPtr trailers_map;
+  if (entry.trailers_) {
+    trailers_map = Http::createHeaderMap<Http::ResponseTrailerMapImpl>(*entry.trailers_);
+  }
+  return SimpleHttpCache::Entry{
+      Http::createHeaderMap<Http::ResponseHeaderMapImpl>(*entry.response_headers_),
+      entry.metadata_, entry.body_, std::move(trailers_map)};
+}
+
 InsertContextPtr SimpleHttpCache::makeInsertContext(LookupContextPtr&& lookup_context,
                                                     Http::StreamEncoderFilterCallbacks&) {
   ASSERT(lookup_context != nullptr);
@@ -282,6 +384,13 @@ InsertContextPtr SimpleHttpCache::makeInsertContext(LookupContextPtr&& lookup_co
 
 constexpr absl::string_view Name = "envoy.extensions.http.cache.simple";
 
+bool SimpleHttpCache::isConfiguredAs(
+    const envoy::extensions::http::cache::simple_http_cache::v3::SimpleHttpCacheConfig& config)
+    const {
+  return config.max_bytes() == max_bytes_ &&
+         PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, num_shards, DefaultNumShards) == shards_.size();
+}
+
 CacheInfo SimpleHttpCache::cacheInfo() const {
   CacheInfo cache_info;
   cache_info.name_ = Name;
@@ -300,16 +409,27 @@ public:
         envoy::extensions::http::cache::simple_http_cache::v3::SimpleHttpCacheConfig>();
   }
   // From HttpCacheFactory
+  // The cache is a process-wide singleton, so all the filters that use it at the same time must
+  // have the same configuration.
   std::shared_ptr<HttpCache>
-  getCache(const envoy::extensions::filters::http::cache::v3::CacheConfig&,
+  getCache(const envoy::extensions::filters::http::cache::v3::CacheConfig& filter_config,
            Server::Configuration::FactoryContext& context) override {
-    return context.serverFactoryContext().singletonManager().getTyped<SimpleHttpCache>(
-        SINGLETON_MANAGER_REGISTERED_NAME(simple_http_cache_singleton), &createCache);
-  }
-
-private:
-  static std::shared_ptr<Singleton::Instance> createCache() {
-    return std::make_shared<SimpleHttpCache>();
+    envoy::extensions::http::cache::simple_http_cache::v3::SimpleHttpCacheConfig config;
+    MessageUtil::unpackTo(filter_config.typed_config(), config);
+    MessageUtil::validate(config, context.messageValidationVisitor());
+    std::shared_ptr<SimpleHttpCache> cache =
+        context.serverFactoryContext().singletonManager().getTyped<SimpleHttpCache>(
+            SINGLETON_MANAGER_REGISTERED_NAME(simple_http_cache_singleton), [&config, &context] {
+              return std::make_shared<SimpleHttpCache>(config,
+                                                       context.serverFactoryContext().scope());
+            });
+    if (!cache->isConfiguredAs(config)) {
+      throwEnvoyExceptionOrPanic(
+          fmt::format("{}: all the cache filters share one cache, so they must have the same "
+                      "num_shards and max_bytes",
+                      Name));
+    }
+    return cache;
   }
 };
 
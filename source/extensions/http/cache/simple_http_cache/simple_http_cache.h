@@ -1,10 +1,15 @@
 #pragma once
 
+#include <list>
+
+#include "envoy/extensions/http/cache/simple_http_cache/v3/config.pb.h"
+#include "envoy/stats/stats_macros.h"
+
 #include "source/common/protobuf/utility.h"
 #include "source/extensions/filters/http/cache/http_cache.h"
 
 #include "absl/base/thread_annotations.h"
-#include "absl/container/flat_hash_map.h"
+#include "absl/container/node_hash_map.h"
 #include "absl/synchronization/mutex.h"
 
 namespace Envoy {
@@ -12,7 +17,28 @@ namespace Extensions {
 namespace HttpFilters {
 namespace Cache {
 
-// Example cache backend that never evicts. Not suitable for production use.
+/**
+ * All stats for the simple http cache. @see stats_macros.h
+ */
+#define ALL_SIMPLE_HTTP_CACHE_STATS(COUNTER, GAUGE)                                                \
+  COUNTER(eviction)                                                                                \
+  COUNTER(insert)                                                                                  \
+  COUNTER(insert_rejected)                                                                         \
+  COUNTER(lookup_hit)                                                                              \
+  COUNTER(lookup_miss)                                                                             \
+  GAUGE(size_bytes, NeverImport)                                                                   \
+  GAUGE(size_count, NeverImport)
+
+/**
+ * Struct definition for all simple http cache stats. @see stats_macros.h
+ */
+struct SimpleHttpCacheStats {
+  ALL_SIMPLE_HTTP_CACHE_STATS(GENERATE_COUNTER_STRUCT, GENERATE_GAUGE_STRUCT)
+};
+
+// In-memory cache backend. Entries are spread over independently locked shards by the hash of
+// their key, and each shard evicts its least recently used entries when the optional byte budget
+// is exceeded.
 class SimpleHttpCache : public HttpCache, public Singleton::Instance {
 private:
   struct Entry {
@@ -22,9 +48,45 @@ private:
     Http::ResponseTrailerMapPtr trailers_;
   };
 
-  // Looks for a response that has been varied. Only called from lookup.
-  Entry varyLookup(const LookupRequest& request,
-                   const Http::ResponseHeaderMapPtr& response_headers);
+  struct StoredEntry {
+    Entry entry_;
+    // Approximate memory footprint of the entry, including its key.
+    uint64_t size_{};
+    // Position of the entry's key in the owning shard's LRU list.
+    std::list<const Key*>::iterator lru_pos_;
+  };
+
+  struct Shard {
+    absl::Mutex mutex_;
+    // node_hash_map keeps keys at stable addresses, so the LRU list can refer to them directly.
+    absl::node_hash_map<Key, StoredEntry, MessageUtil, MessageUtil> map_ ABSL_GUARDED_BY(mutex_);
+    // Keys ordered from most to least recently used.
+    std::list<const Key*> lru_ ABSL_GUARDED_BY(mutex_);
+    uint64_t size_bytes_ ABSL_GUARDED_BY(mutex_){};
+  };
+
+  Shard& shardFor(const Key& key);
+
+  // Returns a copy of the entry stored for key, or an empty entry, and marks it as recently used.
+  // If varied_key is non-null and the stored entry only flags that the response varies, an empty
+  // entry is returned and varied_key is set to the key of the varied response for this request.
+  Entry lookupInShard(const LookupRequest& request, const Key& key,
+                      absl::optional<Key>* varied_key);
+  // Applies a header update to the entry stored for key, with the same vary handling as
+  // lookupInShard. Returns whether the entry was updated.
+  bool updateHeadersInShard(const LookupRequest& request, const Key& key,
+                            const Http::ResponseHeaderMap& response_headers,
+                            const ResponseMetadata& metadata, absl::optional<Key>* varied_key);
+
+  bool insertLocked(Shard& shard, const Key& key, Entry&& entry)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(shard.mutex_);
+  void touchLocked(Shard& shard, StoredEntry& stored) ABSL_EXCLUSIVE_LOCKS_REQUIRED(shard.mutex_);
+  void resizeLocked(Shard& shard, StoredEntry& stored, uint64_t new_size)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(shard.mutex_);
+  void evictLocked(Shard& shard) ABSL_EXCLUSIVE_LOCKS_REQUIRED(shard.mutex_);
+
+  static uint64_t entrySize(const Key& key, const Entry& entry);
+  static Entry copyEntry(const Entry& entry);
 
   // A list of headers that we do not want to update upon validation
   // We skip these headers because either it's updated by other application logic
@@ -33,6 +95,10 @@ private:
   static const absl::flat_hash_set<Http::LowerCaseString> headersNotToUpdate();
 
 public:
+  SimpleHttpCache(
+      const envoy::extensions::http::cache::simple_http_cache::v3::SimpleHttpCacheConfig& config,
+      Stats::Scope& scope);
+
   // HttpCache
   LookupContextPtr makeLookupContext(LookupRequest&& request,
                                      Http::StreamDecoderFilterCallbacks& callbacks) override;
@@ -55,8 +121,19 @@ public:
                   const Http::RequestHeaderMap& request_headers,
                   const VaryAllowList& vary_allow_list, Http::ResponseTrailerMapPtr&& trailers);
 
-  absl::Mutex mutex_;
-  absl::flat_hash_map<Key, Entry, MessageUtil, MessageUtil> map_ ABSL_GUARDED_BY(mutex_);
+  const SimpleHttpCacheStats& stats() const { return stats_; }
+
+  // Returns whether the cache was created with the same shard count and byte budget as config.
+  bool isConfiguredAs(
+      const envoy::extensions::http::cache::simple_http_cache::v3::SimpleHttpCacheConfig& config)
+      const;
+
+private:
+  SimpleHttpCacheStats stats_;
+  // Byte budget of the cache, and of each shard; 0 means unbounded.
+  const uint64_t max_bytes_;
+  const uint64_t max_bytes_per_shard_;
+  std::vector<std::unique_ptr<Shard>> shards_;
 };
 
 } // namespace Cache
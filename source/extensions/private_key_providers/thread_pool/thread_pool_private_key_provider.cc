@@ -0,0 +1,331 @@
+#include "source/extensions/private_key_providers/thread_pool/thread_pool_private_key_provider.h"
+
+#include <algorithm>
+#include <memory>
+
+#include "source/common/common/assert.h"
+#include "source/common/common/macros.h"
+#include "source/common/config/datasource.h"
+#include "source/common/protobuf/utility.h"
+
+#include "openssl/pem.h"
+#include "openssl/ssl.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace PrivateKeyMethodProvider {
+namespace ThreadPool {
+
+namespace {
+
+constexpr uint32_t DefaultThreadCount = 2;
+constexpr uint32_t DefaultMaxQueueDepth = 1024;
+
+ThreadPoolPrivateKeyConnection* getConnection(SSL* ssl) {
+  return ssl == nullptr ? nullptr
+                        : static_cast<ThreadPoolPrivateKeyConnection*>(SSL_get_ex_data(
+                              ssl, ThreadPoolPrivateKeyMethodProvider::connectionIndex()));
+}
+
+bool sign(EVP_PKEY* pkey, const EVP_MD* md, bool rsa_pss, const std::vector<uint8_t>& in,
+          std::vector<uint8_t>& out) {
+  bssl::ScopedEVP_MD_CTX ctx;
+  EVP_PKEY_CTX* pctx;
+  if (!EVP_DigestSignInit(ctx.get(), &pctx, md, nullptr, pkey)) {
+    return false;
+  }
+  if (rsa_pss && (!EVP_PKEY_CTX_set_rsa_padding(pctx, RSA_PKCS1_PSS_PADDING) ||
+                  // A salt length equal to the digest length, as TLS 1.3 requires.
+                  !EVP_PKEY_CTX_set_rsa_pss_saltlen(pctx, -1))) {
+    return false;
+  }
+  size_t out_len = EVP_PKEY_size(pkey);
+  out.resize(out_len);
+  if (!EVP_DigestSign(ctx.get(), out.data(), &out_len, in.data(), in.size())) {
+    return false;
+  }
+  out.resize(out_len);
+  return true;
+}
+
+bool decrypt(EVP_PKEY* pkey, const std::vector<uint8_t>& in, std::vector<uint8_t>& out) {
+  RSA* rsa = EVP_PKEY_get0_RSA(pkey);
+  if (rsa == nullptr) {
+    return false;
+  }
+  size_t out_len;
+  out.resize(RSA_size(rsa));
+  if (!RSA_decrypt(rsa, &out_len, out.data(), out.size(), in.data(), in.size(), RSA_NO_PADDING)) {
+    return false;
+  }
+  out.resize(out_len);
+  return true;
+}
+
+ssl_private_key_result_t privateKeySign(SSL* ssl, uint8_t*, size_t*, size_t,
+                                        uint16_t signature_algorithm, const uint8_t* in,
+                                        size_t in_len) {
+  ThreadPoolPrivateKeyConnection* ops = getConnection(ssl);
+  if (ops == nullptr ||
+      EVP_PKEY_id(ops->privateKey()) != SSL_get_signature_algorithm_key_type(signature_algorithm)) {
+    return ssl_private_key_failure;
+  }
+  const EVP_MD* md = SSL_get_signature_algorithm_digest(signature_algorithm);
+  if (md == nullptr) {
+    return ssl_private_key_failure;
+  }
+  const bool rsa_pss = SSL_is_signature_algorithm_rsa_pss(signature_algorithm);
+  return ops->startOperation(
+             [md, rsa_pss](EVP_PKEY* pkey, const std::vector<uint8_t>& in,
+                           std::vector<uint8_t>& out) { return sign(pkey, md, rsa_pss, in, out); },
+             in, in_len)
+             ? ssl_private_key_retry
+             : ssl_private_key_failure;
+}
+
+ssl_private_key_result_t privateKeyDecrypt(SSL* ssl, uint8_t*, size_t*, size_t, const uint8_t* in,
+                                           size_t in_len) {
+  ThreadPoolPrivateKeyConnection* ops = getConnection(ssl);
+  if (ops == nullptr || EVP_PKEY_id(ops->privateKey()) != EVP_PKEY_RSA) {
+    return ssl_private_key_failure;
+  }
+  return ops->startOperation(decrypt, in, in_len) ? ssl_private_key_retry
+                                                  : ssl_private_key_failure;
+}
+
+ssl_private_key_result_t privateKeyComplete(SSL* ssl, uint8_t* out, size_t* out_len,
+                                            size_t max_out) {
+  ThreadPoolPrivateKeyConnection* ops = getConnection(ssl);
+  if (ops == nullptr || ops->operation() == nullptr) {
+    return ssl_private_key_failure;
+  }
+
+  // The handshake may be driven by something else than the completion of the operation.
+  if (!ops->operation()->done_) {
+    return ssl_private_key_retry;
+  }
+
+  PrivateKeyOperationSharedPtr operation = std::move(ops->operation());
+  if (!operation->succeeded_ || operation->output_.size() > max_out) {
+    return ssl_private_key_failure;
+  }
+  std::copy(operation->output_.begin(), operation->output_.end(), out);
+  *out_len = operation->output_.size();
+  return ssl_private_key_success;
+}
+
+int createIndex() {
+  int index = SSL_get_ex_new_index(0, nullptr, nullptr, nullptr, nullptr);
+  RELEASE_ASSERT(index >= 0, "Failed to get SSL user data index.");
+  return index;
+}
+
+} // namespace
+
+SINGLETON_MANAGER_REGISTRATION(private_key_thread_pool_manager);
+
+PrivateKeyThreadPool::PrivateKeyThreadPool(Thread::ThreadFactory& thread_factory,
+                                           uint32_t thread_count) {
+  ENVOY_LOG(debug, "creating private key thread pool with {} threads", thread_count);
+  const Thread::Options options{"pkey_pool"};
+  threads_.reserve(thread_count);
+  while (threads_.size() < thread_count) {
+    threads_.push_back(thread_factory.createThread([this]() { run(); }, options));
+  }
+}
+
+PrivateKeyThreadPool::~PrivateKeyThreadPool() {
+  {
+    absl::MutexLock lock(&mutex_);
+    // The providers cancel their operations before releasing the pool.
+    ASSERT(queue_.empty());
+    terminate_ = true;
+  }
+  for (Thread::ThreadPtr& thread : threads_) {
+    thread->join();
+  }
+}
+
+void PrivateKeyThreadPool::post(const void* owner, std::function<void()> operation) {
+  absl::MutexLock lock(&mutex_);
+  queue_.emplace_back(owner, std::move(operation));
+}
+
+uint32_t PrivateKeyThreadPool::cancel(const void* owner) {
+  absl::MutexLock lock(&mutex_);
+  const auto it = std::remove_if(queue_.begin(), queue_.end(),
+                                 [owner](const auto& queued) { return queued.first == owner; });
+  const auto dropped = static_cast<uint32_t>(queue_.end() - it);
+  queue_.erase(it, queue_.end());
+  const auto condition = [this, owner]() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_) {
+    return !running_.contains(owner);
+  };
+  mutex_.Await(absl::Condition(&condition));
+  return dropped;
+}
+
+void PrivateKeyThreadPool::run() {
+  while (true) {
+    const void* owner;
+    std::function<void()> operation;
+    {
+      const auto condition = [this]() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_) {
+        return !queue_.empty() || terminate_;
+      };
+      absl::MutexLock lock(&mutex_);
+      mutex_.Await(absl::Condition(&condition));
+      if (terminate_) {
+        return;
+      }
+      owner = queue_.front().first;
+      operation = std::move(queue_.front().second);
+      queue_.pop_front();
+      ++running_[owner];
+    }
+    operation();
+    absl::MutexLock lock(&mutex_);
+    if (--running_[owner] == 0) {
+      running_.erase(owner);
+    }
+  }
+}
+
+PrivateKeyThreadPoolSharedPtr PrivateKeyThreadPoolManager::getPool(uint32_t thread_count) {
+  PrivateKeyThreadPoolSharedPtr pool = pools_[thread_count].lock();
+  if (pool == nullptr) {
+    pool = std::make_shared<PrivateKeyThreadPool>(thread_factory_, thread_count);
+    pools_[thread_count] = pool;
+  }
+  return pool;
+}
+
+ThreadPoolPrivateKeyConnection::ThreadPoolPrivateKeyConnection(
+    Ssl::PrivateKeyConnectionCallbacks& cb, Event::Dispatcher& dispatcher,
+    ThreadPoolPrivateKeyMethodProvider& provider, bssl::UniquePtr<EVP_PKEY> pkey)
+    : cb_(cb), dispatcher_(dispatcher), provider_(provider), pkey_(std::move(pkey)) {}
+
+ThreadPoolPrivateKeyConnection::~ThreadPoolPrivateKeyConnection() {
+  if (operation_ != nullptr) {
+    operation_->cancel();
+  }
+}
+
+bool ThreadPoolPrivateKeyConnection::startOperation(PrivateKeyOperationFn fn, const uint8_t* in,
+                                                    size_t in_len) {
+  ASSERT(dispatcher_.isThreadSafe());
+  auto operation =
+      std::make_shared<PrivateKeyOperation>(*this, dispatcher_, bssl::UpRef(pkey_), in, in_len);
+  // The provider outlives its operations, as it cancels them when it goes away.
+  const bool queued = provider_.post([operation, fn = std::move(fn),
+                                      stats = &provider_.stats()]() {
+    if (!operation->cancelled()) {
+      stats->operations_.inc();
+      operation->succeeded_ = fn(operation->pkey_.get(), operation->input_, operation->output_);
+      if (!operation->succeeded_) {
+        stats->operation_failures_.inc();
+      }
+    }
+    // The connection is only touched on its worker thread, where it is also destroyed.
+    absl::MutexLock lock(&operation->mutex_);
+    if (operation->dispatcher_ == nullptr) {
+      return;
+    }
+    operation->dispatcher_->post([operation]() {
+      if (operation->cancelled()) {
+        return;
+      }
+      operation->done_ = true;
+      operation->connection_.onOperationComplete();
+    });
+  });
+  if (!queued) {
+    return false;
+  }
+  operation_ = std::move(operation);
+  return true;
+}
+
+ThreadPoolPrivateKeyMethodProvider::ThreadPoolPrivateKeyMethodProvider(
+    const envoy::extensions::private_key_providers::thread_pool::v3::
+        ThreadPoolPrivateKeyMethodConfig& config,
+    Api::Api& api, Singleton::Manager& singleton_manager, Stats::Scope& scope)
+    : stats_({ALL_THREAD_POOL_PRIVATE_KEY_STATS(
+          POOL_COUNTER_PREFIX(scope, "thread_pool_private_key_provider."),
+          POOL_GAUGE_PREFIX(scope, "thread_pool_private_key_provider."))}) {
+  const std::string private_key = Config::DataSource::read(config.private_key(), false, api);
+  bssl::UniquePtr<BIO> bio(BIO_new_mem_buf(private_key.data(), private_key.size()));
+  pkey_.reset(PEM_read_bio_PrivateKey(bio.get(), nullptr, nullptr, nullptr));
+  if (pkey_ == nullptr) {
+    throw EnvoyException("Failed to read private key.");
+  }
+  if (EVP_PKEY_id(pkey_.get()) != EVP_PKEY_RSA && EVP_PKEY_id(pkey_.get()) != EVP_PKEY_EC) {
+    throw EnvoyException("Not supported key type, only EC and RSA are supported.");
+  }
+
+  method_ = std::make_shared<SSL_PRIVATE_KEY_METHOD>();
+  method_->sign = privateKeySign;
+  method_->decrypt = privateKeyDecrypt;
+  method_->complete = privateKeyComplete;
+
+  max_queue_depth_ = PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, max_queue_depth, DefaultMaxQueueDepth);
+  pool_manager_ = singleton_manager.getTyped<PrivateKeyThreadPoolManager>(
+      SINGLETON_MANAGER_REGISTERED_NAME(private_key_thread_pool_manager), [&api] {
+        return std::make_shared<PrivateKeyThreadPoolManager>(api.threadFactory());
+      });
+  pool_ = pool_manager_->getPool(
+      PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, thread_count, DefaultThreadCount));
+}
+
+ThreadPoolPrivateKeyMethodProvider::~ThreadPoolPrivateKeyMethodProvider() {
+  // The connections are gone, as they keep the provider alive, so their queued operations are
+  // dropped. Those already running are waited for, as they use the stats of the provider.
+  stats_.queue_depth_.sub(pool_->cancel(this));
+}
+
+bool ThreadPoolPrivateKeyMethodProvider::post(std::function<void()> operation) {
+  if (queue_depth_.fetch_add(1) >= max_queue_depth_) {
+    --queue_depth_;
+    stats_.overflow_.inc();
+    return false;
+  }
+  stats_.queue_depth_.inc();
+  pool_->post(this, [this, operation = std::move(operation)]() {
+    --queue_depth_;
+    stats_.queue_depth_.dec();
+    operation();
+  });
+  return true;
+}
+
+void ThreadPoolPrivateKeyMethodProvider::registerPrivateKeyMethod(
+    SSL* ssl, Ssl::PrivateKeyConnectionCallbacks& cb, Event::Dispatcher& dispatcher) {
+  if (SSL_get_ex_data(ssl, connectionIndex()) != nullptr) {
+    throw EnvoyException("Not registering the thread pool provider twice for same context");
+  }
+  SSL_set_ex_data(ssl, connectionIndex(),
+                  new ThreadPoolPrivateKeyConnection(cb, dispatcher, *this, bssl::UpRef(pkey_)));
+}
+
+void ThreadPoolPrivateKeyMethodProvider::unregisterPrivateKeyMethod(SSL* ssl) {
+  auto* ops = static_cast<ThreadPoolPrivateKeyConnection*>(SSL_get_ex_data(ssl, connectionIndex()));
+  SSL_set_ex_data(ssl, connectionIndex(), nullptr);
+  delete ops;
+}
+
+bool ThreadPoolPrivateKeyMethodProvider::checkFips() {
+  if (EVP_PKEY_id(pkey_.get()) == EVP_PKEY_RSA) {
+    RSA* rsa = EVP_PKEY_get0_RSA(pkey_.get());
+    return rsa != nullptr && RSA_check_fips(rsa);
+  }
+  const EC_KEY* ec_key = EVP_PKEY_get0_EC_KEY(pkey_.get());
+  return ec_key != nullptr && EC_KEY_check_fips(ec_key);
+}
+
+int ThreadPoolPrivateKeyMethodProvider::connectionIndex() {
+  CONSTRUCT_ON_FIRST_USE(int, createIndex());
+}
+
+} // namespace ThreadPool
+} // namespace PrivateKeyMethodProvider
+} // namespace Extensions
+} // namespace Envoy
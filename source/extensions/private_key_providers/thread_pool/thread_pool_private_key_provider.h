@@ -0,0 +1,250 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "envoy/api/api.h"
+#include "envoy/event/dispatcher.h"
+#include "envoy/extensions/private_key_providers/thread_pool/v3/thread_pool.pb.h"
+#include "envoy/singleton/instance.h"
+#include "envoy/singleton/manager.h"
+#include "envoy/ssl/private_key/private_key.h"
+#include "envoy/ssl/private_key/private_key_config.h"
+#include "envoy/stats/scope.h"
+#include "envoy/stats/stats_macros.h"
+#include "envoy/thread/thread.h"
+
+#include "source/common/common/logger.h"
+
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/synchronization/mutex.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace PrivateKeyMethodProvider {
+namespace ThreadPool {
+
+/**
+ * All thread pool private key provider stats. @see stats_macros.h
+ */
+#define ALL_THREAD_POOL_PRIVATE_KEY_STATS(COUNTER, GAUGE)                                          \
+  COUNTER(operations)                                                                              \
+  COUNTER(operation_failures)                                                                      \
+  COUNTER(overflow)                                                                                \
+  GAUGE(queue_depth, Accumulate)
+
+/**
+ * Struct definition for all thread pool private key provider stats. @see stats_macros.h
+ */
+struct ThreadPoolPrivateKeyStats {
+  ALL_THREAD_POOL_PRIVATE_KEY_STATS(GENERATE_COUNTER_STRUCT, GENERATE_GAUGE_STRUCT)
+};
+
+/**
+ * A fixed set of threads which run the operations posted to it in order. A pool is shared by the
+ * providers with the same number of threads, which each bound the number of their operations
+ * waiting in the queue.
+ */
+class PrivateKeyThreadPool : Logger::Loggable<Logger::Id::connection> {
+public:
+  PrivateKeyThreadPool(Thread::ThreadFactory& thread_factory, uint32_t thread_count);
+  ~PrivateKeyThreadPool() ABSL_LOCKS_EXCLUDED(mutex_);
+
+  /**
+   * Queues an operation to be run by one of the threads of the pool.
+   * @param owner supplies the owner of the operation, which may cancel it.
+   * @param operation supplies the operation.
+   */
+  void post(const void* owner, std::function<void()> operation) ABSL_LOCKS_EXCLUDED(mutex_);
+
+  /**
+   * Drops the queued operations of an owner, and waits for those that are running to return.
+   * @param owner supplies the owner of the operations.
+   * @return the number of operations dropped.
+   */
+  uint32_t cancel(const void* owner) ABSL_LOCKS_EXCLUDED(mutex_);
+
+private:
+  void run() ABSL_LOCKS_EXCLUDED(mutex_);
+
+  absl::Mutex mutex_;
+  std::deque<std::pair<const void*, std::function<void()>>> queue_ ABSL_GUARDED_BY(mutex_);
+  // The number of running operations of each owner.
+  absl::flat_hash_map<const void*, uint32_t> running_ ABSL_GUARDED_BY(mutex_);
+  bool terminate_ ABSL_GUARDED_BY(mutex_){};
+  std::vector<Thread::ThreadPtr> threads_;
+};
+
+using PrivateKeyThreadPoolSharedPtr = std::shared_ptr<PrivateKeyThreadPool>;
+
+/**
+ * Creates the pools shared by the providers, on the main thread. A pool lives as long as a provider
+ * uses it.
+ */
+class PrivateKeyThreadPoolManager : public Singleton::Instance {
+public:
+  explicit PrivateKeyThreadPoolManager(Thread::ThreadFactory& thread_factory)
+      : thread_factory_(thread_factory) {}
+
+  /**
+   * @return the pool with the given number of threads, which is created if it does not exist yet.
+   */
+  PrivateKeyThreadPoolSharedPtr getPool(uint32_t thread_count);
+
+private:
+  Thread::ThreadFactory& thread_factory_;
+  absl::flat_hash_map<uint32_t, std::weak_ptr<PrivateKeyThreadPool>> pools_;
+};
+
+using PrivateKeyThreadPoolManagerSharedPtr = std::shared_ptr<PrivateKeyThreadPoolManager>;
+
+class ThreadPoolPrivateKeyConnection;
+class ThreadPoolPrivateKeyMethodProvider;
+
+/**
+ * A sign or decrypt operation of a connection. The input is set on the worker thread, the result
+ * by a thread of the pool, and the operation is then handed back to the worker thread.
+ */
+struct PrivateKeyOperation {
+  PrivateKeyOperation(ThreadPoolPrivateKeyConnection& connection, Event::Dispatcher& dispatcher,
+                      bssl::UniquePtr<EVP_PKEY> pkey, const uint8_t* in, size_t in_len)
+      : connection_(connection), pkey_(std::move(pkey)), input_(in, in + in_len),
+        dispatcher_(&dispatcher) {}
+
+  /**
+   * Called on the worker thread when the connection goes away.
+   */
+  void cancel() ABSL_LOCKS_EXCLUDED(mutex_) {
+    absl::MutexLock lock(&mutex_);
+    dispatcher_ = nullptr;
+  }
+
+  bool cancelled() ABSL_LOCKS_EXCLUDED(mutex_) {
+    absl::MutexLock lock(&mutex_);
+    return dispatcher_ == nullptr;
+  }
+
+  // Only valid until the operation is cancelled.
+  ThreadPoolPrivateKeyConnection& connection_;
+  const bssl::UniquePtr<EVP_PKEY> pkey_;
+  const std::vector<uint8_t> input_;
+  absl::Mutex mutex_;
+  // The dispatcher of the worker thread of the connection. Cleared when the connection goes away,
+  // which happens on that thread before it exits, so that the pool skips the operation and never
+  // posts to a dispatcher which may be gone.
+  Event::Dispatcher* dispatcher_ ABSL_GUARDED_BY(mutex_);
+  std::vector<uint8_t> output_;
+  bool succeeded_{};
+  // Only accessed on the worker thread.
+  bool done_{};
+};
+
+using PrivateKeyOperationSharedPtr = std::shared_ptr<PrivateKeyOperation>;
+
+/**
+ * Runs an operation on a thread of the pool.
+ * @param pkey supplies the private key.
+ * @param in supplies the input of the operation.
+ * @param out receives the output of the operation.
+ * @return whether the operation succeeded.
+ */
+using PrivateKeyOperationFn =
+    std::function<bool(EVP_PKEY* pkey, const std::vector<uint8_t>& in, std::vector<uint8_t>& out)>;
+
+/**
+ * The state of an SSL connection registered with the provider, which lives on its worker thread.
+ */
+class ThreadPoolPrivateKeyConnection {
+public:
+  ThreadPoolPrivateKeyConnection(Ssl::PrivateKeyConnectionCallbacks& cb,
+                                 Event::Dispatcher& dispatcher,
+                                 ThreadPoolPrivateKeyMethodProvider& provider,
+                                 bssl::UniquePtr<EVP_PKEY> pkey);
+  ~ThreadPoolPrivateKeyConnection();
+
+  /**
+   * Hands an operation to the pool. The connection callbacks are invoked on the worker thread once
+   * it is done, unless the connection is gone by then.
+   * @param fn supplies the operation to run on a thread of the pool.
+   * @param in supplies the input of the operation.
+   * @param in_len supplies the length of the input.
+   * @return false if the pool is overloaded.
+   */
+  bool startOperation(PrivateKeyOperationFn fn, const uint8_t* in, size_t in_len);
+
+  /**
+   * Called on the worker thread once the pool is done with the operation of the connection.
+   */
+  void onOperationComplete() { cb_.onPrivateKeyMethodComplete(); }
+
+  EVP_PKEY* privateKey() { return pkey_.get(); }
+
+  /**
+   * @return the operation of the connection, if any.
+   */
+  PrivateKeyOperationSharedPtr& operation() { return operation_; }
+
+private:
+  Ssl::PrivateKeyConnectionCallbacks& cb_;
+  Event::Dispatcher& dispatcher_;
+  ThreadPoolPrivateKeyMethodProvider& provider_;
+  bssl::UniquePtr<EVP_PKEY> pkey_;
+  PrivateKeyOperationSharedPtr operation_;
+};
+
+/**
+ * A private key method provider which runs the private key operations of TLS handshakes on a
+ * thread pool rather than on the worker threads, where a 2048 bit RSA signature takes
+ * milliseconds of the event loop.
+ */
+class ThreadPoolPrivateKeyMethodProvider : public virtual Ssl::PrivateKeyMethodProvider,
+                                           public Logger::Loggable<Logger::Id::connection> {
+public:
+  ThreadPoolPrivateKeyMethodProvider(
+      const envoy::extensions::private_key_providers::thread_pool::v3::
+          ThreadPoolPrivateKeyMethodConfig& config,
+      Api::Api& api, Singleton::Manager& singleton_manager, Stats::Scope& scope);
+  ~ThreadPoolPrivateKeyMethodProvider() override;
+
+  /**
+   * Queues an operation on the pool, unless too many operations of the provider are queued already.
+   * @param operation supplies the operation.
+   * @return false if the queue of the provider is full, in which case the operation is dropped.
+   */
+  bool post(std::function<void()> operation);
+
+  ThreadPoolPrivateKeyStats& stats() { return stats_; }
+
+  // Ssl::PrivateKeyMethodProvider
+  void registerPrivateKeyMethod(SSL* ssl, Ssl::PrivateKeyConnectionCallbacks& cb,
+                                Event::Dispatcher& dispatcher) override;
+  void unregisterPrivateKeyMethod(SSL* ssl) override;
+  bool checkFips() override;
+  bool isAvailable() override { return true; }
+  Ssl::BoringSslPrivateKeyMethodSharedPtr getBoringSslPrivateKeyMethod() override {
+    return method_;
+  }
+
+  static int connectionIndex();
+
+private:
+  bssl::UniquePtr<EVP_PKEY> pkey_;
+  Ssl::BoringSslPrivateKeyMethodSharedPtr method_;
+  ThreadPoolPrivateKeyStats stats_;
+  uint32_t max_queue_depth_{};
+  // The number of operations of the provider waiting in the queue of the pool.
+  std::atomic<uint32_t> queue_depth_{};
+  // Kept so that providers created later share the pools of this one.
+  PrivateKeyThreadPoolManagerSharedPtr pool_manager_;
+  PrivateKeyThreadPoolSharedPtr pool_;
+};
+
+} // namespace ThreadPool
+} // namespace PrivateKeyMethodProvider
+} // namespace Extensions
+} // namespace Envoy
@@ -440,6 +440,15 @@ ServerContextConfigImpl::ServerContextConfigImpl(
     session_timeout_ =
         std::chrono::seconds(DurationUtil::durationToSeconds(config.session_timeout()));
   }
+
+  if (config.has_shared_session_cache() && !disable_stateful_session_resumption_) {
+    Server::Configuration::ServerFactoryContext& server_context =
+        factory_context.serverFactoryContext();
+    session_cache_manager_ = getSessionCacheManager(
+        server_context.singletonManager(), server_context.mainThreadDispatcher(),
+        server_context.api().fileSystem(), server_context.timeSource());
+    shared_session_cache_ = session_cache_manager_->getCache(config.shared_session_cache());
+  }
 }
 
 void ServerContextConfigImpl::setSecretUpdateCallback(std::function<void()> callback) {
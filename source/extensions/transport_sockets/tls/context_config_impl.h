@@ -12,6 +12,7 @@
 #include "source/common/common/empty_string.h"
 #include "source/common/json/json_loader.h"
 #include "source/common/ssl/tls_certificate_config_impl.h"
+#include "source/extensions/transport_sockets/tls/session_cache_impl.h"
 
 namespace Envoy {
 namespace Extensions {
@@ -168,6 +169,7 @@ public:
   bool disableStatefulSessionResumption() const override {
     return disable_stateful_session_resumption_;
   }
+  Ssl::SessionCacheSharedPtr sharedSessionCache() const override { return shared_session_cache_; }
 
   bool fullScanCertsOnSNIMismatch() const override { return full_scan_certs_on_sni_mismatch_; }
 
@@ -195,6 +197,8 @@ private:
   const bool disable_stateless_session_resumption_;
   const bool disable_stateful_session_resumption_;
   bool full_scan_certs_on_sni_mismatch_;
+  SessionCacheManagerImplSharedPtr session_cache_manager_;
+  Ssl::SessionCacheSharedPtr shared_session_cache_;
 };
 
 } // namespace Tls
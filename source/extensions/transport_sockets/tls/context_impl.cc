@@ -786,6 +786,7 @@ ServerContextImpl::ServerContextImpl(Stats::Scope& scope,
                                      TimeSource& time_source)
     : ContextImpl(scope, config, time_source), session_ticket_keys_(config.sessionTicketKeys()),
       ocsp_staple_policy_(config.ocspStaplePolicy()),
+      session_cache_(config.sharedSessionCache()),
       full_scan_certs_on_sni_mismatch_(config.fullScanCertsOnSNIMismatch()) {
   if (config.tlsCertificates().empty() && !config.capabilities().provides_certificates) {
     throwEnvoyExceptionOrPanic("Server TlsCertificates must have a certificate specified");
@@ -860,6 +861,28 @@ ServerContextImpl::ServerContextImpl(Stats::Scope& scope,
 
     if (config.disableStatefulSessionResumption()) {
       SSL_CTX_set_session_cache_mode(ctx.ssl_ctx_.get(), SSL_SESS_CACHE_OFF);
+    } else if (session_cache_ != nullptr && !config.capabilities().handles_session_resumption) {
+      // Keep the sessions only in the shared cache. BoringSSL still checks that a session found
+      // there was established with the same session ID context, i.e. the same certificates and
+      // server names.
+      SSL_CTX_set_session_cache_mode(ctx.ssl_ctx_.get(),
+                                     SSL_SESS_CACHE_SERVER | SSL_SESS_CACHE_NO_INTERNAL);
+      SSL_CTX_sess_set_new_cb(ctx.ssl_ctx_.get(), [](SSL* ssl, SSL_SESSION* session) -> int {
+        return static_cast<ServerContextImpl*>(SSL_CTX_get_app_data(SSL_get_SSL_CTX(ssl)))
+            ->newSession(session);
+      });
+      SSL_CTX_sess_set_get_cb(ctx.ssl_ctx_.get(),
+                              [](SSL* ssl, const uint8_t* session_id, int session_id_length,
+                                 int* out_copy) -> SSL_SESSION* {
+                                // The returned session is owned by BoringSSL.
+                                *out_copy = 0;
+                                return static_cast<ServerContextImpl*>(
+                                           SSL_CTX_get_app_data(SSL_get_SSL_CTX(ssl)))
+                                    ->getSession(ssl, session_id, session_id_length);
+                              });
+      SSL_CTX_sess_set_remove_cb(ctx.ssl_ctx_.get(), [](SSL_CTX* ssl_ctx, SSL_SESSION* session) {
+        static_cast<ServerContextImpl*>(SSL_CTX_get_app_data(ssl_ctx))->removeSession(session);
+      });
     }
 
     if (config.sessionTimeout() && !config.capabilities().handles_session_resumption) {
@@ -1050,6 +1073,44 @@ ServerContextImpl::generateHashForSessionContextId(const std::vector<std::string
   return session_id;
 }
 
+int ServerContextImpl::newSession(SSL_SESSION* session) {
+  unsigned int session_id_length = 0;
+  const uint8_t* session_id = SSL_SESSION_get_id(session, &session_id_length);
+  uint8_t* serialized;
+  size_t serialized_length;
+  if (session_id_length == 0 || !SSL_SESSION_to_bytes(session, &serialized, &serialized_length)) {
+    return 0;
+  }
+  bssl::UniquePtr<uint8_t> free_serialized(serialized);
+
+  const SystemTime expire_at{
+      std::chrono::seconds(SSL_SESSION_get_time(session) + SSL_SESSION_get_timeout(session))};
+  session_cache_->insert(
+      absl::string_view(reinterpret_cast<const char*>(session_id), session_id_length),
+      std::string(reinterpret_cast<const char*>(serialized), serialized_length), expire_at);
+  return 0; // Tell BoringSSL that we did not take ownership of the session.
+}
+
+SSL_SESSION* ServerContextImpl::getSession(SSL* ssl, const uint8_t* session_id,
+                                           int session_id_length) {
+  const absl::optional<std::string> serialized = session_cache_->lookup(
+      absl::string_view(reinterpret_cast<const char*>(session_id), session_id_length));
+  if (!serialized.has_value()) {
+    stats_.session_cache_miss_.inc();
+    return nullptr;
+  }
+  stats_.session_cache_hit_.inc();
+  return SSL_SESSION_from_bytes(reinterpret_cast<const uint8_t*>(serialized->data()),
+                                serialized->size(), SSL_get_SSL_CTX(ssl));
+}
+
+void ServerContextImpl::removeSession(SSL_SESSION* session) {
+  unsigned int session_id_length = 0;
+  const uint8_t* session_id = SSL_SESSION_get_id(session, &session_id_length);
+  session_cache_->remove(
+      absl::string_view(reinterpret_cast<const char*>(session_id), session_id_length));
+}
+
 int ServerContextImpl::sessionTicketProcess(SSL*, uint8_t* key_name, uint8_t* iv,
                                             EVP_CIPHER_CTX* ctx, HMAC_CTX* hmac_ctx, int encrypt) {
   const EVP_MD* hmac = EVP_sha256();
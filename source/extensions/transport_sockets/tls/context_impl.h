@@ -207,6 +207,9 @@ private:
                          unsigned int inlen);
   int sessionTicketProcess(SSL* ssl, uint8_t* key_name, uint8_t* iv, EVP_CIPHER_CTX* ctx,
                            HMAC_CTX* hmac_ctx, int encrypt);
+  int newSession(SSL_SESSION* session);
+  SSL_SESSION* getSession(SSL* ssl, const uint8_t* session_id, int session_id_length);
+  void removeSession(SSL_SESSION* session);
   bool isClientEcdsaCapable(const SSL_CLIENT_HELLO* ssl_client_hello);
   bool isClientOcspCapable(const SSL_CLIENT_HELLO* ssl_client_hello);
   OcspStapleAction ocspStapleAction(const TlsContext& ctx, bool client_ocsp_capable);
@@ -215,6 +218,7 @@ private:
 
   const std::vector<Envoy::Ssl::ServerContextConfig::SessionTicketKey> session_ticket_keys_;
   const Ssl::ServerContextConfig::OcspStaplePolicy ocsp_staple_policy_;
+  const Ssl::SessionCacheSharedPtr session_cache_;
   ServerNamesMap server_names_map_;
   bool has_rsa_{false};
   bool full_scan_certs_on_sni_mismatch_;
@@ -0,0 +1,261 @@
+#include "source/extensions/transport_sockets/tls/session_cache_impl.h"
+
+#include <cstdio>
+#include <cstring>
+
+#include "envoy/common/exception.h"
+
+#include "source/common/api/os_sys_calls_impl.h"
+#include "source/common/protobuf/utility.h"
+
+#include "absl/hash/hash.h"
+#include "absl/strings/str_cat.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace TransportSockets {
+namespace Tls {
+
+namespace {
+
+constexpr uint32_t DefaultMaxSessions = 20480;
+constexpr std::chrono::milliseconds DefaultPersistInterval{10000};
+
+// The serialized sessions are only read back by Envoy on the same host, so integers are written
+// in host byte order.
+template <class T> void appendInteger(std::string& out, T value) {
+  out.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+template <class T> bool readInteger(absl::string_view& in, T& value) {
+  if (in.size() < sizeof(value)) {
+    return false;
+  }
+  memcpy(&value, in.data(), sizeof(value));
+  in.remove_prefix(sizeof(value));
+  return true;
+}
+
+bool readString(absl::string_view& in, absl::string_view& value) {
+  uint32_t length;
+  if (!readInteger(in, length) || in.size() < length) {
+    return false;
+  }
+  value = in.substr(0, length);
+  in.remove_prefix(length);
+  return true;
+}
+
+} // namespace
+
+SessionCacheImpl::SessionCacheImpl(uint32_t max_sessions, TimeSource& time_source)
+    : max_shard_sessions_(std::max<uint32_t>(1, (max_sessions + NumShards - 1) / NumShards)),
+      time_source_(time_source) {}
+
+SessionCacheImpl::Shard& SessionCacheImpl::shard(absl::string_view session_id) {
+  return shards_[absl::Hash<absl::string_view>()(session_id) % NumShards];
+}
+
+void SessionCacheImpl::eraseLocked(Shard& shard,
+                                   absl::flat_hash_map<std::string, Session>::iterator it) {
+  shard.lru_.erase(it->second.lru_entry_);
+  shard.sessions_.erase(it);
+}
+
+void SessionCacheImpl::insert(absl::string_view session_id, std::string&& session,
+                              SystemTime expire_at) {
+  Shard& shard = this->shard(session_id);
+  absl::MutexLock lock(&shard.mutex_);
+  auto it = shard.sessions_.find(session_id);
+  if (it != shard.sessions_.end()) {
+    eraseLocked(shard, it);
+  } else if (shard.sessions_.size() >= max_shard_sessions_) {
+    eraseLocked(shard, shard.sessions_.find(shard.lru_.front()));
+  }
+  shard.lru_.emplace_back(session_id);
+  shard.sessions_.emplace(session_id, Session{std::move(session), expire_at,
+                                              std::prev(shard.lru_.end())});
+}
+
+absl::optional<std::string> SessionCacheImpl::lookup(absl::string_view session_id) {
+  Shard& shard = this->shard(session_id);
+  absl::MutexLock lock(&shard.mutex_);
+  auto it = shard.sessions_.find(session_id);
+  if (it == shard.sessions_.end()) {
+    return absl::nullopt;
+  }
+  if (it->second.expire_at_ <= time_source_.systemTime()) {
+    eraseLocked(shard, it);
+    return absl::nullopt;
+  }
+  return it->second.session_;
+}
+
+void SessionCacheImpl::remove(absl::string_view session_id) {
+  Shard& shard = this->shard(session_id);
+  absl::MutexLock lock(&shard.mutex_);
+  auto it = shard.sessions_.find(session_id);
+  if (it != shard.sessions_.end()) {
+    eraseLocked(shard, it);
+  }
+}
+
+std::string SessionCacheImpl::serializeSessions() {
+  const SystemTime now = time_source_.systemTime();
+  std::string out;
+  for (Shard& shard : shards_) {
+    absl::MutexLock lock(&shard.mutex_);
+    // Oldest first, so that loading the sessions keeps the same eviction order.
+    for (const std::string& session_id : shard.lru_) {
+      const Session& session = shard.sessions_.find(session_id)->second;
+      if (session.expire_at_ <= now) {
+        continue;
+      }
+      appendInteger<uint32_t>(out, session_id.size());
+      out.append(session_id);
+      appendInteger<int64_t>(out, std::chrono::duration_cast<std::chrono::seconds>(
+                                      session.expire_at_.time_since_epoch())
+                                      .count());
+      appendInteger<uint32_t>(out, session.session_.size());
+      out.append(session.session_);
+    }
+  }
+  return out;
+}
+
+uint32_t SessionCacheImpl::loadSessions(absl::string_view serialized) {
+  const SystemTime now = time_source_.systemTime();
+  uint32_t loaded = 0;
+  absl::string_view session_id;
+  int64_t expire_at_seconds;
+  absl::string_view session;
+  while (readString(serialized, session_id) && readInteger(serialized, expire_at_seconds) &&
+         readString(serialized, session)) {
+    const SystemTime expire_at{std::chrono::seconds(expire_at_seconds)};
+    if (expire_at <= now) {
+      continue;
+    }
+    insert(session_id, std::string(session), expire_at);
+    ++loaded;
+  }
+  return loaded;
+}
+
+SessionCacheManagerImpl::SessionCacheManagerImpl(Event::Dispatcher& main_thread_dispatcher,
+                                                 Filesystem::Instance& file_system,
+                                                 TimeSource& time_source)
+    : main_thread_dispatcher_(main_thread_dispatcher), file_system_(file_system),
+      time_source_(time_source) {}
+
+SessionCacheManagerImpl::~SessionCacheManagerImpl() {
+  // Write the latest sessions, e.g. when a hot restart parent exits.
+  for (auto& [name, active_cache] : caches_) {
+    persist(active_cache);
+  }
+}
+
+Ssl::SessionCacheSharedPtr SessionCacheManagerImpl::getCache(
+    const envoy::extensions::transport_sockets::tls::v3::TlsSharedSessionCache& config) {
+  ASSERT(main_thread_dispatcher_.isThreadSafe());
+  const uint32_t max_sessions =
+      PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, max_sessions, DefaultMaxSessions);
+  const std::chrono::milliseconds persist_interval(
+      PROTOBUF_GET_MS_OR_DEFAULT(config, persist_interval, DefaultPersistInterval.count()));
+  auto it = caches_.find(config.name());
+  if (it != caches_.end()) {
+    const ActiveCache& existing = it->second;
+    if (existing.max_sessions_ != max_sessions || existing.persist_path_ != config.persist_path() ||
+        existing.persist_interval_ != persist_interval) {
+      throw EnvoyException(
+          fmt::format("TLS session cache '{}' is configured with different settings by another "
+                      "context: max_sessions {} and {}, persist_path '{}' and '{}', "
+                      "persist_interval {}ms and {}ms",
+                      config.name(), existing.max_sessions_, max_sessions, existing.persist_path_,
+                      config.persist_path(), existing.persist_interval_.count(),
+                      persist_interval.count()));
+    }
+    return existing.cache_;
+  }
+
+  ActiveCache& active_cache = caches_[config.name()];
+  auto cache = std::make_shared<SessionCacheImpl>(max_sessions, time_source_);
+  active_cache.cache_ = cache;
+  active_cache.max_sessions_ = max_sessions;
+  active_cache.persist_path_ = config.persist_path();
+  active_cache.persist_interval_ = persist_interval;
+  if (active_cache.persist_path_.empty()) {
+    return cache;
+  }
+
+  // Resume the sessions of a hot restart parent, or of the previous run.
+  absl::StatusOr<std::string> serialized = file_system_.fileReadToEnd(active_cache.persist_path_);
+  if (serialized.ok()) {
+    const uint32_t loaded = cache->loadSessions(serialized.value());
+    ENVOY_LOG(info, "loaded {} sessions of TLS session cache '{}' from {}", loaded, config.name(),
+              active_cache.persist_path_);
+  } else {
+    ENVOY_LOG(warn, "failed to load the sessions of TLS session cache '{}' from {}: {}",
+              config.name(), active_cache.persist_path_, serialized.status().message());
+  }
+
+  // The map may move the ActiveCache, so the timer looks it up by name.
+  active_cache.persist_timer_ =
+      main_thread_dispatcher_.createTimer([this, name = config.name()]() {
+        ActiveCache& active_cache = caches_[name];
+        persist(active_cache);
+        active_cache.persist_timer_->enableTimer(active_cache.persist_interval_);
+      });
+  active_cache.persist_timer_->enableTimer(active_cache.persist_interval_);
+  return cache;
+}
+
+void SessionCacheManagerImpl::persist(ActiveCache& active_cache) {
+  // The file is not created if it does not exist, so that operators choose where the sessions go
+  // and who may read them.
+  if (active_cache.persist_path_.empty() || !file_system_.fileExists(active_cache.persist_path_)) {
+    return;
+  }
+
+  // The sessions are written to a file next to the persisted one, which is then renamed over it,
+  // so that a hot restart child or a crash never finds a truncated or partially written file.
+  const std::string tmp_path = absl::StrCat(active_cache.persist_path_, ".tmp");
+  static constexpr Filesystem::FlagSet PersistFlags{1 << Filesystem::File::Operation::Write |
+                                                    1 << Filesystem::File::Operation::Create};
+  Filesystem::FilePtr file =
+      file_system_.createFile({Filesystem::DestinationType::File, tmp_path});
+  if (!file || !file->open(PersistFlags).return_value_) {
+    ENVOY_LOG(warn, "failed to persist TLS sessions to {}: cannot open {}",
+              active_cache.persist_path_, tmp_path);
+    return;
+  }
+  // Envoy creates files readable by everyone, while the sessions must stay private.
+  bool written = Api::OsSysCallsSingleton::get().chmod(tmp_path, 0600).return_value_ == 0;
+  if (written) {
+    const std::string serialized = active_cache.cache_->serializeSessions();
+    const Api::IoCallSizeResult result = file->write(serialized);
+    written = result.return_value_ == static_cast<ssize_t>(serialized.size());
+  }
+  written = file->close().return_value_ && written;
+  if (!written || std::rename(tmp_path.c_str(), active_cache.persist_path_.c_str()) != 0) {
+    ENVOY_LOG(warn, "failed to persist TLS sessions to {}", active_cache.persist_path_);
+    std::remove(tmp_path.c_str());
+  }
+}
+
+SINGLETON_MANAGER_REGISTRATION(tls_session_cache_manager);
+
+SessionCacheManagerImplSharedPtr getSessionCacheManager(Singleton::Manager& singleton_manager,
+                                                        Event::Dispatcher& main_thread_dispatcher,
+                                                        Filesystem::Instance& file_system,
+                                                        TimeSource& time_source) {
+  return singleton_manager.getTyped<SessionCacheManagerImpl>(
+      SINGLETON_MANAGER_REGISTERED_NAME(tls_session_cache_manager), [&] {
+        return std::make_shared<SessionCacheManagerImpl>(main_thread_dispatcher, file_system,
+                                                         time_source);
+      });
+}
+
+} // namespace Tls
+} // namespace TransportSockets
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,132 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <string>
+
+#include "envoy/common/time.h"
+#include "envoy/event/dispatcher.h"
+#include "envoy/event/timer.h"
+#include "envoy/extensions/transport_sockets/tls/v3/tls.pb.h"
+#include "envoy/filesystem/filesystem.h"
+#include "envoy/singleton/instance.h"
+#include "envoy/singleton/manager.h"
+#include "envoy/ssl/session_cache.h"
+
+#include "source/common/common/logger.h"
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/synchronization/mutex.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace TransportSockets {
+namespace Tls {
+
+/**
+ * A session cache that is shared by every worker. To keep contention low, sessions are spread
+ * over several shards by session ID, each with a lock of its own, and each shard evicts its
+ * oldest sessions once it holds its share of the maximum number of sessions.
+ */
+class SessionCacheImpl : public Ssl::SessionCache {
+public:
+  SessionCacheImpl(uint32_t max_sessions, TimeSource& time_source);
+
+  // Ssl::SessionCache
+  void insert(absl::string_view session_id, std::string&& session, SystemTime expire_at) override;
+  absl::optional<std::string> lookup(absl::string_view session_id) override;
+  void remove(absl::string_view session_id) override;
+
+  /**
+   * @return the sessions that have not expired yet, serialized for loadSessions().
+   */
+  std::string serializeSessions();
+
+  /**
+   * Inserts the sessions that have not expired yet from the output of serializeSessions(). A
+   * truncated trailing session, e.g. because the output was read while being written, is ignored.
+   * @return the number of sessions inserted.
+   */
+  uint32_t loadSessions(absl::string_view serialized);
+
+  static constexpr uint32_t NumShards = 16;
+
+private:
+  struct Session {
+    std::string session_;
+    SystemTime expire_at_;
+    std::list<std::string>::iterator lru_entry_;
+  };
+
+  struct Shard {
+    absl::Mutex mutex_;
+    absl::flat_hash_map<std::string, Session> sessions_ ABSL_GUARDED_BY(mutex_);
+    // Session IDs from the oldest to the newest session.
+    std::list<std::string> lru_ ABSL_GUARDED_BY(mutex_);
+  };
+
+  Shard& shard(absl::string_view session_id);
+  void eraseLocked(Shard& shard, absl::flat_hash_map<std::string, Session>::iterator it)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(shard.mutex_);
+
+  const uint32_t max_shard_sessions_;
+  TimeSource& time_source_;
+  std::array<Shard, NumShards> shards_;
+};
+
+using SessionCacheImplSharedPtr = std::shared_ptr<SessionCacheImpl>;
+
+/**
+ * Creates the shared session caches and owns their persistence, on the main thread. The caches
+ * live as long as the manager, which is held by the configs of the contexts that share them.
+ */
+class SessionCacheManagerImpl : public Singleton::Instance,
+                                Logger::Loggable<Logger::Id::config> {
+public:
+  SessionCacheManagerImpl(Event::Dispatcher& main_thread_dispatcher,
+                          Filesystem::Instance& file_system, TimeSource& time_source);
+  ~SessionCacheManagerImpl() override;
+
+  /**
+   * @return the cache with the name of the config, which is created with the config if it does
+   *         not exist yet.
+   * @throw EnvoyException if the cache exists with a different max_sessions, persist_path or
+   *        persist_interval.
+   */
+  Ssl::SessionCacheSharedPtr
+  getCache(const envoy::extensions::transport_sockets::tls::v3::TlsSharedSessionCache& config);
+
+private:
+  struct ActiveCache {
+    SessionCacheImplSharedPtr cache_;
+    uint32_t max_sessions_{};
+    std::string persist_path_;
+    std::chrono::milliseconds persist_interval_{};
+    Event::TimerPtr persist_timer_;
+  };
+
+  void persist(ActiveCache& active_cache);
+
+  Event::Dispatcher& main_thread_dispatcher_;
+  Filesystem::Instance& file_system_;
+  TimeSource& time_source_;
+  absl::flat_hash_map<std::string, ActiveCache> caches_;
+};
+
+using SessionCacheManagerImplSharedPtr = std::shared_ptr<SessionCacheManagerImpl>;
+
+/**
+ * @return the process wide session cache manager.
+ */
+SessionCacheManagerImplSharedPtr getSessionCacheManager(Singleton::Manager& singleton_manager,
+                                                        Event::Dispatcher& main_thread_dispatcher,
+                                                        Filesystem::Instance& file_system,
+                                                        TimeSource& time_source);
+
+} // namespace Tls
+} // namespace TransportSockets
+} // namespace Extensions
+} // namespace Envoy
@@ -12,6 +12,8 @@ namespace Tls {
   COUNTER(connection_error)                                                                        \
   COUNTER(handshake)                                                                               \
   COUNTER(session_reused)                                                                          \
+  COUNTER(session_cache_hit)                                                                       \
+  COUNTER(session_cache_miss)                                                                      \
   COUNTER(no_certificate)                                                                          \
   COUNTER(fail_verify_no_cert)                                                                     \
   COUNTER(fail_verify_error)                                                                       \
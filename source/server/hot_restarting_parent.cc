@@ -169,8 +169,17 @@ HotRestartingParent::Internal::getListenSocketsForChild(const HotRestartMessage:
 void HotRestartingParent::Internal::exportStatsToChild(HotRestartMessage::Reply::Stats* stats) {
   server_->stats().forEachSinkedGauge(nullptr, [this, stats](Stats::Gauge& gauge) mutable {
     if (gauge.used()) {
+      const uint64_t value = gauge.value();
+      auto [it, inserted] = exported_gauges_.try_emplace(
+          gauge.statName(), ExportedGauge{Stats::GaugeSharedPtr(&gauge), value});
+      if (!inserted) {
+        if (it->second.value_ == value) {
+          return;
+        }
+        it->second.value_ = value;
+      }
       const std::string name = gauge.name();
-      (*stats->mutable_gauges())[name] = gauge.value();
+      (*stats->mutable_gauges())[name] = value;
       recordDynamics(stats, name, gauge.statName());
     }
   });
@@ -1,6 +1,9 @@
 #pragma once
 
+#include "envoy/stats/stats.h"
+
 #include "source/common/common/hash.h"
+#include "source/common/stats/symbol_table.h"
 #include "source/server/hot_restarting_base.h"
 
 namespace Envoy {
@@ -45,8 +48,17 @@ public:
     void handle(uint32_t worker_index, const Network::UdpRecvData& packet) override;
 
   private:
+    struct ExportedGauge {
+      // Holds a reference so that the StatName key remains valid.
+      Stats::GaugeSharedPtr gauge_;
+      uint64_t value_;
+    };
+
     Server::Instance* const server_{};
     HotRestartMessageSender& udp_sender_;
+    // The value of each gauge as of the last export, so that gauges which have not changed since
+    // then are not sent to the child again. The child retains the parent value it last received.
+    Stats::StatNameHashMap<ExportedGauge> exported_gauges_;
   };
 
 private:
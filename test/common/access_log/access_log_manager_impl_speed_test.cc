@@ -0,0 +1,57 @@
+// Note: this should be run with --compilation_mode=opt, and would benefit from a
+// quiescent system with disabled cstate power management.
+
+#include <string>
+#include <vector>
+
+#include "source/common/access_log/access_log_manager_impl.h"
+#include "source/common/common/thread.h"
+#include "source/common/stats/isolated_store_impl.h"
+
+#include "test/test_common/environment.h"
+#include "test/test_common/utility.h"
+
+#include "benchmark/benchmark.h"
+
+namespace Envoy {
+namespace AccessLog {
+namespace {
+
+// Measures writing access log lines to a single file from `state.range(0)` threads at once, as
+// happens when every worker logs every request.
+static void bmConcurrentWrites(benchmark::State& state) {
+  const uint32_t num_threads = state.range(0);
+  constexpr uint32_t lines_per_thread = 10000;
+  const std::string line(256, 'l');
+
+  Api::ApiPtr api = Api::createApiForTest();
+  Event::DispatcherPtr dispatcher = api->allocateDispatcher("test_thread");
+  Thread::MutexBasicLockable lock;
+  Stats::IsolatedStoreImpl store;
+  AccessLogManagerImpl access_log_manager(std::chrono::milliseconds(1000), *api, *dispatcher, lock,
+                                          store);
+  AccessLogFileSharedPtr log_file = access_log_manager.createAccessLog(
+      Filesystem::FilePathAndType{Filesystem::DestinationType::File,
+                                  TestEnvironment::temporaryPath("access_log_speed_test.log")});
+
+  for (auto _ : state) { // NOLINT
+    std::vector<Thread::ThreadPtr> threads;
+    for (uint32_t t = 0; t < num_threads; ++t) {
+      threads.push_back(api->threadFactory().createThread([&log_file, &line]() {
+        for (uint32_t i = 0; i < lines_per_thread; ++i) {
+          log_file->write(line);
+        }
+      }));
+    }
+    for (Thread::ThreadPtr& thread : threads) {
+      thread->join();
+    }
+  }
+  log_file->flush();
+  state.SetItemsProcessed(state.iterations() * num_threads * lines_per_thread);
+}
+BENCHMARK(bmConcurrentWrites)->Arg(1)->Arg(4)->Arg(16)->Unit(benchmark::kMillisecond);
+
+} // namespace
+} // namespace AccessLog
+} // namespace Envoy
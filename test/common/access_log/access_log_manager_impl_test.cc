@@ -11,6 +11,9 @@
 #include "test/test_common/test_time.h"
 #include "test/test_common/utility.h"
 
+#include "absl/strings/numbers.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_split.h"
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 
@@ -425,6 +428,58 @@ TEST_F(AccessLogManagerImplTest, BigDataChunkShouldBeFlushedWithoutTimer) {
   EXPECT_CALL(*file_, close_()).WillOnce(Return(ByMove(Filesystem::resultSuccess<bool>(true))));
 }
 
+// Writes from several threads are buffered separately. Verify that no data is lost and that each
+// thread's lines are written in order.
+TEST_F(AccessLogManagerImplTest, ConcurrentWritersKeepPerThreadOrder) {
+  new NiceMock<Event::MockTimer>(&dispatcher_);
+  EXPECT_CALL(*file_, open_(_)).WillOnce(Return(ByMove(Filesystem::resultSuccess<bool>(true))));
+  AccessLogFileSharedPtr log_file = access_log_manager_.createAccessLog(
+      Filesystem::FilePathAndType{Filesystem::DestinationType::File, "foo"});
+
+  std::string written;
+  EXPECT_CALL(*file_, write_(_))
+      .WillRepeatedly(Invoke([&written](absl::string_view data) -> Api::IoCallSizeResult {
+        written.append(data.data(), data.size());
+        return Filesystem::resultSuccess<ssize_t>(static_cast<ssize_t>(data.length()));
+      }));
+
+  constexpr uint32_t num_threads = 8;
+  constexpr uint32_t lines_per_thread = 1000;
+  std::vector<Thread::ThreadPtr> threads;
+  for (uint32_t t = 0; t < num_threads; ++t) {
+    threads.push_back(thread_factory_.createThread([&log_file, t]() {
+      for (uint32_t i = 0; i < lines_per_thread; ++i) {
+        log_file->write(absl::StrCat(t, ",", i, "\n"));
+      }
+    }));
+  }
+  for (Thread::ThreadPtr& thread : threads) {
+    thread->join();
+  }
+  log_file->flush();
+
+  std::vector<uint32_t> next_line(num_threads, 0);
+  {
+    absl::MutexLock lock(&file_->mutex_);
+    for (absl::string_view line : absl::StrSplit(written, '\n', absl::SkipEmpty())) {
+      const std::vector<absl::string_view> parts = absl::StrSplit(line, ',');
+      ASSERT_EQ(2, parts.size());
+      uint32_t thread_index;
+      uint32_t line_index;
+      ASSERT_TRUE(absl::SimpleAtoi(parts[0], &thread_index));
+      ASSERT_TRUE(absl::SimpleAtoi(parts[1], &line_index));
+      ASSERT_LT(thread_index, num_threads);
+      EXPECT_EQ(next_line[thread_index]++, line_index);
+    }
+  }
+  for (uint32_t t = 0; t < num_threads; ++t) {
+    EXPECT_EQ(lines_per_thread, next_line[t]);
+  }
+  EXPECT_EQ(num_threads * lines_per_thread, store_.counter("filesystem.write_buffered").value());
+
+  EXPECT_CALL(*file_, close_()).WillOnce(Return(ByMove(Filesystem::resultSuccess<bool>(true))));
+}
+
 TEST_F(AccessLogManagerImplTest, ReopenAllFiles) {
   EXPECT_CALL(dispatcher_, createTimer_(_)).WillRepeatedly(ReturnNew<NiceMock<Event::MockTimer>>());
 
@@ -1,13 +1,18 @@
 // Note: this should be run with --compilation_mode=opt, and would benefit from
 // a quiescent system with disabled cstate power management.
 
+#include <memory>
 #include <regex>
+#include <string>
+#include <vector>
 
 #include "source/common/common/assert.h"
 
+#include "absl/strings/str_cat.h"
 #include "absl/strings/string_view.h"
 #include "benchmark/benchmark.h"
 #include "re2/re2.h"
+#include "re2/set.h"
 
 // NOLINT(namespace-envoy)
 
@@ -126,3 +131,63 @@ static void BM_RE2_AltPattern(benchmark::State& state) {
   RELEASE_ASSERT(passes > 0, "");
 }
 BENCHMARK(BM_RE2_AltPattern);
+
+// The path regexes of a table of 500 regex routes, and paths which match the last one and none.
+static constexpr int NumRouteRegexes = 500;
+
+static std::vector<std::string> routeRegexes() {
+  std::vector<std::string> regexes;
+  for (int i = 0; i < NumRouteRegexes; ++i) {
+    regexes.push_back(absl::StrCat("/api/v[0-9]+/service", i, "/[^/]+/items/[0-9]+"));
+  }
+  return regexes;
+}
+
+static const std::string RoutePaths[] = {
+    absl::StrCat("/api/v2/service", NumRouteRegexes - 1, "/tenant/items/12345"),
+    "/static/assets/logo.png",
+};
+
+// Matches each route regex in turn, as a linear scan of a route table does.
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void BM_RE2_RouteTable(benchmark::State& state) {
+  std::vector<std::unique_ptr<re2::RE2>> regexes;
+  for (const std::string& regex : routeRegexes()) {
+    regexes.push_back(std::make_unique<re2::RE2>(regex));
+  }
+  uint32_t passes = 0;
+  for (auto _ : state) { // NOLINT
+    for (const std::string& path : RoutePaths) {
+      for (const auto& regex : regexes) {
+        if (re2::RE2::FullMatch(path, *regex)) {
+          ++passes;
+          break;
+        }
+      }
+    }
+  }
+  RELEASE_ASSERT(passes > 0, "");
+}
+BENCHMARK(BM_RE2_RouteTable);
+
+// Matches all the route regexes in a single pass, as the route index of a virtual host does.
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void BM_RE2Set_RouteTable(benchmark::State& state) {
+  re2::RE2::Set set(re2::RE2::DefaultOptions, re2::RE2::ANCHOR_BOTH);
+  for (const std::string& regex : routeRegexes()) {
+    RELEASE_ASSERT(set.Add(regex, nullptr) >= 0, "");
+  }
+  RELEASE_ASSERT(set.Compile(), "");
+  uint32_t passes = 0;
+  std::vector<int> matches;
+  for (auto _ : state) { // NOLINT
+    for (const std::string& path : RoutePaths) {
+      if (set.Match(path, &matches)) {
+        ASSERT(matches.size() == 1 && matches[0] == NumRouteRegexes - 1);
+        ++passes;
+      }
+    }
+  }
+  RELEASE_ASSERT(passes > 0, "");
+}
+BENCHMARK(BM_RE2Set_RouteTable);
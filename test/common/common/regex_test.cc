@@ -138,6 +138,38 @@ TEST(Utility, ParseRegex) {
   }
 }
 
+TEST(CompiledGoogleReSetMatcher, Match) {
+  const CompiledGoogleReSetMatcher matcher({"/api/.*", "/api/v[0-9]+", "/static/.*", "/api/v1"});
+  std::vector<int> matches;
+
+  EXPECT_TRUE(matcher.match("/api/v1", matches));
+  EXPECT_EQ((std::vector<int>{0, 1, 3}), matches);
+
+  // The regexes must match the whole value.
+  EXPECT_TRUE(matcher.match("/v1/api/v1", matches));
+  EXPECT_TRUE(matches.empty());
+
+  EXPECT_TRUE(matcher.match("/static/app.css", matches));
+  EXPECT_EQ((std::vector<int>{2}), matches);
+}
+
+TEST(CompiledGoogleReSetMatcher, InvalidRegex) {
+  EXPECT_THROW_WITH_MESSAGE(CompiledGoogleReSetMatcher({"/api/.*", "(+invalid)"}), EnvoyException,
+                            "regex '(+invalid)': no argument for repetition operator: +");
+}
+
+TEST(Utility, UsesGoogleRe) {
+  envoy::type::matcher::v3::RegexMatcher matcher;
+  matcher.set_regex("/api/.*");
+  {
+    ScopedInjectableLoader<Regex::Engine> engine(std::make_unique<Regex::GoogleReEngine>());
+    EXPECT_TRUE(Utility::usesGoogleRe(matcher));
+  }
+  EXPECT_FALSE(Utility::usesGoogleRe(matcher));
+  matcher.mutable_google_re2();
+  EXPECT_TRUE(Utility::usesGoogleRe(matcher));
+}
+
 } // namespace
 } // namespace Regex
 } // namespace Envoy
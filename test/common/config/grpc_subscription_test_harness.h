@@ -71,12 +71,13 @@ public:
         /*xds_config_tracker_=*/XdsConfigTrackerOptRef(),
         /*backoff_strategy_=*/std::move(backoff_strategy),
         /*target_xds_authority_=*/"",
-        /*eds_resources_cache_=*/nullptr};
+        /*eds_resources_cache_=*/nullptr,
+        /*thread_factory_=*/Thread::threadFactoryForTest()};
 
     if (should_use_unified_) {
-      mux_ = std::make_shared<Config::XdsMux::GrpcMuxSotw>(grpc_mux_context, true);
+      mux_ = std::make_shared<Config::XdsMux::GrpcMuxSotw>(grpc_mux_context, true, 0);
     } else {
-      mux_ = std::make_shared<Config::GrpcMuxImpl>(grpc_mux_context, true);
+      mux_ = std::make_shared<Config::GrpcMuxImpl>(grpc_mux_context, true, 0);
     }
     subscription_ = std::make_unique<GrpcSubscriptionImpl>(
         mux_, callbacks_, resource_decoder_, stats_, Config::TypeUrl::get().ClusterLoadAssignment,
@@ -77,6 +77,52 @@ TEST_F(OpaqueResourceDecoderImplTest, Success) {
   EXPECT_EQ("foo", result.second);
 }
 
+// Decoding in two steps gives the same result as decodeResource().
+TEST_F(OpaqueResourceDecoderImplTest, PreDecodeSuccess) {
+  envoy::config::endpoint::v3::ClusterLoadAssignment cluster_resource;
+  cluster_resource.set_cluster_name("foo");
+  ProtobufWkt::Any opaque_resource;
+  opaque_resource.PackFrom(cluster_resource);
+  auto pre_decoded = resource_decoder_.preDecodeResource(opaque_resource);
+  const auto decoded_resource = resource_decoder_.finishDecodeResource(std::move(pre_decoded));
+  EXPECT_THAT(*decoded_resource, ProtoEq(cluster_resource));
+}
+
+// Errors found while pre-decoding are only thrown by finishDecodeResource().
+TEST_F(OpaqueResourceDecoderImplTest, PreDecodeFail) {
+  {
+    ProtobufWkt::Any opaque_resource;
+    opaque_resource.set_type_url("huh");
+    auto pre_decoded = resource_decoder_.preDecodeResource(opaque_resource);
+    EXPECT_FALSE(pre_decoded.unpack_status_.ok());
+    EXPECT_THROW_WITH_REGEX(resource_decoder_.finishDecodeResource(std::move(pre_decoded)),
+                            EnvoyException, "Unable to unpack");
+  }
+  {
+    ProtobufWkt::Any opaque_resource;
+    opaque_resource.PackFrom(envoy::config::endpoint::v3::ClusterLoadAssignment());
+    auto pre_decoded = resource_decoder_.preDecodeResource(opaque_resource);
+    EXPECT_FALSE(pre_decoded.validation_error_.empty());
+    EXPECT_THROW(resource_decoder_.finishDecodeResource(std::move(pre_decoded)),
+                 ProtoValidationException);
+  }
+}
+
+// Unknown fields are reported by finishDecodeResource() before protoc-gen-validate errors, as
+// decodeResource() does.
+TEST_F(OpaqueResourceDecoderImplTest, PreDecodeUnknownFieldsBeforeValidation) {
+  envoy::config::endpoint::v3::ClusterLoadAssignment invalid_resource;
+  auto* unknown = invalid_resource.GetReflection()->MutableUnknownFields(&invalid_resource);
+  unknown->AddFixed32(1000, 1);
+  ProtobufWkt::Any opaque_resource;
+  opaque_resource.PackFrom(invalid_resource);
+  EXPECT_THROW_WITH_REGEX(resource_decoder_.decodeResource(opaque_resource), EnvoyException,
+                          "has unknown fields");
+  auto pre_decoded = resource_decoder_.preDecodeResource(opaque_resource);
+  EXPECT_THROW_WITH_REGEX(resource_decoder_.finishDecodeResource(std::move(pre_decoded)),
+                          EnvoyException, "has unknown fields");
+}
+
 } // namespace
 } // namespace Config
 } // namespace Envoy
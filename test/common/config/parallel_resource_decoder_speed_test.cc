@@ -0,0 +1,81 @@
+// Note: this should be run with --compilation_mode=opt, and would benefit from a
+// quiescent system with disabled cstate power management.
+
+#include <vector>
+
+#include "envoy/config/cluster/v3/cluster.pb.h"
+#include "envoy/config/cluster/v3/cluster.pb.validate.h"
+#include "envoy/service/discovery/v3/discovery.pb.h"
+
+#include "source/common/config/decoded_resource_impl.h"
+#include "source/common/config/opaque_resource_decoder_impl.h"
+#include "source/common/config/parallel_resource_decoder.h"
+#include "source/common/protobuf/message_validator_impl.h"
+
+#include "test/test_common/thread_factory_for_test.h"
+
+#include "absl/strings/str_cat.h"
+#include "benchmark/benchmark.h"
+
+namespace Envoy {
+namespace Config {
+namespace {
+
+// A CDS response with the given number of EDS clusters, each with a few commonly set options.
+envoy::service::discovery::v3::DiscoveryResponse cdsResponse(uint32_t num_clusters) {
+  envoy::service::discovery::v3::DiscoveryResponse response;
+  response.set_version_info("1");
+  for (uint32_t i = 0; i < num_clusters; ++i) {
+    envoy::config::cluster::v3::Cluster cluster;
+    cluster.set_name(absl::StrCat("cluster_", i));
+    cluster.set_type(envoy::config::cluster::v3::Cluster::EDS);
+    cluster.mutable_eds_cluster_config()->mutable_eds_config()->mutable_ads();
+    cluster.mutable_connect_timeout()->set_seconds(5);
+    cluster.set_lb_policy(envoy::config::cluster::v3::Cluster::LEAST_REQUEST);
+    auto* thresholds = cluster.mutable_circuit_breakers()->add_thresholds();
+    thresholds->mutable_max_connections()->set_value(1024);
+    thresholds->mutable_max_pending_requests()->set_value(1024);
+    thresholds->mutable_max_requests()->set_value(1024);
+    auto* outlier_detection = cluster.mutable_outlier_detection();
+    outlier_detection->mutable_consecutive_5xx()->set_value(5);
+    outlier_detection->mutable_interval()->set_seconds(10);
+    outlier_detection->mutable_base_ejection_time()->set_seconds(30);
+    response.add_resources()->PackFrom(cluster);
+  }
+  return response;
+}
+
+// Measures decoding a CDS response with `state.range(0)` clusters, unpacking and validating the
+// clusters on `state.range(1)` threads.
+static void bmDecodeCdsResponse(benchmark::State& state) {
+  const envoy::service::discovery::v3::DiscoveryResponse response = cdsResponse(state.range(0));
+  ProtobufMessage::StrictValidationVisitorImpl validation_visitor;
+  OpaqueResourceDecoderImpl<envoy::config::cluster::v3::Cluster> resource_decoder(
+      validation_visitor, "name");
+  ParallelResourceDecoder parallel_resource_decoder(Thread::threadFactoryForTest(),
+                                                    state.range(1));
+
+  for (auto _ : state) { // NOLINT
+    std::vector<PreDecodedResource> pre_decoded_resources =
+        parallel_resource_decoder.preDecodeResources(resource_decoder, response.resources());
+    std::vector<DecodedResourcePtr> resources;
+    resources.reserve(response.resources_size());
+    for (int i = 0; i < response.resources_size(); ++i) {
+      resources.push_back(pre_decoded_resources.empty()
+                              ? DecodedResourceImpl::fromResource(
+                                    resource_decoder, response.resources(i), response.version_info())
+                              : DecodedResourceImpl::fromResource(
+                                    resource_decoder, response.resources(i), response.version_info(),
+                                    std::move(pre_decoded_resources[i])));
+    }
+    benchmark::DoNotOptimize(resources);
+  }
+  state.SetItemsProcessed(state.iterations() * response.resources_size());
+}
+BENCHMARK(bmDecodeCdsResponse)
+    ->ArgsProduct({{1000, 10000}, {1, 2, 4, 8}})
+    ->Unit(benchmark::kMillisecond);
+
+} // namespace
+} // namespace Config
+} // namespace Envoy
@@ -0,0 +1,100 @@
+#include "envoy/config/endpoint/v3/endpoint.pb.h"
+#include "envoy/config/endpoint/v3/endpoint.pb.validate.h"
+#include "envoy/service/discovery/v3/discovery.pb.h"
+
+#include "source/common/config/opaque_resource_decoder_impl.h"
+#include "source/common/config/parallel_resource_decoder.h"
+#include "source/common/protobuf/message_validator_impl.h"
+
+#include "test/test_common/utility.h"
+
+#include "absl/strings/str_cat.h"
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Config {
+namespace {
+
+class ParallelResourceDecoderTest : public testing::Test {
+public:
+  // Adds a resource named after its index, wrapped in a Resource for every other one.
+  void addResources(int count) {
+    for (int i = 0; i < count; ++i) {
+      envoy::config::endpoint::v3::ClusterLoadAssignment resource;
+      resource.set_cluster_name(absl::StrCat("cluster_", resources_.size()));
+      if (resources_.size() % 2 == 0) {
+        resources_.Add()->PackFrom(resource);
+      } else {
+        envoy::service::discovery::v3::Resource wrapper;
+        wrapper.mutable_resource()->PackFrom(resource);
+        resources_.Add()->PackFrom(wrapper);
+      }
+    }
+  }
+
+  std::string resourceName(PreDecodedResource& pre_decoded) {
+    return resource_decoder_.resourceName(
+        *resource_decoder_.finishDecodeResource(std::move(pre_decoded)));
+  }
+
+  ProtobufMessage::StrictValidationVisitorImpl validation_visitor_;
+  OpaqueResourceDecoderImpl<envoy::config::endpoint::v3::ClusterLoadAssignment> resource_decoder_{
+      validation_visitor_, "cluster_name"};
+  Protobuf::RepeatedPtrField<ProtobufWkt::Any> resources_;
+};
+
+// The resources are pre-decoded in the order of the response, across successive responses, each
+// decoded by its own threads.
+TEST_F(ParallelResourceDecoderTest, Order) {
+  ParallelResourceDecoder decoder(Thread::threadFactoryForTest(), 4);
+  addResources(100);
+  for (int response = 0; response < 3; ++response) {
+    std::vector<PreDecodedResource> pre_decoded =
+        decoder.preDecodeResources(resource_decoder_, resources_);
+    ASSERT_EQ(100, pre_decoded.size());
+    for (int i = 0; i < 100; ++i) {
+      EXPECT_EQ(absl::StrCat("cluster_", i), resourceName(pre_decoded[i]));
+    }
+  }
+}
+
+// Errors are recorded by whichever thread decodes the resource, and thrown once the calling thread
+// finishes decoding it.
+TEST_F(ParallelResourceDecoderTest, ErrorOnOtherThread) {
+  ParallelResourceDecoder decoder(Thread::threadFactoryForTest(), 4);
+  addResources(64);
+  resources_[60].set_type_url("huh");
+  resources_[62].PackFrom(envoy::config::endpoint::v3::ClusterLoadAssignment());
+  std::vector<PreDecodedResource> pre_decoded =
+      decoder.preDecodeResources(resource_decoder_, resources_);
+  ASSERT_EQ(64, pre_decoded.size());
+  EXPECT_FALSE(pre_decoded[60].unpack_status_.ok());
+  EXPECT_THROW_WITH_REGEX(resource_decoder_.finishDecodeResource(std::move(pre_decoded[60])),
+                          EnvoyException, "Unable to unpack");
+  EXPECT_FALSE(pre_decoded[62].validation_error_.empty());
+  EXPECT_THROW(resource_decoder_.finishDecodeResource(std::move(pre_decoded[62])),
+               ProtoValidationException);
+  EXPECT_EQ("cluster_63", resourceName(pre_decoded[63]));
+}
+
+// Responses too small to give two threads MinResourcesPerThread resources are left to be decoded
+// serially, as are all responses when there is a single thread or no thread factory.
+TEST_F(ParallelResourceDecoderTest, SerialBelowThreshold) {
+  addResources(2 * ParallelResourceDecoder::MinResourcesPerThread - 1);
+  ParallelResourceDecoder decoder(Thread::threadFactoryForTest(), 4);
+  EXPECT_TRUE(decoder.preDecodeResources(resource_decoder_, resources_).empty());
+
+  addResources(1);
+  EXPECT_EQ(2 * ParallelResourceDecoder::MinResourcesPerThread,
+            decoder.preDecodeResources(resource_decoder_, resources_).size());
+
+  ParallelResourceDecoder single_thread_decoder(Thread::threadFactoryForTest(), 1);
+  EXPECT_TRUE(single_thread_decoder.preDecodeResources(resource_decoder_, resources_).empty());
+
+  ParallelResourceDecoder no_thread_factory_decoder(absl::nullopt, 4);
+  EXPECT_TRUE(no_thread_factory_decoder.preDecodeResources(resource_decoder_, resources_).empty());
+}
+
+} // namespace
+} // namespace Config
+} // namespace Envoy
@@ -1,3 +1,7 @@
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
 #include "source/common/formatter/substitution_formatter.h"
 #include "source/common/network/address_impl.h"
 
@@ -6,11 +10,55 @@
 
 #include "benchmark/benchmark.h"
 
+#if !defined(TCMALLOC) && !defined(GPERFTOOLS_TCMALLOC)
+// Counts the allocations made through operator new, to report the allocations per log line.
+// tcmalloc replaces operator new itself, so this requires building with
+// --define tcmalloc=disabled.
+#define COUNT_ALLOCATIONS
+static std::atomic<uint64_t> allocation_count{0};
+
+void* operator new(size_t size) {
+  allocation_count.fetch_add(1, std::memory_order_relaxed);
+  void* ptr = std::malloc(size == 0 ? 1 : size);
+  if (ptr == nullptr) {
+    throw std::bad_alloc();
+  }
+  return ptr;
+}
+void* operator new[](size_t size) { return operator new(size); }
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete[](void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, size_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, size_t) noexcept { std::free(ptr); }
+#endif
+
 namespace Envoy {
 
 namespace {
 
-std::unique_ptr<Envoy::Formatter::JsonFormatterImpl> makeJsonFormatter(bool typed) {
+// Reports the average number of allocations per iteration of a benchmark, from its construction
+// to its destruction, when allocations are counted.
+class AllocationsPerLogLine {
+public:
+  explicit AllocationsPerLogLine(benchmark::State& state) : state_(state) {
+#ifdef COUNT_ALLOCATIONS
+    start_ = allocation_count.load();
+#endif
+  }
+  ~AllocationsPerLogLine() {
+#ifdef COUNT_ALLOCATIONS
+    state_.counters["allocs_per_log_line"] = benchmark::Counter(
+        allocation_count.load() - start_, benchmark::Counter::kAvgIterations);
+#endif
+  }
+
+private:
+  benchmark::State& state_;
+  uint64_t start_{0};
+};
+
+std::unique_ptr<Envoy::Formatter::JsonFormatterImpl> makeJsonFormatter(bool typed,
+                                                                       bool sorted = false) {
   ProtobufWkt::Struct JsonLogFormat;
   const std::string format_yaml = R"EOF(
     remote_address: '%DOWNSTREAM_REMOTE_ADDRESS_WITHOUT_PORT%'
@@ -25,7 +73,8 @@ std::unique_ptr<Envoy::Formatter::JsonFormatterImpl> makeJsonFormatter(bool type
     user-agent: '%REQ(USER-AGENT)%'
   )EOF";
   TestUtility::loadFromYaml(format_yaml, JsonLogFormat);
-  return std::make_unique<Envoy::Formatter::JsonFormatterImpl>(JsonLogFormat, typed, false, false);
+  return std::make_unique<Envoy::Formatter::JsonFormatterImpl>(JsonLogFormat, typed, false,
+                                                               sorted);
 }
 
 std::unique_ptr<Envoy::Formatter::StructFormatter> makeStructFormatter(bool typed) {
@@ -86,6 +135,7 @@ static void BM_AccessLogFormatter(benchmark::State& state) {
       std::make_unique<Envoy::Formatter::FormatterImpl>(LogFormat, false);
 
   size_t output_bytes = 0;
+  AllocationsPerLogLine allocations(state);
   for (auto _ : state) { // NOLINT: Silences warning about dead store
     output_bytes += formatter->formatWithContext({}, *stream_info).length();
   }
@@ -100,6 +150,7 @@ static void BM_StructAccessLogFormatter(benchmark::State& state) {
   std::unique_ptr<Envoy::Formatter::StructFormatter> struct_formatter = makeStructFormatter(false);
 
   size_t output_bytes = 0;
+  AllocationsPerLogLine allocations(state);
   for (auto _ : state) { // NOLINT: Silences warning about dead store
     output_bytes += struct_formatter->formatWithContext({}, *stream_info).ByteSize();
   }
@@ -115,6 +166,7 @@ static void BM_TypedStructAccessLogFormatter(benchmark::State& state) {
       makeStructFormatter(true);
 
   size_t output_bytes = 0;
+  AllocationsPerLogLine allocations(state);
   for (auto _ : state) { // NOLINT: Silences warning about dead store
     output_bytes += typed_struct_formatter->formatWithContext({}, *stream_info).ByteSize();
   }
@@ -129,6 +181,7 @@ static void BM_JsonAccessLogFormatter(benchmark::State& state) {
   std::unique_ptr<Envoy::Formatter::JsonFormatterImpl> json_formatter = makeJsonFormatter(false);
 
   size_t output_bytes = 0;
+  AllocationsPerLogLine allocations(state);
   for (auto _ : state) { // NOLINT: Silences warning about dead store
     output_bytes += json_formatter->formatWithContext({}, *stream_info).length();
   }
@@ -144,6 +197,7 @@ static void BM_TypedJsonAccessLogFormatter(benchmark::State& state) {
       makeJsonFormatter(true);
 
   size_t output_bytes = 0;
+  AllocationsPerLogLine allocations(state);
   for (auto _ : state) { // NOLINT: Silences warning about dead store
     output_bytes += typed_json_formatter->formatWithContext({}, *stream_info).length();
   }
@@ -151,6 +205,22 @@ static void BM_TypedJsonAccessLogFormatter(benchmark::State& state) {
 }
 BENCHMARK(BM_TypedJsonAccessLogFormatter);
 
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void BM_SortedJsonAccessLogFormatter(benchmark::State& state) {
+  MockTimeSystem time_system;
+  std::unique_ptr<Envoy::TestStreamInfo> stream_info = makeStreamInfo(time_system);
+  std::unique_ptr<Envoy::Formatter::JsonFormatterImpl> sorted_json_formatter =
+      makeJsonFormatter(false, true);
+
+  size_t output_bytes = 0;
+  AllocationsPerLogLine allocations(state);
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    output_bytes += sorted_json_formatter->formatWithContext({}, *stream_info).length();
+  }
+  benchmark::DoNotOptimize(output_bytes);
+}
+BENCHMARK(BM_SortedJsonAccessLogFormatter);
+
 // NOLINTNEXTLINE(readability-identifier-naming)
 static void BM_FormatterCommandParsing(benchmark::State& state) {
   const std::string token = "Listener:namespace:key";
@@ -3777,6 +3777,154 @@ TEST(SubstitutionFormatterTest, JsonFormatterWithOrderedPropertiesTest) {
   EXPECT_EQ(out_json, expected);
 }
 
+TEST(SubstitutionFormatterTest, JsonFormatterEscapingTest) {
+  NiceMock<StreamInfo::MockStreamInfo> stream_info;
+  Http::TestRequestHeaderMapImpl request_header{{"x-quote", "say \"hi\""},
+                                                {"x-control", "a\tb\\c"}};
+  HttpFormatterContext formatter_context(&request_header);
+
+  ProtobufWkt::Struct key_mapping;
+  TestUtility::loadFromYaml(R"EOF(
+    "a\"key": '%REQ(X-QUOTE)%'
+    control: '%REQ(X-CONTROL)%'
+    composite: '%REQ(X-QUOTE)% %REQ(X-CONTROL)% %REQ(X-MISSING)%'
+    number: 1.5
+  )EOF",
+                            key_mapping);
+  JsonFormatterImpl formatter(key_mapping, false, false, false);
+
+  // The properties are in the order of the format map, which is sorted.
+  EXPECT_EQ("{\"a\\\"key\":\"say \\\"hi\\\"\","
+            "\"composite\":\"say \\\"hi\\\" a\\tb\\\\c -\","
+            "\"control\":\"a\\tb\\\\c\","
+            "\"number\":\"1.5\"}\n",
+            formatter.formatWithContext(formatter_context, stream_info));
+}
+
+// The JSON formatter serializes values as they are formatted, which must be equivalent to
+// serializing the output of the struct formatter.
+TEST(SubstitutionFormatterTest, JsonFormatterMatchesStructFormatterTest) {
+  NiceMock<StreamInfo::MockStreamInfo> stream_info;
+  Http::TestRequestHeaderMapImpl request_header{{":method", "GET"}, {":path", "/"}};
+  Http::TestResponseHeaderMapImpl response_header;
+  Http::TestResponseTrailerMapImpl response_trailer;
+  std::string body;
+
+  HttpFormatterContext formatter_context(&request_header, &response_header, &response_trailer,
+                                         body);
+
+  envoy::config::core::v3::Metadata metadata;
+  populateMetadataTestData(metadata);
+  EXPECT_CALL(Const(stream_info), dynamicMetadata()).WillRepeatedly(ReturnRef(metadata));
+  stream_info.response_code_ = 200;
+
+  ProtobufWkt::Struct key_mapping;
+  TestUtility::loadFromYaml(R"EOF(
+    method: '%REQ(:METHOD)%'
+    missing: '%REQ(X-MISSING)%'
+    code: '%RESPONSE_CODE%'
+    number: 2.5
+    metadata: '%DYNAMIC_METADATA(com.test)%'
+    missing_metadata: '%DYNAMIC_METADATA(com.unknown)%'
+    composite: '%REQ(:METHOD)% %REQ(X-MISSING)% %REQ(:PATH)%'
+    all_missing:
+      missing: '%REQ(X-MISSING)%'
+      nested:
+        missing: '%REQ(X-MISSING)%'
+    list:
+      - '%REQ(:PATH)%'
+      - '%REQ(X-MISSING)%'
+      - nested: '%REQ(X-MISSING)%'
+      - 3
+    empty_list:
+      - '%REQ(X-MISSING)%'
+  )EOF",
+                            key_mapping);
+
+  for (const bool preserve_types : {false, true}) {
+    for (const bool omit_empty_values : {false, true}) {
+      SCOPED_TRACE(absl::StrCat("preserve_types: ", preserve_types,
+                                ", omit_empty_values: ", omit_empty_values));
+      StructFormatter struct_formatter(key_mapping, preserve_types, omit_empty_values);
+      JsonFormatterImpl json_formatter(key_mapping, preserve_types, omit_empty_values, false);
+
+      const std::string expected = MessageUtil::getJsonStringFromMessageOrError(
+          struct_formatter.formatWithContext(formatter_context, stream_info), false, true);
+      const std::string out_json = json_formatter.formatWithContext(formatter_context, stream_info);
+      EXPECT_TRUE(TestUtility::jsonStringEqual(out_json, expected)) << out_json;
+      EXPECT_EQ('\n', out_json.back());
+    }
+  }
+}
+
+TEST(SubstitutionFormatterTest, JsonFormatterWithoutDirectSerializationTest) {
+  TestScopedRuntime scoped_runtime;
+  scoped_runtime.mergeValues(
+      {{"envoy.reloadable_features.direct_json_access_log_formatting", "false"}});
+
+  NiceMock<StreamInfo::MockStreamInfo> stream_info;
+  Http::TestRequestHeaderMapImpl request_header{{":method", "GET"}};
+  HttpFormatterContext formatter_context(&request_header);
+
+  ProtobufWkt::Struct key_mapping;
+  TestUtility::loadFromYaml(R"EOF(
+    method: '%REQ(:METHOD)%'
+    nested:
+      missing: '%REQ(X-MISSING)%'
+  )EOF",
+                            key_mapping);
+  JsonFormatterImpl formatter(key_mapping, false, false, false);
+
+  const std::string expected = R"EOF({
+    "method": "GET",
+    "nested": {
+      "missing": "-"
+    }
+  })EOF";
+  EXPECT_TRUE(TestUtility::jsonStringEqual(
+      formatter.formatWithContext(formatter_context, stream_info), expected));
+}
+
+TEST(SubstitutionFormatterTest, JsonFormatterAllValuesOmittedTest) {
+  NiceMock<StreamInfo::MockStreamInfo> stream_info;
+  Http::TestRequestHeaderMapImpl request_header;
+  HttpFormatterContext formatter_context(&request_header);
+
+  ProtobufWkt::Struct key_mapping;
+  TestUtility::loadFromYaml(R"EOF(
+    missing: '%REQ(X-MISSING)%'
+    nested:
+      missing: '%REQ(X-MISSING)%'
+  )EOF",
+                            key_mapping);
+  JsonFormatterImpl formatter(key_mapping, false, true, false);
+
+  EXPECT_EQ("{}\n", formatter.formatWithContext(formatter_context, stream_info));
+}
+
+TEST(SubstitutionFormatterTest, JsonFormatterUtilTest) {
+  std::string output;
+  JsonFormatterUtil::appendNumber(200, output);
+  output.push_back(',');
+  JsonFormatterUtil::appendNumber(0.25, output);
+  output.push_back(',');
+  JsonFormatterUtil::appendNumber(std::numeric_limits<double>::quiet_NaN(), output);
+  output.push_back(',');
+  JsonFormatterUtil::appendNumber(std::numeric_limits<double>::infinity(), output);
+  EXPECT_EQ("200,0.25,null,null", output);
+
+  output.clear();
+  ProtobufWkt::Value value;
+  auto* values = value.mutable_list_value();
+  values->add_values()->set_bool_value(true);
+  values->add_values()->set_null_value(ProtobufWkt::NULL_VALUE);
+  values->add_values()->set_string_value("\"\n");
+  (*values->add_values()->mutable_struct_value()->mutable_fields())["key"].set_number_value(1);
+  values->add_values();
+  JsonFormatterUtil::appendValue(value, output);
+  EXPECT_EQ("[true,null,\"\\\"\\n\",{\"key\":1},null]", output);
+}
+
 TEST(SubstitutionFormatterTest, CompositeFormatterSuccess) {
   Http::TestRequestHeaderMapImpl request_header{{"first", "GET"}, {":path", "/"}};
   Http::TestResponseHeaderMapImpl response_header{{"second", "PUT"}, {"test", "test"}};
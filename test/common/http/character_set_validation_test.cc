@@ -1,5 +1,8 @@
 #include "source/common/http/character_set_validation.h"
 
+#include <string>
+
+#include "absl/strings/ascii.h"
 #include "gtest/gtest.h"
 
 namespace Envoy {
@@ -33,5 +36,52 @@ TEST(CharacterSetValidationTest, Test) {
   }
 }
 
+TEST(CharacterSetValidationTest, HeaderValueCharTable) {
+  for (unsigned c = 0; c < 256; ++c) {
+    const bool expected = c == '\t' || (c >= 0x20 && c != 0x7f);
+    ASSERT_EQ(expected, testCharInTable(kHeaderValueCharTable, static_cast<char>(c))) << c;
+  }
+}
+
+// Place each byte value at every position of strings of various lengths, so that it is checked
+// both in the word at a time loop and in the trailing bytes.
+TEST(CharacterSetValidationTest, HeaderValueCharsAreValid) {
+  EXPECT_TRUE(headerValueCharsAreValid(""));
+  EXPECT_TRUE(headerValueCharsAreValid("text/html; q=0.9,\t\x80\xff"));
+  for (size_t length = 1; length <= 19; ++length) {
+    for (size_t position = 0; position < length; ++position) {
+      for (unsigned c = 0; c < 256; ++c) {
+        std::string value(length, 'a');
+        value[position] = static_cast<char>(c);
+        ASSERT_EQ(testCharInTable(kHeaderValueCharTable, static_cast<char>(c)),
+                  headerValueCharsAreValid(value))
+            << "length " << length << " position " << position << " char " << c;
+      }
+    }
+  }
+}
+
+TEST(CharacterSetValidationTest, ContainsCrOrLf) {
+  EXPECT_FALSE(containsCrOrLf(""));
+  for (size_t length = 1; length <= 19; ++length) {
+    for (size_t position = 0; position < length; ++position) {
+      for (unsigned c = 0; c < 256; ++c) {
+        std::string value(length, '\xff');
+        value[position] = static_cast<char>(c);
+        ASSERT_EQ(c == '\r' || c == '\n', containsCrOrLf(value))
+            << "length " << length << " position " << position << " char " << c;
+      }
+    }
+  }
+}
+
+TEST(CharacterSetValidationTest, AsciiToLowerBranchless) {
+  for (unsigned c = 0; c < 256; ++c) {
+    ASSERT_EQ(absl::ascii_tolower(static_cast<unsigned char>(c)),
+              asciiToLowerBranchless(static_cast<char>(c)))
+        << c;
+  }
+}
+
 } // namespace Http
 } // namespace Envoy
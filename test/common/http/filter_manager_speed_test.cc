@@ -0,0 +1,85 @@
+// Note: this should be run with --compilation_mode=opt, and would benefit from a
+// quiescent system with disabled cstate power management.
+
+#include <memory>
+
+#include "source/common/http/filter_manager.h"
+#include "source/common/memory/stats.h"
+#include "source/common/stream_info/filter_state_impl.h"
+#include "source/extensions/filters/http/common/pass_through_filter.h"
+
+#include "test/mocks/event/mocks.h"
+#include "test/mocks/http/mocks.h"
+#include "test/mocks/local_reply/mocks.h"
+#include "test/mocks/network/mocks.h"
+
+#include "benchmark/benchmark.h"
+
+using testing::_;
+using testing::Invoke;
+using testing::NiceMock;
+
+namespace Envoy {
+namespace Http {
+namespace {
+
+class FilterManagerSpeedTest {
+public:
+  explicit FilterManagerSpeedTest(int num_filters) {
+    ON_CALL(filter_factory_, createFilterChain(_))
+        .WillByDefault(Invoke([num_filters](FilterChainManager& manager) -> bool {
+          for (int i = 0; i < num_filters; ++i) {
+            FilterFactoryCb factory = [](FilterChainFactoryCallbacks& callbacks) {
+              callbacks.addStreamFilter(std::make_shared<PassThroughFilter>());
+            };
+            manager.applyFilterFactoryCb({}, factory);
+          }
+          return true;
+        }));
+  }
+
+  std::unique_ptr<DownstreamFilterManager> createStream() {
+    auto filter_manager = std::make_unique<DownstreamFilterManager>(
+        filter_manager_callbacks_, dispatcher_, connection_, 0, nullptr, true, 10000,
+        filter_factory_, local_reply_, protocol_, time_source_, filter_state_,
+        StreamInfo::FilterState::LifeSpan::Connection);
+    filter_manager->createFilterChain();
+    return filter_manager;
+  }
+
+  static void destroyStream(DownstreamFilterManager& filter_manager) {
+    filter_manager.onStreamComplete();
+    filter_manager.destroyFilters();
+  }
+
+private:
+  NiceMock<MockFilterManagerCallbacks> filter_manager_callbacks_;
+  NiceMock<Event::MockDispatcher> dispatcher_;
+  NiceMock<Network::MockConnection> connection_;
+  NiceMock<MockFilterChainFactory> filter_factory_;
+  NiceMock<LocalReply::MockLocalReply> local_reply_;
+  Protocol protocol_{Protocol::Http2};
+  NiceMock<MockTimeSystem> time_source_;
+  StreamInfo::FilterStateSharedPtr filter_state_ =
+      std::make_shared<StreamInfo::FilterStateImpl>(StreamInfo::FilterState::LifeSpan::Connection);
+};
+
+// Measures setting up and tearing down the filter chain of a stream with the given number of
+// filters. Also reports the memory held by a stream once its filter chain is created, when the
+// allocator supports it.
+static void bmStreamFilterChainLifetime(benchmark::State& state) {
+  FilterManagerSpeedTest test(state.range(0));
+  uint64_t stream_bytes = 0;
+  for (auto _ : state) { // NOLINT
+    const uint64_t start_bytes = Memory::Stats::totalCurrentlyAllocated();
+    std::unique_ptr<DownstreamFilterManager> filter_manager = test.createStream();
+    stream_bytes = Memory::Stats::totalCurrentlyAllocated() - start_bytes;
+    FilterManagerSpeedTest::destroyStream(*filter_manager);
+  }
+  state.counters["bytes_per_stream"] = stream_bytes;
+}
+BENCHMARK(bmStreamFilterChainLifetime)->Arg(1)->Arg(4)->Arg(8)->Arg(16);
+
+} // namespace
+} // namespace Http
+} // namespace Envoy
@@ -28,6 +28,26 @@ static void headerMapImplCreate(benchmark::State& state) {
 }
 BENCHMARK(headerMapImplCreate);
 
+/**
+ * Measure the speed of copying a request HeaderMap, as done once per request that is shadowed.
+ * The numeric Arg passed by the BENCHMARK(...) macro call below indicates how many dummy headers
+ * are added to the HeaderMapImpl being copied, in addition to the usual request headers.
+ */
+static void headerMapImplCopy(benchmark::State& state) {
+  auto headers = Http::RequestHeaderMapImpl::create();
+  headers->setReferenceMethod(Headers::get().MethodValues.Get);
+  headers->setReferencePath("/api/v1/orders");
+  headers->setReferenceHost("orders.internal");
+  headers->setReferenceScheme(Headers::get().SchemeValues.Https);
+  headers->setRequestId("5f9c3e0e-8a8b-4c3e-9d1f-2b6a7e4c9a10");
+  addDummyHeaders(*headers, state.range(0));
+  for (auto _ : state) { // NOLINT
+    auto copy = createHeaderMap<RequestHeaderMapImpl>(*headers);
+    benchmark::DoNotOptimize(copy->size());
+  }
+}
+BENCHMARK(headerMapImplCopy)->Arg(0)->Arg(1)->Arg(5)->Arg(10)->Arg(50);
+
 /**
  * Measure the speed of setting/overwriting a header value. The numeric Arg passed
  * by the BENCHMARK(...) macro call below indicates how many dummy headers this test
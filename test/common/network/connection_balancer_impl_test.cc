@@ -0,0 +1,89 @@
+#include <atomic>
+
+#include "source/common/network/connection_balancer_impl.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Network {
+namespace {
+
+class TestBalancedConnectionHandler : public BalancedConnectionHandler {
+public:
+  explicit TestBalancedConnectionHandler(uint64_t num_connections)
+      : num_connections_(num_connections) {}
+
+  // BalancedConnectionHandler
+  uint64_t numConnections() const override { return num_connections_; }
+  void incNumConnections() override { ++num_connections_; }
+  void post(ConnectionSocketPtr&&) override {}
+  void onAcceptWorker(ConnectionSocketPtr&&, bool, bool) override {}
+
+  std::atomic<uint64_t> num_connections_;
+};
+
+TEST(PowerOfTwoChoicesConnectionBalancerImplTest, SingleHandler) {
+  PowerOfTwoChoicesConnectionBalancerImpl balancer;
+  TestBalancedConnectionHandler handler(5);
+  balancer.registerHandler(handler);
+
+  EXPECT_EQ(&handler, &balancer.pickTargetHandler(handler));
+  EXPECT_EQ(6, handler.numConnections());
+}
+
+// With two handlers both are always sampled, so the less loaded one is always picked.
+TEST(PowerOfTwoChoicesConnectionBalancerImplTest, PicksLessLoadedHandler) {
+  PowerOfTwoChoicesConnectionBalancerImpl balancer;
+  TestBalancedConnectionHandler busy_handler(10);
+  TestBalancedConnectionHandler idle_handler(0);
+  balancer.registerHandler(busy_handler);
+  balancer.registerHandler(idle_handler);
+
+  for (int i = 0; i < 10; ++i) {
+    EXPECT_EQ(&idle_handler, &balancer.pickTargetHandler(busy_handler));
+  }
+  EXPECT_EQ(10, busy_handler.numConnections());
+  EXPECT_EQ(10, idle_handler.numConnections());
+
+  // On a tie, the connection stays on the current handler.
+  EXPECT_EQ(&busy_handler, &balancer.pickTargetHandler(busy_handler));
+  EXPECT_EQ(11, busy_handler.numConnections());
+}
+
+TEST(PowerOfTwoChoicesConnectionBalancerImplTest, KeepsLeastLoadedCurrentHandler) {
+  PowerOfTwoChoicesConnectionBalancerImpl balancer;
+  TestBalancedConnectionHandler handler1(0);
+  TestBalancedConnectionHandler handler2(5);
+  TestBalancedConnectionHandler handler3(5);
+  balancer.registerHandler(handler1);
+  balancer.registerHandler(handler2);
+  balancer.registerHandler(handler3);
+
+  for (int i = 0; i < 5; ++i) {
+    EXPECT_EQ(&handler1, &balancer.pickTargetHandler(handler1));
+  }
+  EXPECT_EQ(5, handler1.numConnections());
+  EXPECT_EQ(5, handler2.numConnections());
+  EXPECT_EQ(5, handler3.numConnections());
+}
+
+TEST(PowerOfTwoChoicesConnectionBalancerImplTest, UnregisteredHandlerIsNotPicked) {
+  PowerOfTwoChoicesConnectionBalancerImpl balancer;
+  TestBalancedConnectionHandler handler1(10);
+  TestBalancedConnectionHandler handler2(0);
+  TestBalancedConnectionHandler handler3(5);
+  balancer.registerHandler(handler1);
+  balancer.registerHandler(handler2);
+  balancer.registerHandler(handler3);
+  balancer.unregisterHandler(handler2);
+
+  for (int i = 0; i < 5; ++i) {
+    EXPECT_EQ(&handler3, &balancer.pickTargetHandler(handler1));
+  }
+  EXPECT_EQ(0, handler2.numConnections());
+  EXPECT_EQ(10, handler3.numConnections());
+}
+
+} // namespace
+} // namespace Network
+} // namespace Envoy
@@ -0,0 +1,134 @@
+// Note: this should be run with --compilation_mode=opt, and would benefit from a
+// quiescent system with disabled cstate power management.
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <queue>
+#include <random>
+#include <vector>
+
+#include "source/common/network/connection_balancer_impl.h"
+
+#include "benchmark/benchmark.h"
+
+namespace Envoy {
+namespace Network {
+namespace {
+
+constexpr uint32_t NumWorkers = 32;
+
+class TestBalancedConnectionHandler : public BalancedConnectionHandler {
+public:
+  // BalancedConnectionHandler
+  uint64_t numConnections() const override { return num_connections_; }
+  void incNumConnections() override { ++num_connections_; }
+  void post(ConnectionSocketPtr&&) override {}
+  void onAcceptWorker(ConnectionSocketPtr&&, bool, bool) override {}
+
+  void decNumConnections() { --num_connections_; }
+
+private:
+  std::atomic<uint64_t> num_connections_{};
+};
+
+// Simulates NumWorkers workers accepting connections, where the kernel hands half of the new
+// connections to the first 4 workers, and 1 in 10 connections is long lived (like a gRPC
+// connection) while the rest close after a few more connections are accepted (like HTTP/1
+// connections). Reports how far the most loaded worker is above the average number of connections.
+static void bmSkewedConnectionLifetimes(benchmark::State& state, ConnectionBalancer& balancer) {
+  std::vector<TestBalancedConnectionHandler> handlers(NumWorkers);
+  for (TestBalancedConnectionHandler& handler : handlers) {
+    balancer.registerHandler(handler);
+  }
+  std::mt19937_64 prng(1);
+  // Pending connection closes, ordered by the time at which they close.
+  using Close = std::pair<uint64_t, TestBalancedConnectionHandler*>;
+  std::priority_queue<Close, std::vector<Close>, std::greater<Close>> closes;
+  uint64_t now = 0;
+  double max_to_mean_sum = 0;
+  uint64_t samples = 0;
+
+  for (auto _ : state) { // NOLINT
+    ++now;
+    while (!closes.empty() && closes.top().first <= now) {
+      closes.top().second->decNumConnections();
+      closes.pop();
+    }
+
+    const uint64_t random = prng();
+    const uint32_t accepting_worker =
+        (random & 1) ? (random >> 1) % 4 : (random >> 1) % NumWorkers;
+    BalancedConnectionHandler& target = balancer.pickTargetHandler(handlers[accepting_worker]);
+    const uint64_t lifetime = (random >> 32) % 10 == 0 ? 100000 : 64;
+    closes.emplace(now + lifetime, static_cast<TestBalancedConnectionHandler*>(&target));
+
+    if (now % 1024 == 0) {
+      uint64_t max_connections = 0;
+      uint64_t total_connections = 0;
+      for (const TestBalancedConnectionHandler& handler : handlers) {
+        max_connections = std::max(max_connections, handler.numConnections());
+        total_connections += handler.numConnections();
+      }
+      max_to_mean_sum += static_cast<double>(max_connections) * NumWorkers / total_connections;
+      ++samples;
+    }
+  }
+
+  for (TestBalancedConnectionHandler& handler : handlers) {
+    balancer.unregisterHandler(handler);
+  }
+  if (samples > 0) {
+    state.counters["max_to_mean_connections"] = max_to_mean_sum / samples;
+  }
+}
+
+static void bmSkewedConnectionLifetimesNop(benchmark::State& state) {
+  NopConnectionBalancerImpl balancer;
+  bmSkewedConnectionLifetimes(state, balancer);
+}
+BENCHMARK(bmSkewedConnectionLifetimesNop);
+
+static void bmSkewedConnectionLifetimesExact(benchmark::State& state) {
+  ExactConnectionBalancerImpl balancer;
+  bmSkewedConnectionLifetimes(state, balancer);
+}
+BENCHMARK(bmSkewedConnectionLifetimesExact);
+
+static void bmSkewedConnectionLifetimesPowerOfTwoChoices(benchmark::State& state) {
+  PowerOfTwoChoicesConnectionBalancerImpl balancer;
+  bmSkewedConnectionLifetimes(state, balancer);
+}
+BENCHMARK(bmSkewedConnectionLifetimesPowerOfTwoChoices);
+
+// Measures picking a target handler from `state.threads()` threads at once, as when every worker
+// is accepting connections.
+template <class Balancer> static void bmConcurrentPick(benchmark::State& state) {
+  static Balancer* balancer;
+  static std::vector<TestBalancedConnectionHandler>* handlers;
+  if (state.thread_index() == 0) {
+    balancer = new Balancer();
+    handlers = new std::vector<TestBalancedConnectionHandler>(NumWorkers);
+    for (TestBalancedConnectionHandler& handler : *handlers) {
+      balancer->registerHandler(handler);
+    }
+  }
+  for (auto _ : state) { // NOLINT
+    TestBalancedConnectionHandler& current = (*handlers)[state.thread_index() % NumWorkers];
+    auto& target =
+        static_cast<TestBalancedConnectionHandler&>(balancer->pickTargetHandler(current));
+    target.decNumConnections();
+  }
+  if (state.thread_index() == 0) {
+    delete balancer;
+    delete handlers;
+  }
+}
+BENCHMARK_TEMPLATE(bmConcurrentPick, ExactConnectionBalancerImpl)->ThreadRange(1, NumWorkers);
+BENCHMARK_TEMPLATE(bmConcurrentPick, PowerOfTwoChoicesConnectionBalancerImpl)
+    ->ThreadRange(1, NumWorkers);
+
+} // namespace
+} // namespace Network
+} // namespace Envoy
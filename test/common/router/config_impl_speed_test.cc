@@ -59,7 +59,7 @@ static RouteConfiguration genRouteConfig(benchmark::State& state,
       break;
     }
     case RouteMatch::PathSpecifierCase::kPath: {
-      match->set_prefix(absl::StrCat("/shelves/shelf_", i, "/route_", i));
+      match->set_path(absl::StrCat("/shelves/shelf_", i, "/route_", i));
       break;
     }
     case RouteMatch::PathSpecifierCase::kSafeRegex: {
@@ -68,6 +68,29 @@ static RouteConfiguration genRouteConfig(benchmark::State& state,
       regex->set_regex(absl::StrCat("^/shelves/[^\\\\/]+/route_", i, "$"));
       break;
     }
+    case RouteMatch::PathSpecifierCase::PATH_SPECIFIER_NOT_SET: {
+      // A mixed table: mostly exact and prefix routes with a regex route every 16 routes.
+      if (i % 16 == 15) {
+        envoy::type::matcher::v3::RegexMatcher* regex = match->mutable_safe_regex();
+        regex->mutable_google_re2();
+        regex->set_regex(absl::StrCat("^/shelves/[^\\\\/]+/route_", i, "$"));
+      } else if (i % 2 == 0) {
+        match->set_path(absl::StrCat("/shelves/shelf_", i, "/route_", i));
+      } else {
+        match->set_prefix(absl::StrCat("/shelves/shelf_", i, "/"));
+      }
+      break;
+    }
+    case RouteMatch::PathSpecifierCase::kConnectMatcher: {
+      // Mostly CONNECT routes, which the path index cannot narrow down, with an exact path route
+      // every 16 routes and as the last route.
+      if (i % 16 == 15 || i == state.range(0) - 1) {
+        match->set_path(absl::StrCat("/shelves/shelf_", i, "/route_", i));
+      } else {
+        match->mutable_connect_matcher();
+      }
+      break;
+    }
     default:
       PANIC("reached unexpected code");
     }
@@ -96,11 +119,11 @@ static void bmRouteTableSize(benchmark::State& state, RouteMatch::PathSpecifierC
   ConfigImpl config(genRouteConfig(state, match_type), factory_context,
                     ProtobufMessage::getNullValidationVisitor(), true);
 
+  // Single request that will match the last route in the config.
+  const Http::TestRequestHeaderMapImpl headers = genRequestHeaders(state.range(0) - 1);
   for (auto _ : state) { // NOLINT
     // Do the actual timing here.
-    // Single request that will match the last route in the config.
-    int last_route_num = state.range(0) - 1;
-    config.route(genRequestHeaders(last_route_num), stream_info, 0);
+    config.route(headers, stream_info, 0);
   }
 }
 
@@ -136,9 +159,27 @@ static void bmRouteTableSizeWithRegexMatch(benchmark::State& state) {
   bmRouteTableSize(state, RouteMatch::PathSpecifierCase::kSafeRegex);
 }
 
+/**
+ * Benchmark a route table mixing exact path, path prefix and regex matchers, as found in large
+ * generated route configurations.
+ */
+static void bmRouteTableSizeWithMixedMatch(benchmark::State& state) {
+  bmRouteTableSize(state, RouteMatch::PathSpecifierCase::PATH_SPECIFIER_NOT_SET);
+}
+
+/**
+ * Benchmark a route table of mostly routes which the path index does not narrow down, as CONNECT
+ * routes are candidates for every path.
+ */
+static void bmRouteTableSizeWithMostlyUnindexedMatch(benchmark::State& state) {
+  bmRouteTableSize(state, RouteMatch::PathSpecifierCase::kConnectMatcher);
+}
+
 BENCHMARK(bmRouteTableSizeWithPathPrefixMatch)->RangeMultiplier(2)->Ranges({{1, 2 << 13}});
 BENCHMARK(bmRouteTableSizeWithExactPathMatch)->RangeMultiplier(2)->Ranges({{1, 2 << 13}});
 BENCHMARK(bmRouteTableSizeWithRegexMatch)->RangeMultiplier(2)->Ranges({{1, 2 << 13}});
+BENCHMARK(bmRouteTableSizeWithMixedMatch)->RangeMultiplier(2)->Ranges({{1, 2 << 13}});
+BENCHMARK(bmRouteTableSizeWithMostlyUnindexedMatch)->RangeMultiplier(2)->Ranges({{1, 2 << 13}});
 
 } // namespace
 } // namespace Router
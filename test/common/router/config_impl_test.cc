@@ -1172,6 +1172,163 @@ virtual_hosts:
             config.route(genHeaders("example.com", "/", "GET"), 0)->routeEntry()->clusterName());
 }
 
+// Virtual hosts with many routes look candidates up in a path index. Verify that the index
+// preserves first-match semantics across the different route match types.
+TEST_F(RouteMatcherTest, TestRoutesWithPathRouteIndex) {
+  std::string yaml = R"EOF(
+virtual_hosts:
+  - name: www
+    domains: ["www.lyft.com"]
+    routes:
+      - match:
+          prefix: "/api"
+          headers:
+          - name: x-canary
+            string_match:
+              exact: "true"
+        route: { cluster: "canary" }
+      - match: { path: "/api/users", case_sensitive: false }
+        route: { cluster: "exact_users" }
+      - match: { safe_regex: { regex: "^/api/u.*" } }
+        route: { cluster: "regex" }
+      - match: { prefix: "/api/" }
+        route: { cluster: "api_prefix" }
+      - match: { path_separated_prefix: "/static" }
+        route: { cluster: "static" }
+      - match: { prefix: "/Case" }
+        route: { cluster: "case" }
+)EOF";
+  for (int i = 0; i < 40; ++i) {
+    yaml += fmt::format(R"EOF(
+      - match: {{ path: "/filler/{}" }}
+        route: {{ cluster: "filler" }}
+)EOF",
+                        i);
+  }
+  yaml += R"EOF(
+      - match: { prefix: "/" }
+        route: { cluster: "default" }
+)EOF";
+
+  factory_context_.cluster_manager_.initializeClusters(
+      {"canary", "exact_users", "regex", "api_prefix", "static", "case", "filler", "default"}, {});
+  TestConfigImpl config(parseRouteConfigurationFromYaml(yaml), factory_context_, true);
+
+  auto cluster_name = [&config](const Http::TestRequestHeaderMapImpl& headers) {
+    return config.route(headers, 0)->routeEntry()->clusterName();
+  };
+
+  EXPECT_EQ("exact_users", cluster_name(genHeaders("www.lyft.com", "/api/users", "GET")));
+  EXPECT_EQ("exact_users", cluster_name(genHeaders("www.lyft.com", "/API/Users", "GET")));
+  EXPECT_EQ("exact_users", cluster_name(genHeaders("www.lyft.com", "/api/users?a=b", "GET")));
+  {
+    Http::TestRequestHeaderMapImpl headers = genHeaders("www.lyft.com", "/api/users", "GET");
+    headers.addCopy("x-canary", "true");
+    EXPECT_EQ("canary", cluster_name(headers));
+  }
+  EXPECT_EQ("regex", cluster_name(genHeaders("www.lyft.com", "/api/users/1", "GET")));
+  EXPECT_EQ("api_prefix", cluster_name(genHeaders("www.lyft.com", "/api/other", "GET")));
+  EXPECT_EQ("default", cluster_name(genHeaders("www.lyft.com", "/api", "GET")));
+  EXPECT_EQ("static", cluster_name(genHeaders("www.lyft.com", "/static", "GET")));
+  EXPECT_EQ("static", cluster_name(genHeaders("www.lyft.com", "/static/app.css", "GET")));
+  EXPECT_EQ("default", cluster_name(genHeaders("www.lyft.com", "/staticfoo", "GET")));
+  EXPECT_EQ("case", cluster_name(genHeaders("www.lyft.com", "/Case/x", "GET")));
+  EXPECT_EQ("default", cluster_name(genHeaders("www.lyft.com", "/case/x", "GET")));
+  EXPECT_EQ("filler", cluster_name(genHeaders("www.lyft.com", "/filler/39", "GET")));
+  EXPECT_EQ("default", cluster_name(genHeaders("www.lyft.com", "/filler/40", "GET")));
+  EXPECT_EQ("default", cluster_name(genHeaders("www.lyft.com", "/filler/3/", "GET")));
+}
+
+// The index strips path parameters like the route entries do when configured to.
+TEST_F(RouteMatcherTest, TestRoutesWithPathRouteIndexIgnorePathParameters) {
+  std::string yaml = R"EOF(
+ignore_path_parameters_in_path_matching: true
+virtual_hosts:
+  - name: www
+    domains: ["*"]
+    routes:
+)EOF";
+  for (int i = 0; i < 40; ++i) {
+    yaml += fmt::format(R"EOF(
+      - match: {{ path: "/filler/{}" }}
+        route: {{ cluster: "filler" }}
+)EOF",
+                        i);
+  }
+  yaml += R"EOF(
+      - match: { path: "/foo" }
+        route: { cluster: "foo" }
+)EOF";
+
+  factory_context_.cluster_manager_.initializeClusters({"filler", "foo"}, {});
+  TestConfigImpl config(parseRouteConfigurationFromYaml(yaml), factory_context_, true);
+
+  EXPECT_EQ("foo", config.route(genHeaders("www.lyft.com", "/foo;bar=baz", "GET"), 0)
+                       ->routeEntry()
+                       ->clusterName());
+  EXPECT_EQ("filler", config.route(genHeaders("www.lyft.com", "/filler/1;x?y=z", "GET"), 0)
+                          ->routeEntry()
+                          ->clusterName());
+  EXPECT_EQ(nullptr, config.route(genHeaders("www.lyft.com", "/foobar", "GET"), 0));
+}
+
+// The regexes of the regex routes are matched together. Verify that overlapping regexes and
+// constraints besides the path keep first-match semantics.
+TEST_F(RouteMatcherTest, TestRegexRoutesWithPathRouteIndex) {
+  std::string yaml = R"EOF(
+virtual_hosts:
+  - name: www
+    domains: ["*"]
+    routes:
+      - match:
+          safe_regex: { regex: "/items/[0-9]+" }
+          headers:
+          - name: x-canary
+            present_match: true
+        route: { cluster: "canary" }
+      - match: { safe_regex: { regex: "/items/1[0-9]*" } }
+        route: { cluster: "items_1" }
+      - match: { path: "/items/2" }
+        route: { cluster: "exact" }
+)EOF";
+  for (int i = 0; i < 40; ++i) {
+    yaml += fmt::format(R"EOF(
+      - match: {{ safe_regex: {{ regex: "/service{}/[^/]+" }} }}
+        route: {{ cluster: "service" }}
+)EOF",
+                        i);
+  }
+  yaml += R"EOF(
+      - match: { safe_regex: { regex: "/items/.*" } }
+        route: { cluster: "items" }
+      - match: { prefix: "/" }
+        route: { cluster: "default" }
+)EOF";
+
+  factory_context_.cluster_manager_.initializeClusters(
+      {"canary", "items_1", "exact", "service", "items", "default"}, {});
+  TestConfigImpl config(parseRouteConfigurationFromYaml(yaml), factory_context_, true);
+
+  auto cluster_name = [&config](const Http::TestRequestHeaderMapImpl& headers) {
+    return config.route(headers, 0)->routeEntry()->clusterName();
+  };
+
+  EXPECT_EQ("items_1", cluster_name(genHeaders("www.lyft.com", "/items/12", "GET")));
+  EXPECT_EQ("items_1", cluster_name(genHeaders("www.lyft.com", "/items/12?a=b", "GET")));
+  {
+    Http::TestRequestHeaderMapImpl headers = genHeaders("www.lyft.com", "/items/12", "GET");
+    headers.addCopy("x-canary", "true");
+    EXPECT_EQ("canary", cluster_name(headers));
+  }
+  EXPECT_EQ("exact", cluster_name(genHeaders("www.lyft.com", "/items/2", "GET")));
+  EXPECT_EQ("items", cluster_name(genHeaders("www.lyft.com", "/items/3", "GET")));
+  EXPECT_EQ("items", cluster_name(genHeaders("www.lyft.com", "/items/x", "GET")));
+  EXPECT_EQ("service", cluster_name(genHeaders("www.lyft.com", "/service39/a", "GET")));
+  // Regexes must match the whole path.
+  EXPECT_EQ("default", cluster_name(genHeaders("www.lyft.com", "/service39/a/b", "GET")));
+  EXPECT_EQ("default", cluster_name(genHeaders("www.lyft.com", "/v1/items/3", "GET")));
+}
+
 TEST_F(RouteMatcherTest, TestRoutesWithInvalidRegex) {
   std::string invalid_route = R"EOF(
 virtual_hosts:
@@ -18,6 +18,7 @@
 #include "test/test_common/test_time.h"
 #include "test/test_common/utility.h"
 
+#include "absl/strings/str_cat.h"
 #include "benchmark/benchmark.h"
 
 namespace Envoy {
@@ -64,6 +65,30 @@ public:
     store_.initializeThreading(*dispatcher_, *tls_);
   }
 
+  void initHistograms(uint32_t num_histograms) {
+    Stats::Scope& scope = *store_.rootScope();
+    Stats::StatNamePool pool(symbol_table_);
+    for (uint32_t i = 0; i < num_histograms; ++i) {
+      histograms_.push_back(&scope.histogramFromStatName(pool.add(absl::StrCat("histogram.", i)),
+                                                         Stats::Histogram::Unit::Unspecified));
+    }
+  }
+
+  // Records a value into every `stride`-th histogram, starting at `offset`.
+  void recordHistograms(uint32_t stride, uint32_t offset) {
+    for (uint32_t i = offset % stride; i < histograms_.size(); i += stride) {
+      histograms_[i]->recordValue(i);
+    }
+  }
+
+  void mergeHistograms() {
+    bool merged = false;
+    store_.mergeHistograms([&merged]() { merged = true; });
+    while (!merged) {
+      dispatcher_->run(Event::Dispatcher::RunType::NonBlock);
+    }
+  }
+
   void initPrefixRejections(const std::string& prefix) {
     stats_config_.mutable_stats_matcher()->mutable_exclusion_list()->add_patterns()->set_prefix(
         prefix);
@@ -80,6 +105,7 @@ private:
   Api::ApiPtr api_;
   envoy::config::metrics::v3::StatsConfig stats_config_;
   std::vector<std::unique_ptr<Stats::StatNameManagedStorage>> stat_names_;
+  std::vector<Stats::Histogram*> histograms_;
 };
 
 } // namespace Envoy
@@ -134,5 +160,30 @@ static void BM_StatsWithTlsAndRejectionsWithoutDot(benchmark::State& state) {
 }
 BENCHMARK(BM_StatsWithTlsAndRejectionsWithoutDot);
 
+// Measures merging a large number of histograms when only every `state.range(1)`-th histogram saw
+// new values in the interval, as is typical for large deployments where most histograms are idle.
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void BM_HistogramMerge(benchmark::State& state) {
+  Envoy::ThreadLocalStorePerf context;
+  context.initThreading();
+  context.initHistograms(state.range(0));
+  // Record into every histogram once so that all of them are considered used.
+  context.recordHistograms(1, 0);
+  context.mergeHistograms();
+
+  uint32_t interval = 0;
+  for (auto _ : state) { // NOLINT
+    state.PauseTiming();
+    context.recordHistograms(state.range(1), interval++);
+    state.ResumeTiming();
+    context.mergeHistograms();
+  }
+}
+BENCHMARK(BM_HistogramMerge)
+    ->Args({50000, 1})
+    ->Args({50000, 100})
+    ->Args({50000, 50000})
+    ->Unit(benchmark::kMillisecond);
+
 // TODO(jmarantz): add multi-threaded variant of this test, that aggressively
 // looks up stats in multiple threads to try to trigger contention issues.
@@ -1668,6 +1668,30 @@ TEST_F(HistogramTest, MultiHistogramMultipleMerges) {
   EXPECT_EQ(2, validateMerge());
 }
 
+// Merges skip histograms without new values. Validate that their interval statistics are reset and
+// their cumulative statistics are retained across several idle intervals, and that recording
+// resumes correctly afterwards.
+TEST_F(HistogramTest, IdleHistogramMerges) {
+  Histogram& h1 = scope_.histogramFromString("h1", Histogram::Unit::Unspecified);
+  Histogram& h2 = scope_.histogramFromString("h2", Histogram::Unit::Unspecified);
+
+  expectCallAndAccumulate(h1, 10);
+  expectCallAndAccumulate(h2, 20);
+  EXPECT_EQ(2, validateMerge());
+
+  // Only h2 sees new values.
+  expectCallAndAccumulate(h2, 30);
+  EXPECT_EQ(2, validateMerge());
+
+  // Neither histogram sees new values.
+  EXPECT_EQ(2, validateMerge());
+  EXPECT_EQ(2, validateMerge());
+
+  expectCallAndAccumulate(h1, 40);
+  EXPECT_EQ(2, validateMerge());
+  EXPECT_EQ(2, validateMerge());
+}
+
 TEST_F(HistogramTest, BasicScopeHistogramMerge) {
   ScopeSharedPtr scope1 = store_->createScope("scope1.");
 
@@ -134,6 +134,51 @@ TEST(EdfSchedulerTest, ManyPeekahead) {
   }
 }
 
+// Validate that creating a scheduler with picks matches adding the entries and then picking.
+TEST(EdfSchedulerTest, CreateWithPicks) {
+  constexpr uint32_t num_entries = 128;
+  std::vector<std::shared_ptr<uint32_t>> entries;
+  for (uint32_t i = 0; i < num_entries; ++i) {
+    entries.push_back(std::make_shared<uint32_t>(i));
+  }
+  // A mix of repeated and distinct weights exercises the FIFO tie breaking.
+  const auto calculate_weight = [](const uint32_t& entry) { return entry % 7 + 1; };
+
+  for (const uint32_t picks : {0U, 1U, 37U, num_entries - 1, 3 * num_entries}) {
+    SCOPED_TRACE(picks);
+    EdfScheduler<uint32_t> expected;
+    for (const auto& entry : entries) {
+      expected.add(calculate_weight(*entry), entry);
+    }
+    for (uint32_t i = 0; i < picks; ++i) {
+      expected.pickAndAdd(calculate_weight);
+    }
+
+    auto sched = EdfScheduler<uint32_t>::createWithPicks(entries, calculate_weight, picks);
+    for (uint32_t i = 0; i < 2 * num_entries; ++i) {
+      EXPECT_EQ(*expected.pickAndAdd(calculate_weight), *sched->pickAndAdd(calculate_weight));
+    }
+  }
+}
+
+// Validate that entries expire from a scheduler created with picks.
+TEST(EdfSchedulerTest, CreateWithPicksExpired) {
+  std::vector<std::shared_ptr<uint32_t>> entries{std::make_shared<uint32_t>(0),
+                                                 std::make_shared<uint32_t>(1)};
+  auto sched = EdfScheduler<uint32_t>::createWithPicks(
+      entries, [](const uint32_t&) { return 1; }, 1);
+  entries[0].reset();
+  EXPECT_EQ(1, *sched->pickAndAdd([](const uint32_t&) { return 1; }));
+  EXPECT_EQ(1, *sched->pickAndAdd([](const uint32_t&) { return 1; }));
+}
+
+TEST(EdfSchedulerTest, CreateWithPicksEmpty) {
+  auto sched = EdfScheduler<uint32_t>::createWithPicks(std::vector<std::shared_ptr<uint32_t>>{},
+                                                       [](const uint32_t&) { return 1; }, 10);
+  EXPECT_TRUE(sched->empty());
+  EXPECT_EQ(nullptr, sched->pickAndAdd([](const uint32_t&) { return 1; }));
+}
+
 } // namespace
 } // namespace Upstream
 } // namespace Envoy
@@ -119,6 +119,48 @@ void uniqueWeightPickEdf(::benchmark::State& state) {
                             });
 }
 
+// Measures rebuilding an EDF schedule as the weighted load balancers do on every host set update:
+// adding every entry and then advancing the schedule by a seed-derived number of picks.
+void splitWeightRebuildEdf(::benchmark::State& state) {
+  const size_t num_objs = state.range(0);
+  std::vector<std::shared_ptr<SchedulerTester::ObjInfo>> info;
+  for (uint32_t i = 0; i < num_objs; ++i) {
+    info.push_back(std::make_shared<SchedulerTester::ObjInfo>());
+    info.back()->weight = i < num_objs / 2 ? 1 : 4;
+  }
+  std::shuffle(info.begin(), info.end(), std::default_random_engine());
+  const auto calculate_weight = [](const SchedulerTester::ObjInfo& i) { return i.weight; };
+  const uint32_t picks = num_objs / 2;
+
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    EdfScheduler<SchedulerTester::ObjInfo> edf;
+    for (const auto& oi : info) {
+      edf.add(oi->weight, oi);
+    }
+    for (uint32_t i = 0; i < picks; ++i) {
+      edf.pickAndAdd(calculate_weight);
+    }
+  }
+}
+
+// As above, but building the schedule with EdfScheduler::createWithPicks().
+void splitWeightCreateWithPicksEdf(::benchmark::State& state) {
+  const size_t num_objs = state.range(0);
+  std::vector<std::shared_ptr<SchedulerTester::ObjInfo>> info;
+  for (uint32_t i = 0; i < num_objs; ++i) {
+    info.push_back(std::make_shared<SchedulerTester::ObjInfo>());
+    info.back()->weight = i < num_objs / 2 ? 1 : 4;
+  }
+  std::shuffle(info.begin(), info.end(), std::default_random_engine());
+  const auto calculate_weight = [](const SchedulerTester::ObjInfo& i) { return i.weight; };
+  const uint32_t picks = num_objs / 2;
+
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    benchmark::DoNotOptimize(
+        EdfScheduler<SchedulerTester::ObjInfo>::createWithPicks(info, calculate_weight, picks));
+  }
+}
+
 void splitWeightAddWRSQ(::benchmark::State& state) {
   Random::RandomGeneratorImpl random;
   WRSQScheduler<SchedulerTester::ObjInfo> wrsq(random);
@@ -167,6 +209,14 @@ BENCHMARK(splitWeightAddWRSQ)
     ->Unit(::benchmark::kMicrosecond)
     ->RangeMultiplier(8)
     ->Range(1 << 6, 1 << 14);
+BENCHMARK(splitWeightRebuildEdf)
+    ->Unit(::benchmark::kMicrosecond)
+    ->RangeMultiplier(8)
+    ->Range(1 << 6, 1 << 15);
+BENCHMARK(splitWeightCreateWithPicksEdf)
+    ->Unit(::benchmark::kMicrosecond)
+    ->RangeMultiplier(8)
+    ->Range(1 << 6, 1 << 15);
 BENCHMARK(splitWeightPickEdf)->RangeMultiplier(8)->Range(1 << 6, 1 << 14);
 BENCHMARK(splitWeightPickWRSQ)->RangeMultiplier(8)->Range(1 << 6, 1 << 14);
 BENCHMARK(uniqueWeightAddEdf)
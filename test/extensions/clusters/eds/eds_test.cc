@@ -37,6 +37,18 @@ using testing::SaveArg;
 
 namespace Envoy {
 namespace Upstream {
+
+class EdsClusterImplPeer {
+public:
+  // Makes the endpoint hashes of the last update collide, by exchanging the remembered hosts of two
+  // endpoints.
+  static void swapHostsByEndpointHash(EdsClusterImpl& cluster) {
+    auto& hosts = cluster.hosts_by_endpoint_hash_;
+    ASSERT_EQ(2, hosts.size());
+    std::swap(hosts.begin()->second, std::next(hosts.begin())->second);
+  }
+};
+
 namespace {
 
 class EdsTest : public testing::Test, public Event::TestUsingSimulatedTime {
@@ -386,6 +398,106 @@ TEST_F(EdsTest, EndpointWeightChangeCausesRebuild) {
   EXPECT_EQ(new_hosts[0]->weight(), 31);
 }
 
+// Verify that the hosts of unchanged endpoints are kept across updates, while changed, added and
+// removed endpoints are still applied.
+TEST_F(EdsTest, UnchangedEndpointsKeepHosts) {
+  envoy::config::endpoint::v3::ClusterLoadAssignment cluster_load_assignment;
+  cluster_load_assignment.set_cluster_name("fare");
+  auto* endpoints = cluster_load_assignment.add_endpoints();
+  endpoints->mutable_locality()->set_region("oceania");
+  auto add_endpoint = [endpoints](const std::string& address) {
+    auto* endpoint = endpoints->add_lb_endpoints();
+    endpoint->mutable_endpoint()->mutable_address()->mutable_socket_address()->set_address(address);
+    endpoint->mutable_endpoint()->mutable_address()->mutable_socket_address()->set_port_value(80);
+    endpoint->mutable_load_balancing_weight()->set_value(1);
+    return endpoint;
+  };
+  add_endpoint("1.2.3.4");
+  auto* changed_endpoint = add_endpoint("2.3.4.5");
+  add_endpoint("3.4.5.6");
+
+  auto hosts_by_address = [this]() {
+    absl::flat_hash_map<std::string, HostSharedPtr> hosts;
+    for (const auto& host : cluster_->prioritySet().hostSetsPerPriority()[0]->hosts()) {
+      hosts.emplace(host->address()->asString(), host);
+    }
+    return hosts;
+  };
+
+  initialize();
+  doOnConfigUpdateVerifyNoThrow(cluster_load_assignment);
+  EXPECT_TRUE(initialized_);
+  const auto initial_hosts = hosts_by_address();
+  EXPECT_EQ(3, initial_hosts.size());
+
+  // The exact same config keeps every host, without a rebuild.
+  doOnConfigUpdateVerifyNoThrow(cluster_load_assignment);
+  EXPECT_EQ(1UL,
+            stats_.findCounterByString("cluster.name.update_no_rebuild").value().get().value());
+  EXPECT_EQ(initial_hosts, hosts_by_address());
+
+  // Change the weight of one endpoint, remove another one and add a new one.
+  changed_endpoint->mutable_load_balancing_weight()->set_value(5);
+  endpoints->mutable_lb_endpoints()->RemoveLast();
+  add_endpoint("4.5.6.7");
+  doOnConfigUpdateVerifyNoThrow(cluster_load_assignment);
+  {
+    const auto hosts = hosts_by_address();
+    EXPECT_EQ(3, hosts.size());
+    EXPECT_EQ(initial_hosts.at("1.2.3.4:80"), hosts.at("1.2.3.4:80"));
+    EXPECT_EQ(initial_hosts.at("2.3.4.5:80"), hosts.at("2.3.4.5:80"));
+    EXPECT_EQ(5, hosts.at("2.3.4.5:80")->weight());
+    EXPECT_EQ(1, hosts.at("4.5.6.7:80")->weight());
+    EXPECT_FALSE(hosts.contains("3.4.5.6:80"));
+  }
+
+  // Moving the endpoints to another locality and back replaces their hosts both times, rather than
+  // bringing back the hosts of the original locality.
+  endpoints->mutable_locality()->set_region("space");
+  doOnConfigUpdateVerifyNoThrow(cluster_load_assignment);
+  endpoints->mutable_locality()->set_region("oceania");
+  doOnConfigUpdateVerifyNoThrow(cluster_load_assignment);
+  {
+    const auto hosts = hosts_by_address();
+    EXPECT_EQ(3, hosts.size());
+    for (const auto& [address, host] : hosts) {
+      EXPECT_EQ("oceania", host->locality().region());
+    }
+    EXPECT_NE(initial_hosts.at("1.2.3.4:80"), hosts.at("1.2.3.4:80"));
+    EXPECT_EQ(5, hosts.at("2.3.4.5:80")->weight());
+  }
+}
+
+// Verify that an endpoint whose hash matches the remembered host of another endpoint does not reuse
+// that host.
+TEST_F(EdsTest, EndpointHashCollisionDoesNotReuseHost) {
+  envoy::config::endpoint::v3::ClusterLoadAssignment cluster_load_assignment;
+  cluster_load_assignment.set_cluster_name("fare");
+  auto* endpoints = cluster_load_assignment.add_endpoints();
+  for (const std::string address : {"1.2.3.4", "2.3.4.5"}) {
+    auto* endpoint = endpoints->add_lb_endpoints();
+    endpoint->mutable_endpoint()->mutable_address()->mutable_socket_address()->set_address(address);
+    endpoint->mutable_endpoint()->mutable_address()->mutable_socket_address()->set_port_value(80);
+  }
+
+  initialize();
+  doOnConfigUpdateVerifyNoThrow(cluster_load_assignment);
+  EXPECT_TRUE(initialized_);
+  const HostVector initial_hosts = cluster_->prioritySet().hostSetsPerPriority()[0]->hosts();
+  ASSERT_EQ(2, initial_hosts.size());
+
+  // Each endpoint now finds the host of the other one by hash. Both are still built from their own
+  // endpoint, and then matched to their existing host by address.
+  EdsClusterImplPeer::swapHostsByEndpointHash(*cluster_);
+  doOnConfigUpdateVerifyNoThrow(cluster_load_assignment);
+  const auto& hosts = cluster_->prioritySet().hostSetsPerPriority()[0]->hosts();
+  ASSERT_EQ(2, hosts.size());
+  EXPECT_EQ("1.2.3.4:80", hosts[0]->address()->asString());
+  EXPECT_EQ("2.3.4.5:80", hosts[1]->address()->asString());
+  EXPECT_EQ(initial_hosts[0], hosts[0]);
+  EXPECT_EQ(initial_hosts[1], hosts[1]);
+}
+
 // Verify that host weight changes cause a full rebuild.
 TEST_F(EdsTest, DualStackEndpoint) {
   envoy::config::endpoint::v3::ClusterLoadAssignment cluster_load_assignment;
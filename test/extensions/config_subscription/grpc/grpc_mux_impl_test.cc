@@ -82,8 +82,9 @@ public:
             SubscriptionFactory::RetryInitialDelayMs, SubscriptionFactory::RetryMaxDelayMs,
             random_),
         /*target_xds_authority_=*/"",
-        /*eds_resources_cache_=*/std::unique_ptr<MockEdsResourcesCache>(eds_resources_cache_)};
-    grpc_mux_ = std::make_unique<GrpcMuxImpl>(grpc_mux_context, true);
+        /*eds_resources_cache_=*/std::unique_ptr<MockEdsResourcesCache>(eds_resources_cache_),
+        /*thread_factory_=*/Thread::threadFactoryForTest()};
+    grpc_mux_ = std::make_unique<GrpcMuxImpl>(grpc_mux_context, true, resource_decoding_threads_);
   }
 
   void expectSendMessage(const std::string& type_url,
@@ -125,6 +126,7 @@ public:
   Stats::Gauge& control_plane_connected_state_;
   Stats::Gauge& control_plane_pending_requests_;
   MockEdsResourcesCache* eds_resources_cache_{nullptr};
+  uint32_t resource_decoding_threads_{0};
 };
 
 class GrpcMuxImplTest : public GrpcMuxImplTestBase {
@@ -659,6 +661,76 @@ TEST_F(GrpcMuxImplTest, WildcardWatch) {
   }
 }
 
+// Validate that resources decoded on several threads are delivered in order, and that an invalid
+// resource still rejects the update.
+TEST_F(GrpcMuxImplTest, ParallelResourceDecoding) {
+  resource_decoding_threads_ = 4;
+  setup();
+
+  InSequence s;
+  const std::string& type_url = Config::TypeUrl::get().ClusterLoadAssignment;
+  OpaqueResourceDecoderSharedPtr resource_decoder(
+      std::make_shared<TestUtility::TestOpaqueResourceDecoderImpl<
+          envoy::config::endpoint::v3::ClusterLoadAssignment>>("cluster_name"));
+  auto foo_sub = grpc_mux_->addWatch(type_url, {}, callbacks_, resource_decoder, {});
+  EXPECT_CALL(*async_client_, startRaw(_, _, _, _)).WillOnce(Return(&async_stream_));
+  expectSendMessage(type_url, {}, "", true);
+  grpc_mux_->start();
+
+  const int num_resources = 100;
+  {
+    auto response = std::make_unique<envoy::service::discovery::v3::DiscoveryResponse>();
+    response->set_type_url(type_url);
+    response->set_version_info("1");
+    for (int i = 0; i < num_resources; ++i) {
+      envoy::config::endpoint::v3::ClusterLoadAssignment load_assignment;
+      load_assignment.set_cluster_name(absl::StrCat("cluster_", i));
+      // Wrap every other resource in a Resource.
+      if (i % 2 == 0) {
+        response->add_resources()->PackFrom(load_assignment);
+      } else {
+        envoy::service::discovery::v3::Resource resource;
+        resource.set_name(absl::StrCat("cluster_", i));
+        resource.mutable_resource()->PackFrom(load_assignment);
+        response->add_resources()->PackFrom(resource);
+      }
+    }
+    EXPECT_CALL(callbacks_, onConfigUpdate(_, "1"))
+        .WillOnce(Invoke([num_resources](const std::vector<DecodedResourceRef>& resources,
+                                         const std::string&) {
+          EXPECT_EQ(num_resources, resources.size());
+          for (int i = 0; i < num_resources; ++i) {
+            EXPECT_EQ(absl::StrCat("cluster_", i), resources[i].get().name());
+            EXPECT_EQ(absl::StrCat("cluster_", i),
+                      dynamic_cast<const envoy::config::endpoint::v3::ClusterLoadAssignment&>(
+                          resources[i].get().resource())
+                          .cluster_name());
+          }
+          return absl::OkStatus();
+        }));
+    expectSendMessage(type_url, {}, "1");
+    grpc_mux_->grpcStreamForTest().onReceiveMessage(std::move(response));
+  }
+
+  {
+    auto response = std::make_unique<envoy::service::discovery::v3::DiscoveryResponse>();
+    response->set_type_url(type_url);
+    response->set_version_info("2");
+    for (int i = 0; i < num_resources; ++i) {
+      envoy::config::endpoint::v3::ClusterLoadAssignment load_assignment;
+      // An empty cluster name fails validation.
+      load_assignment.set_cluster_name(i == num_resources / 2 ? "" : absl::StrCat("cluster_", i));
+      response->add_resources()->PackFrom(load_assignment);
+    }
+    EXPECT_CALL(callbacks_, onConfigUpdateFailed(_, _))
+        .WillOnce(Invoke([](Envoy::Config::ConfigUpdateFailureReason, const EnvoyException* e) {
+          EXPECT_TRUE(IsSubstring("", "", "Proto constraint validation failed", e->what()));
+        }));
+    EXPECT_CALL(async_stream_, sendMessageRaw_(_, false));
+    grpc_mux_->grpcStreamForTest().onReceiveMessage(std::move(response));
+  }
+}
+
 // Validate behavior when watches specify resources (potentially overlapping).
 TEST_F(GrpcMuxImplTest, WatchDemux) {
   setup();
@@ -1034,9 +1106,10 @@ TEST_F(GrpcMuxImplTest, BadLocalInfoEmptyClusterName) {
       std::make_unique<JitteredExponentialBackOffStrategy>(
           SubscriptionFactory::RetryInitialDelayMs, SubscriptionFactory::RetryMaxDelayMs, random_),
       /*target_xds_authority_=*/"",
-      /*eds_resources_cache_=*/nullptr};
+      /*eds_resources_cache_=*/nullptr,
+      /*thread_factory_=*/Thread::threadFactoryForTest()};
   EXPECT_THROW_WITH_MESSAGE(
-      GrpcMuxImpl(grpc_mux_context, true), EnvoyException,
+      GrpcMuxImpl(grpc_mux_context, true, 0), EnvoyException,
       "ads: node 'id' and 'cluster' are required. Set it either in 'node' config or via "
       "--service-node and --service-cluster options.");
 }
@@ -1059,9 +1132,10 @@ TEST_F(GrpcMuxImplTest, BadLocalInfoEmptyNodeName) {
       std::make_unique<JitteredExponentialBackOffStrategy>(
           SubscriptionFactory::RetryInitialDelayMs, SubscriptionFactory::RetryMaxDelayMs, random_),
       /*target_xds_authority_=*/"",
-      /*eds_resources_cache_=*/nullptr};
+      /*eds_resources_cache_=*/nullptr,
+      /*thread_factory_=*/Thread::threadFactoryForTest()};
   EXPECT_THROW_WITH_MESSAGE(
-      GrpcMuxImpl(grpc_mux_context, true), EnvoyException,
+      GrpcMuxImpl(grpc_mux_context, true, 0), EnvoyException,
       "ads: node 'id' and 'cluster' are required. Set it either in 'node' config or via "
       "--service-node and --service-cluster options.");
 }
@@ -100,8 +100,9 @@ protected:
     xds_resources_delegate_ = std::make_unique<TestXdsResourcesDelegate>();
     state_ = std::make_unique<XdsMux::SotwSubscriptionState>(
         Config::getTypeUrl<envoy::config::endpoint::v3::ClusterLoadAssignment>(), callbacks_,
-        dispatcher_, resource_decoder_, /*xds_config_tracker=*/XdsConfigTrackerOptRef(),
-        *xds_resources_delegate_, /*target_xds_authority=*/"some_random_xds_server");
+        dispatcher_, resource_decoder_, parallel_resource_decoder_,
+        /*xds_config_tracker=*/XdsConfigTrackerOptRef(), *xds_resources_delegate_,
+        /*target_xds_authority=*/"some_random_xds_server");
     state_->updateSubscriptionInterest({"name1", "name2", "name3"}, {});
     auto cur_request = getNextDiscoveryRequestAckless();
     EXPECT_THAT(cur_request->resource_names(), UnorderedElementsAre("name1", "name2", "name3"));
@@ -181,6 +182,7 @@ protected:
   NiceMock<Event::MockDispatcher> dispatcher_;
   Event::MockTimer* ttl_timer_;
   std::unique_ptr<TestXdsResourcesDelegate> xds_resources_delegate_;
+  const ParallelResourceDecoder parallel_resource_decoder_{absl::nullopt, 0};
   // We start out interested in three resources: name1, name2, and name3.
   std::unique_ptr<XdsMux::SotwSubscriptionState> state_;
 };
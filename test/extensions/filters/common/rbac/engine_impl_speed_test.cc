@@ -0,0 +1,107 @@
+// Note: this should be run with --compilation_mode=opt, and would benefit from a
+// quiescent system with disabled cstate power management.
+
+#include "envoy/config/rbac/v3/rbac.pb.h"
+
+#include "source/common/network/utility.h"
+#include "source/extensions/filters/common/rbac/engine_impl.h"
+
+#include "test/mocks/network/mocks.h"
+#include "test/mocks/ssl/mocks.h"
+#include "test/mocks/stream_info/mocks.h"
+#include "test/test_common/utility.h"
+
+#include "absl/strings/str_cat.h"
+#include "benchmark/benchmark.h"
+
+using testing::Const;
+using testing::NiceMock;
+using testing::Return;
+using testing::ReturnRef;
+
+namespace Envoy {
+namespace Extensions {
+namespace Filters {
+namespace Common {
+namespace RBAC {
+namespace {
+
+// Adds a policy whose principals are num_principals IP ranges, SPIFFE IDs and x-user header
+// values, numbered from first.
+void addPolicy(envoy::config::rbac::v3::RBAC& rbac, uint32_t policy, uint32_t first,
+               uint32_t num_principals) {
+  auto& config = (*rbac.mutable_policies())[absl::StrCat("policy-", policy)];
+  config.add_permissions()->set_any(true);
+  for (uint32_t i = first; i < first + num_principals; i++) {
+    auto* cidr = config.add_principals()->mutable_direct_remote_ip();
+    cidr->set_address_prefix(absl::StrCat("10.", (i >> 8) & 0xff, ".", i & 0xff, ".0"));
+    cidr->mutable_prefix_len()->set_value(24);
+    config.add_principals()->mutable_authenticated()->mutable_principal_name()->set_exact(
+        absl::StrCat("spiffe://cluster.local/ns/default/sa/", i));
+    auto* header = config.add_principals()->mutable_header();
+    header->set_name("x-user");
+    header->mutable_string_match()->set_exact(absl::StrCat("user-", i));
+  }
+}
+
+class EngineSpeedTestContext {
+public:
+  EngineSpeedTestContext(uint32_t num_policies, uint32_t principals_per_policy)
+      : ssl_(std::make_shared<NiceMock<Ssl::MockConnectionInfo>>()) {
+    envoy::config::rbac::v3::RBAC rbac;
+    rbac.set_action(envoy::config::rbac::v3::RBAC::ALLOW);
+    for (uint32_t policy = 0; policy < num_policies; policy++) {
+      addPolicy(rbac, policy, policy * principals_per_policy, principals_per_policy);
+    }
+    engine_ = std::make_unique<RoleBasedAccessControlEngineImpl>(
+        rbac, ProtobufMessage::getStrictValidationVisitor());
+
+    // The request does not match any principal, which is the worst case: every policy is
+    // evaluated.
+    info_.downstream_connection_info_provider_->setDirectRemoteAddressForTest(
+        Network::Utility::parseInternetAddress("192.168.0.1", 443, false));
+    ON_CALL(*ssl_, uriSanPeerCertificate()).WillByDefault(Return(uri_sans_));
+    ON_CALL(*ssl_, subjectPeerCertificate()).WillByDefault(ReturnRef(subject_));
+    ON_CALL(Const(connection_), ssl()).WillByDefault(Return(ssl_));
+  }
+
+  bool check() { return engine_->handleAction(connection_, headers_, info_, nullptr); }
+
+private:
+  std::unique_ptr<RoleBasedAccessControlEngineImpl> engine_;
+  NiceMock<Network::MockConnection> connection_;
+  std::shared_ptr<NiceMock<Ssl::MockConnectionInfo>> ssl_;
+  const std::vector<std::string> uri_sans_{"spiffe://cluster.local/ns/default/sa/unknown"};
+  const std::string subject_{"CN=unknown"};
+  Http::TestRequestHeaderMapImpl headers_{
+      {":method", "GET"}, {":path", "/"}, {":authority", "host"}, {"x-user", "unknown"}};
+  NiceMock<StreamInfo::MockStreamInfo> info_;
+};
+
+// Measures a request that matches none of 1k policies, as the number of principals of each kind
+// per policy grows.
+static void bmManyPolicies(benchmark::State& state) {
+  EngineSpeedTestContext context(1000, state.range(0));
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    benchmark::DoNotOptimize(context.check());
+  }
+}
+BENCHMARK(bmManyPolicies)->Arg(1)->Arg(4)->Arg(16)->Unit(benchmark::kMicrosecond);
+
+// Measures a request that matches none of the principals of a single large policy.
+static void bmLargePolicy(benchmark::State& state) {
+  EngineSpeedTestContext context(1, state.range(0));
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    benchmark::DoNotOptimize(context.check());
+  }
+}
+BENCHMARK(bmLargePolicy)->Arg(10)->Arg(100)->Arg(1000)->Unit(benchmark::kMicrosecond);
+
+} // namespace
+} // namespace RBAC
+} // namespace Common
+} // namespace Filters
+} // namespace Extensions
+} // namespace Envoy
@@ -144,6 +144,105 @@ TEST(OrMatcher, Principal_Set) {
   checkMatcher(RBAC::OrMatcher(set), true, conn, headers, info);
 }
 
+TEST(OrMatcher, MergesIpRanges) {
+  envoy::config::rbac::v3::Principal::Set set;
+  for (const std::string& prefix : {"10.0.0.0", "10.1.0.0", "10.2.0.0", "10.3.0.0", "10.3.0.0"}) {
+    auto* cidr = set.add_ids()->mutable_direct_remote_ip();
+    cidr->set_address_prefix(prefix);
+    cidr->mutable_prefix_len()->set_value(16);
+  }
+  auto* cidr = set.add_ids()->mutable_remote_ip();
+  cidr->set_address_prefix("::1");
+  cidr->mutable_prefix_len()->set_value(128);
+  const RBAC::OrMatcher matcher(set);
+
+  Envoy::Network::MockConnection conn;
+  Envoy::Http::TestRequestHeaderMapImpl headers;
+  NiceMock<StreamInfo::MockStreamInfo> info;
+  info.downstream_connection_info_provider_->setDirectRemoteAddressForTest(
+      Envoy::Network::Utility::parseInternetAddress("10.3.2.1", 123, false));
+  checkMatcher(matcher, true, conn, headers, info);
+
+  info.downstream_connection_info_provider_->setDirectRemoteAddressForTest(
+      Envoy::Network::Utility::parseInternetAddress("10.4.2.1", 123, false));
+  checkMatcher(matcher, false, conn, headers, info);
+
+  // The ranges of another kind of address are not merged with them.
+  info.downstream_connection_info_provider_->setRemoteAddress(
+      Envoy::Network::Utility::parseInternetAddress("::1", 123, false));
+  checkMatcher(matcher, true, conn, headers, info);
+
+  info.downstream_connection_info_provider_->setDirectRemoteAddressForTest(
+      std::make_shared<const Envoy::Network::Address::PipeInstance>("test"));
+  info.downstream_connection_info_provider_->setRemoteAddress(
+      std::make_shared<const Envoy::Network::Address::PipeInstance>("test"));
+  checkMatcher(matcher, false, conn, headers, info);
+}
+
+TEST(OrMatcher, MergesExactHeaderValues) {
+  envoy::config::rbac::v3::Permission::Set set;
+  for (const std::string& value : {"a", "b", "c", "d"}) {
+    auto* header = set.add_rules()->mutable_header();
+    header->set_name("x-user");
+    header->mutable_string_match()->set_exact(value);
+  }
+  // Not merged, since it does not match a single value.
+  auto* header = set.add_rules()->mutable_header();
+  header->set_name("x-user");
+  header->mutable_string_match()->set_prefix("admin-");
+  const RBAC::OrMatcher matcher(set, ProtobufMessage::getStrictValidationVisitor());
+
+  checkMatcher(matcher, true, Envoy::Network::MockConnection(),
+               Envoy::Http::TestRequestHeaderMapImpl{{"x-user", "c"}});
+  checkMatcher(matcher, true, Envoy::Network::MockConnection(),
+               Envoy::Http::TestRequestHeaderMapImpl{{"x-user", "admin-e"}});
+  checkMatcher(matcher, false, Envoy::Network::MockConnection(),
+               Envoy::Http::TestRequestHeaderMapImpl{{"x-user", "e"}});
+  // Multiple values are concatenated, as for a single HeaderMatcher.
+  checkMatcher(matcher, false, Envoy::Network::MockConnection(),
+               Envoy::Http::TestRequestHeaderMapImpl{{"x-user", "a"}, {"x-user", "b"}});
+  checkMatcher(matcher, false);
+}
+
+TEST(OrMatcher, MergesExactPrincipalNames) {
+  envoy::config::rbac::v3::Principal::Set set;
+  for (const std::string& name : {"spiffe://a", "spiffe://b", "b.example.com", "subject"}) {
+    set.add_ids()->mutable_authenticated()->mutable_principal_name()->set_exact(name);
+  }
+  const RBAC::OrMatcher matcher(set);
+
+  Envoy::Network::MockConnection conn;
+  auto ssl = std::make_shared<Ssl::MockConnectionInfo>();
+  const std::vector<std::string> uri_sans{"spiffe://c"};
+  const std::vector<std::string> dns_sans{"b.example.com"};
+  const std::string subject = "other";
+  EXPECT_CALL(*ssl, uriSanPeerCertificate()).WillRepeatedly(Return(uri_sans));
+  EXPECT_CALL(*ssl, dnsSansPeerCertificate()).WillRepeatedly(Return(dns_sans));
+  EXPECT_CALL(*ssl, subjectPeerCertificate()).WillRepeatedly(ReturnRef(subject));
+  EXPECT_CALL(Const(conn), ssl()).WillRepeatedly(Return(ssl));
+  checkMatcher(matcher, true, conn);
+
+  const std::vector<std::string> other_dns_sans{"c.example.com"};
+  EXPECT_CALL(*ssl, dnsSansPeerCertificate()).WillRepeatedly(Return(other_dns_sans));
+  checkMatcher(matcher, false, conn);
+
+  EXPECT_CALL(Const(conn), ssl()).WillRepeatedly(Return(nullptr));
+  checkMatcher(matcher, false, conn);
+}
+
+TEST(OrMatcher, DropsRepeatedRules) {
+  envoy::config::rbac::v3::Permission::Set set;
+  set.add_rules()->set_destination_port(123);
+  set.add_rules()->set_destination_port(123);
+  set.add_rules()->set_destination_port(456);
+
+  NiceMock<StreamInfo::MockStreamInfo> info;
+  info.downstream_connection_info_provider_->setLocalAddress(
+      Envoy::Network::Utility::parseInternetAddress("1.2.3.4", 456, false));
+  checkMatcher(RBAC::OrMatcher(set, ProtobufMessage::getStrictValidationVisitor()), true,
+               Envoy::Network::MockConnection(), Envoy::Http::TestRequestHeaderMapImpl(), info);
+}
+
 TEST(NotMatcher, Permission) {
   envoy::config::rbac::v3::Permission perm;
   perm.set_any(true);
@@ -159,6 +159,54 @@ TEST_P(CacheIntegrationTest, MissInsertHit) {
   }
 }
 
+TEST_P(CacheIntegrationTest, CoalescesConcurrentMisses) {
+  initializeFilter(R"EOF(
+    name: "envoy.filters.http.cache"
+    typed_config:
+        "@type": "type.googleapis.com/envoy.extensions.filters.http.cache.v3.CacheConfig"
+        request_coalescing_timeout: 60s
+        typed_config:
+           "@type": "type.googleapis.com/envoy.extensions.http.cache.simple_http_cache.v3.SimpleHttpCacheConfig"
+    )EOF");
+
+  const Http::TestRequestHeaderMapImpl request_headers =
+      httpRequestHeader("GET", /*authority=*/"CoalescesConcurrentMisses");
+  const std::string response_body(42, 'a');
+  Http::TestResponseHeaderMapImpl response_headers = httpResponseHeadersForBody(response_body);
+
+  // The first request misses and is sent upstream to fill the cache.
+  IntegrationStreamDecoderPtr fill_response =
+      codec_client_->makeHeaderOnlyRequest(request_headers);
+  waitForNextUpstreamRequest();
+
+  // Concurrent requests for the same key wait on the in-flight fill instead of going upstream.
+  constexpr uint32_t num_waiters = 4;
+  std::vector<IntegrationCodecClientPtr> waiter_clients;
+  std::vector<IntegrationStreamDecoderPtr> waiter_responses;
+  for (uint32_t i = 0; i < num_waiters; ++i) {
+    waiter_clients.push_back(makeHttpConnection(makeClientConnection(lookupPort("http"))));
+    waiter_responses.push_back(waiter_clients.back()->makeHeaderOnlyRequest(request_headers));
+  }
+  test_server_->waitForCounterEq("http.config_test.cache.coalesced_requests", num_waiters);
+
+  upstream_request_->encodeHeaders(response_headers, /*end_stream=*/false);
+  upstream_request_->encodeData(response_body, /*end_stream=*/true);
+  ASSERT_TRUE(fill_response->waitForEndStream());
+  EXPECT_EQ(fill_response->body(), response_body);
+
+  // Once the fill completes, every waiter is served from the cache.
+  for (IntegrationStreamDecoderPtr& response : waiter_responses) {
+    ASSERT_TRUE(response->waitForEndStream());
+    EXPECT_THAT(response->headers(), IsSupersetOfHeaders(response_headers));
+    EXPECT_EQ(response->body(), response_body);
+  }
+  for (IntegrationCodecClientPtr& client : waiter_clients) {
+    client->close();
+  }
+  EXPECT_EQ(1, test_server_->counter("cluster.cluster_0.upstream_rq_total")->value());
+  EXPECT_EQ(0, test_server_->counter("http.config_test.cache.coalesced_request_timeouts")->value());
+}
+
 TEST_P(CacheIntegrationTest, ExpiredValidated) {
   initializeFilter(default_config);
 
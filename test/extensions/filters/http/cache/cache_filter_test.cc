@@ -1,6 +1,7 @@
 #include "envoy/event/dispatcher.h"
 
 #include "source/common/http/headers.h"
+#include "source/common/stats/isolated_store_impl.h"
 #include "source/extensions/filters/http/cache/cache_filter.h"
 #include "source/extensions/filters/http/cache/cache_filter_logging_info.h"
 #include "source/extensions/http/cache/simple_http_cache/simple_http_cache.h"
@@ -32,7 +33,7 @@ protected:
   CacheFilterSharedPtr makeFilter(std::shared_ptr<HttpCache> cache, bool auto_destroy = true) {
     std::shared_ptr<CacheFilter> filter(
         new CacheFilter(config_, /*stats_prefix=*/"", context_.scope(),
-                        context_.server_factory_context_.timeSource(), cache),
+                        context_.server_factory_context_.timeSource(), cache, request_coalescer_),
         [auto_destroy](CacheFilter* f) {
           if (auto_destroy) {
             f->onDestroy();
@@ -161,8 +162,12 @@ protected:
 
   void waitBeforeSecondRequest() { time_source_.advanceTimeWait(delay_); }
 
-  std::shared_ptr<SimpleHttpCache> simple_cache_ = std::make_shared<SimpleHttpCache>();
+  Stats::IsolatedStoreImpl stats_store_;
+  std::shared_ptr<SimpleHttpCache> simple_cache_ = std::make_shared<SimpleHttpCache>(
+      envoy::extensions::http::cache::simple_http_cache::v3::SimpleHttpCacheConfig(),
+      *stats_store_.rootScope());
   envoy::extensions::filters::http::cache::v3::CacheConfig config_;
+  RequestCoalescerSharedPtr request_coalescer_;
   std::shared_ptr<StreamInfo::FilterState> filter_state_ =
       std::make_shared<StreamInfo::FilterStateImpl>(StreamInfo::FilterState::LifeSpan::FilterChain);
   NiceMock<Server::Configuration::MockFactoryContext> context_;
@@ -316,6 +321,100 @@ TEST_F(CacheFilterTest, CacheHitNoBody) {
   }
 }
 
+class CacheFilterCoalescingTest : public CacheFilterTest {
+protected:
+  void SetUp() override {
+    CacheFilterTest::SetUp();
+    ON_CALL(waiter_decoder_callbacks_, dispatcher())
+        .WillByDefault(::testing::ReturnRef(*dispatcher_));
+  }
+
+  void enableCoalescing(std::chrono::milliseconds timeout) {
+    request_coalescer_ =
+        std::make_shared<RequestCoalescer>(timeout, *stats_store_.rootScope(), /*stats_prefix=*/"");
+  }
+
+  // Starts a request for the same key as an in-flight miss, which should wait on that miss's fill.
+  CacheFilterSharedPtr makeWaitingFilter() {
+    CacheFilterSharedPtr filter = makeFilter(simple_cache_);
+    filter->setDecoderFilterCallbacks(waiter_decoder_callbacks_);
+    EXPECT_CALL(waiter_decoder_callbacks_, continueDecoding).Times(0);
+    EXPECT_EQ(filter->decodeHeaders(waiter_request_headers_, true),
+              Http::FilterHeadersStatus::StopAllIterationAndWatermark);
+    // The waiter's timer is armed, so only run the lookup callback that is ready.
+    dispatcher_->run(Event::Dispatcher::RunType::NonBlock);
+    ::testing::Mock::VerifyAndClearExpectations(&waiter_decoder_callbacks_);
+    return filter;
+  }
+
+  uint64_t counter(absl::string_view name) {
+    return TestUtility::findCounter(stats_store_, absl::StrCat("cache.", name))->value();
+  }
+
+  NiceMock<Http::MockStreamDecoderFilterCallbacks> waiter_decoder_callbacks_;
+  Http::TestRequestHeaderMapImpl waiter_request_headers_;
+};
+
+TEST_F(CacheFilterCoalescingTest, WaiterServedFromCacheAfterFill) {
+  request_headers_.setHost("WaiterServedFromCacheAfterFill");
+  waiter_request_headers_ = request_headers_;
+  enableCoalescing(std::chrono::seconds(60));
+
+  CacheFilterSharedPtr filler = makeFilter(simple_cache_);
+  testDecodeRequestMiss(filler);
+  CacheFilterSharedPtr waiter = makeWaitingFilter();
+  EXPECT_EQ(1, counter("coalesced_requests"));
+
+  // The filler's response is inserted, then the filler finishes, which wakes the waiter. The
+  // waiter repeats its lookup and is served from the cache without going upstream.
+  EXPECT_EQ(filler->encodeHeaders(response_headers_, true), Http::FilterHeadersStatus::Continue);
+  dispatcher_->run(Event::Dispatcher::RunType::NonBlock);
+  filler.reset();
+
+  EXPECT_CALL(waiter_decoder_callbacks_, continueDecoding).Times(0);
+  EXPECT_CALL(waiter_decoder_callbacks_,
+              encodeHeaders_(IsSupersetOfHeaders(response_headers_), true));
+  dispatcher_->run(Event::Dispatcher::RunType::Block);
+  EXPECT_EQ(0, counter("coalesced_request_timeouts"));
+}
+
+TEST_F(CacheFilterCoalescingTest, WaiterGoesUpstreamOnTimeout) {
+  request_headers_.setHost("WaiterGoesUpstreamOnTimeout");
+  waiter_request_headers_ = request_headers_;
+  enableCoalescing(std::chrono::milliseconds(1));
+
+  CacheFilterSharedPtr filler = makeFilter(simple_cache_);
+  testDecodeRequestMiss(filler);
+  CacheFilterSharedPtr waiter = makeWaitingFilter();
+
+  EXPECT_CALL(waiter_decoder_callbacks_, continueDecoding);
+  dispatcher_->run(Event::Dispatcher::RunType::Block);
+  EXPECT_EQ(1, counter("coalesced_requests"));
+  EXPECT_EQ(1, counter("coalesced_request_timeouts"));
+
+  // The fill finishing later has no effect on the waiter.
+  EXPECT_CALL(waiter_decoder_callbacks_, continueDecoding).Times(0);
+  filler.reset();
+  dispatcher_->run(Event::Dispatcher::RunType::Block);
+}
+
+TEST_F(CacheFilterCoalescingTest, WaiterGoesUpstreamWhenFillNotCacheable) {
+  request_headers_.setHost("WaiterGoesUpstreamWhenFillNotCacheable");
+  waiter_request_headers_ = request_headers_;
+  enableCoalescing(std::chrono::seconds(60));
+
+  CacheFilterSharedPtr filler = makeFilter(simple_cache_);
+  testDecodeRequestMiss(filler);
+  CacheFilterSharedPtr waiter = makeWaitingFilter();
+
+  // An uncacheable response wakes the waiter straight away, and its repeated lookup misses.
+  response_headers_.setReferenceKey(Http::CustomHeaders::get().CacheControl, "no-store");
+  EXPECT_EQ(filler->encodeHeaders(response_headers_, true), Http::FilterHeadersStatus::Continue);
+  EXPECT_CALL(waiter_decoder_callbacks_, continueDecoding);
+  dispatcher_->run(Event::Dispatcher::RunType::Block);
+  EXPECT_EQ(0, counter("coalesced_request_timeouts"));
+}
+
 TEST_F(CacheFilterTest, CacheHitWithBody) {
   request_headers_.setHost("CacheHitWithBody");
   const std::string body = "abc";
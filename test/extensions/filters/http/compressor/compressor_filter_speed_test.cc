@@ -688,6 +688,61 @@ BENCHMARK(compressChunks1024WithBrotli)
     ->UseManualTime()
     ->Unit(benchmark::kMillisecond);
 
+// Measures the compression of small JSON responses of a static resource with a strong ETag, with
+// and without the compressed response cache.
+static void compressSmallJsonWithZstd(benchmark::State& state, bool cache_responses) {
+  Stats::IsolatedStoreImpl stats;
+  testing::NiceMock<Runtime::MockLoader> runtime;
+  envoy::extensions::filters::http::compressor::v3::Compressor compressor;
+  if (cache_responses) {
+    compressor.mutable_response_direction_config()->mutable_compressed_response_cache();
+  }
+  CompressorFilterConfigSharedPtr config = std::make_shared<CompressorFilterConfig>(
+      compressor, "test.", *stats.rootScope(), runtime,
+      std::make_unique<MockZstdCompressorFactory>(3, 0));
+  ON_CALL(runtime.snapshot_, featureEnabled("test.filter_enabled", 100))
+      .WillByDefault(Return(true));
+
+  std::string body = "[";
+  for (uint32_t i = 0; i < 16; ++i) {
+    absl::StrAppend(&body, i == 0 ? "" : ",", "{\"id\":", i,
+                    ",\"name\":\"item\",\"enabled\":true,\"tags\":[\"a\",\"b\"]}");
+  }
+  body += "]";
+
+  NiceMock<Http::MockStreamDecoderFilterCallbacks> decoder_callbacks;
+  for (auto _ : state) { // NOLINT
+    CompressorFilter filter(config);
+    filter.setDecoderFilterCallbacks(decoder_callbacks);
+    Http::TestRequestHeaderMapImpl headers = {{":method", "get"},
+                                              {":authority", "example.com"},
+                                              {":path", "/items.json"},
+                                              {"accept-encoding", "zstd"}};
+    filter.decodeHeaders(headers, true);
+    Http::TestResponseHeaderMapImpl response_headers = {
+        {":status", "200"},
+        {"content-length", absl::StrCat(body.size())},
+        {"content-type", "application/json"},
+        {"etag", "\"v1\""}};
+    filter.encodeHeaders(response_headers, false);
+    Buffer::OwnedImpl data(body);
+    filter.encodeData(data, true);
+    benchmark::DoNotOptimize(data.length());
+  }
+}
+
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void compressSmallJsonWithZstdUncached(benchmark::State& state) {
+  compressSmallJsonWithZstd(state, false);
+}
+BENCHMARK(compressSmallJsonWithZstdUncached);
+
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void compressSmallJsonWithZstdCached(benchmark::State& state) {
+  compressSmallJsonWithZstd(state, true);
+}
+BENCHMARK(compressSmallJsonWithZstdCached);
+
 } // namespace Compressor
 } // namespace HttpFilters
 } // namespace Extensions
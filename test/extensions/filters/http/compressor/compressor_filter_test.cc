@@ -802,6 +802,167 @@ TEST_P(CompressWithEtagTest, CompressionIsDisabledOnEtag) {
   }
 }
 
+TEST(CompressedResponseCacheTest, EvictsLeastRecentlyUsedBody) {
+  envoy::extensions::filters::http::compressor::v3::Compressor::CompressedResponseCache
+      proto_config;
+  proto_config.mutable_max_entries()->set_value(2);
+  CompressedResponseCache cache(proto_config);
+  EXPECT_EQ(65536, cache.maxBodyBytes());
+
+  cache.insert("a", std::make_shared<const std::string>("body a"));
+  cache.insert("b", std::make_shared<const std::string>("body b"));
+  EXPECT_EQ("body a", *cache.lookup("a"));
+  cache.insert("c", std::make_shared<const std::string>("body c"));
+  EXPECT_EQ(nullptr, cache.lookup("b"));
+  EXPECT_EQ("body a", *cache.lookup("a"));
+  EXPECT_EQ("body c", *cache.lookup("c"));
+
+  cache.insert("a", std::make_shared<const std::string>("new body a"));
+  EXPECT_EQ("new body a", *cache.lookup("a"));
+  EXPECT_EQ("body c", *cache.lookup("c"));
+}
+
+class CompressedResponseCacheFilterTest : public CompressorFilterTest {
+public:
+  void SetUp() override {
+    setUpFilter(R"EOF(
+{
+  "response_direction_config": {
+    "compressed_response_cache": {
+      "max_body_bytes": 512
+    }
+  },
+  "compressor_library": {
+     "name": "test",
+     "typed_config": {
+       "@type": "type.googleapis.com/envoy.extensions.compression.gzip.compressor.v3.Gzip"
+     }
+  }
+}
+)EOF");
+  }
+
+  // Sends a response through a new stream of the filter, and returns the response body it sends
+  // downstream. The test compressor leaves the body as is.
+  std::string doResponse(const std::string& path, const std::string& etag,
+                         const std::string& body, bool with_trailers = false,
+                         const std::string& status = "200",
+                         const Http::TestRequestHeaderMapImpl& extra_request_headers = {},
+                         const Http::TestResponseHeaderMapImpl& extra_response_headers = {}) {
+    NiceMock<Http::MockStreamDecoderFilterCallbacks> decoder_callbacks;
+    NiceMock<Http::MockStreamEncoderFilterCallbacks> encoder_callbacks;
+    CompressorFilter filter(config_);
+    filter.setDecoderFilterCallbacks(decoder_callbacks);
+    filter.setEncoderFilterCallbacks(encoder_callbacks);
+
+    Http::TestRequestHeaderMapImpl request_headers{{":method", "GET"},
+                                                   {":authority", "example.com"},
+                                                   {":path", path},
+                                                   {"accept-encoding", "test"}};
+    Http::HeaderMapImpl::copyFrom(request_headers, extra_request_headers);
+    EXPECT_EQ(Http::FilterHeadersStatus::Continue, filter.decodeHeaders(request_headers, true));
+    Http::TestResponseHeaderMapImpl response_headers{{":status", status}, {"etag", etag}};
+    Http::HeaderMapImpl::copyFrom(response_headers, extra_response_headers);
+    EXPECT_EQ(Http::FilterHeadersStatus::Continue, filter.encodeHeaders(response_headers, false));
+    EXPECT_EQ("test", response_headers.get_("content-encoding"));
+
+    Buffer::OwnedImpl data(body);
+    EXPECT_EQ(Http::FilterDataStatus::Continue, filter.encodeData(data, !with_trailers));
+    if (with_trailers) {
+      EXPECT_CALL(encoder_callbacks, addEncodedData(_, true))
+          .WillOnce(Invoke([&](Buffer::Instance& added, bool) { data.move(added); }));
+      Http::TestResponseTrailerMapImpl trailers;
+      EXPECT_EQ(Http::FilterTrailersStatus::Continue, filter.encodeTrailers(trailers));
+    }
+    return data.toString();
+  }
+
+  uint64_t counter(const std::string& name) {
+    return stats_.counter("test.compressor.test.test.response." + name).value();
+  }
+};
+
+TEST_F(CompressedResponseCacheFilterTest, ServesCachedResponse) {
+  EXPECT_EQ("first body", doResponse("/app.js", "\"v1\"", "first body"));
+  EXPECT_EQ(1, counter("cache_miss"));
+
+  // The same resource and ETag is served from the cache.
+  compressor_factory_->setExpectedCompressCalls(0);
+  EXPECT_EQ("first body", doResponse("/app.js", "\"v1\"", "second body"));
+  EXPECT_EQ(1, counter("cache_hit"));
+  EXPECT_EQ(strlen("first body") + strlen("second body"), counter("total_uncompressed_bytes"));
+  EXPECT_EQ(2 * strlen("first body"), counter("total_compressed_bytes"));
+
+  // Another ETag or resource is not.
+  compressor_factory_->setExpectedCompressCalls(1);
+  EXPECT_EQ("third body", doResponse("/app.js", "\"v2\"", "third body"));
+  EXPECT_EQ("fourth body", doResponse("/other.js", "\"v1\"", "fourth body"));
+  EXPECT_EQ(3, counter("cache_miss"));
+  EXPECT_EQ(1, counter("cache_hit"));
+}
+
+TEST_F(CompressedResponseCacheFilterTest, ServesCachedResponseWithTrailers) {
+  compressor_factory_->setExpectedCompressCalls(2);
+  EXPECT_EQ("first body", doResponse("/app.js", "\"v1\"", "first body", true));
+  EXPECT_EQ("first body", doResponse("/app.js", "\"v1\"", "second body", true));
+  EXPECT_EQ(1, counter("cache_hit"));
+}
+
+TEST_F(CompressedResponseCacheFilterTest, WeakEtagIsNotCached) {
+  EXPECT_EQ("first body", doResponse("/app.js", "W/\"v1\"", "first body"));
+  EXPECT_EQ("second body", doResponse("/app.js", "W/\"v1\"", "second body"));
+  EXPECT_EQ(0, counter("cache_miss"));
+  EXPECT_EQ(0, counter("cache_hit"));
+}
+
+TEST_F(CompressedResponseCacheFilterTest, LargeResponseIsNotCached) {
+  const std::string large_body(513, 'a');
+  EXPECT_EQ(large_body, doResponse("/app.js", "\"v1\"", large_body));
+  EXPECT_EQ("second body", doResponse("/app.js", "\"v1\"", "second body"));
+  EXPECT_EQ(2, counter("cache_miss"));
+  EXPECT_EQ(0, counter("cache_hit"));
+}
+
+TEST_F(CompressedResponseCacheFilterTest, PartialResponseIsNotCached) {
+  // A 206 carries the same ETag as the full response, so it must neither be stored nor be served
+  // in place of the full response.
+  EXPECT_EQ("partial", doResponse("/app.js", "\"v1\"", "partial", false, "206",
+                                  {{"range", "bytes=0-6"}}, {{"content-range", "bytes 0-6/9"}}));
+  EXPECT_EQ("full body", doResponse("/app.js", "\"v1\"", "full body"));
+  EXPECT_EQ(1, counter("cache_miss"));
+  EXPECT_EQ(0, counter("cache_hit"));
+
+  // Nor is the cached full response served for a range request.
+  EXPECT_EQ("partial", doResponse("/app.js", "\"v1\"", "partial", false, "206",
+                                  {{"range", "bytes=0-6"}}, {{"content-range", "bytes 0-6/9"}}));
+  EXPECT_EQ(0, counter("cache_hit"));
+}
+
+TEST_F(CompressedResponseCacheFilterTest, NonGetRequestIsNotCached) {
+  EXPECT_EQ("first body",
+            doResponse("/app.js", "\"v1\"", "first body", false, "200", {{":method", "POST"}}));
+  EXPECT_EQ("second body", doResponse("/app.js", "\"v1\"", "second body"));
+  EXPECT_EQ(1, counter("cache_miss"));
+  EXPECT_EQ(0, counter("cache_hit"));
+}
+
+TEST_F(CompressedResponseCacheFilterTest, VaryOnOtherHeaderIsNotCached) {
+  EXPECT_EQ("first body", doResponse("/app.js", "\"v1\"", "first body", false, "200", {},
+                                     {{"vary", "Accept-Encoding, Cookie"}}));
+  EXPECT_EQ("second body", doResponse("/app.js", "\"v1\"", "second body", false, "200", {},
+                                      {{"vary", "Accept-Encoding, Cookie"}}));
+  EXPECT_EQ(0, counter("cache_miss"));
+  EXPECT_EQ(0, counter("cache_hit"));
+}
+
+TEST_F(CompressedResponseCacheFilterTest, VaryOnAcceptEncodingIsCached) {
+  EXPECT_EQ("first body", doResponse("/app.js", "\"v1\"", "first body", false, "200", {},
+                                     {{"vary", "accept-encoding"}}));
+  EXPECT_EQ("first body", doResponse("/app.js", "\"v1\"", "second body", false, "200", {},
+                                     {{"vary", "accept-encoding"}}));
+  EXPECT_EQ(1, counter("cache_hit"));
+}
+
 class HasCacheControlNoTransformTest
     : public CompressorFilterTest,
       public testing::WithParamInterface<std::tuple<std::string, bool>> {};
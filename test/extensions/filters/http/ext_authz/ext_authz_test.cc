@@ -1,4 +1,5 @@
 #include <chrono>
+#include <limits>
 #include <memory>
 #include <string>
 #include <vector>
@@ -24,10 +25,12 @@
 #include "test/mocks/network/mocks.h"
 #include "test/mocks/router/mocks.h"
 #include "test/mocks/runtime/mocks.h"
+#include "test/mocks/thread_local/mocks.h"
 #include "test/mocks/tracing/mocks.h"
 #include "test/mocks/upstream/cluster_manager.h"
 #include "test/proto/helloworld.pb.h"
 #include "test/test_common/printers.h"
+#include "test/test_common/simulated_time_system.h"
 #include "test/test_common/test_runtime.h"
 #include "test/test_common/utility.h"
 
@@ -62,7 +65,7 @@ public:
       TestUtility::loadFromYaml(yaml, proto_config);
     }
     config_ = std::make_shared<FilterConfig>(proto_config, *stats_store_.rootScope(), runtime_,
-                                             http_context_, "ext_authz_prefix", bootstrap_);
+                                             http_context_, "ext_authz_prefix", bootstrap_, tls_);
     client_ = new Filters::Common::ExtAuthz::MockClient();
     filter_ = std::make_unique<Filter>(config_, Filters::Common::ExtAuthz::ClientPtr{client_});
     filter_->setDecoderFilterCallbacks(decoder_filter_callbacks_);
@@ -133,6 +136,7 @@ public:
   Http::TestRequestTrailerMapImpl request_trailers_;
   Buffer::OwnedImpl data_;
   NiceMock<Runtime::MockLoader> runtime_;
+  NiceMock<ThreadLocal::MockInstance> tls_;
   NiceMock<Upstream::MockClusterManager> cm_;
   Network::Address::InstanceConstSharedPtr addr_;
   NiceMock<Envoy::Network::MockConnection> connection_;
@@ -3156,6 +3160,191 @@ TEST_P(HttpFilterTestParam, DisableRequestBodyBufferingOnRoute) {
   EXPECT_EQ(Http::FilterDataStatus::Continue, filter_->decodeData(data_, false));
 }
 
+class DecisionCacheTest : public Event::TestUsingSimulatedTime,
+                          public HttpFilterTestBase<testing::Test> {
+public:
+  void initializeCache(bool shared) {
+    initialize(absl::StrCat(R"EOF(
+  grpc_service:
+    envoy_grpc:
+      cluster_name: "ext_authz_server"
+  failure_mode_allow: true
+  decision_cache:
+    key_headers: [":path", "x-user"]
+    denied_ttl: 5s
+    ttl_metadata_field: ttl
+    shared: )EOF",
+                            shared ? "true" : "false"));
+    prepareCheck();
+  }
+
+  // Sends a request of the user through a new filter, whose authorization server answers with the
+  // response, or must not be called if there is no response.
+  Http::FilterHeadersStatus
+  decide(const std::string& user,
+         absl::optional<Filters::Common::ExtAuthz::Response> response = absl::nullopt) {
+    client_ = new Filters::Common::ExtAuthz::MockClient();
+    filter_ = std::make_unique<Filter>(config_, Filters::Common::ExtAuthz::ClientPtr{client_});
+    filter_->setDecoderFilterCallbacks(decoder_filter_callbacks_);
+    filter_->setEncoderFilterCallbacks(encoder_filter_callbacks_);
+    if (response.has_value()) {
+      EXPECT_CALL(*client_, check(_, _, _, _))
+          .WillOnce(Invoke([response](Filters::Common::ExtAuthz::RequestCallbacks& callbacks,
+                                      const envoy::service::auth::v3::CheckRequest&,
+                                      Tracing::Span&, const StreamInfo::StreamInfo&) -> void {
+            callbacks.onComplete(std::make_unique<Filters::Common::ExtAuthz::Response>(*response));
+          }));
+    } else {
+      EXPECT_CALL(*client_, check(_, _, _, _)).Times(0);
+    }
+    Http::TestRequestHeaderMapImpl headers{
+        {":method", "GET"}, {":path", "/"}, {":authority", "host"}, {"x-user", user}};
+    return filter_->decodeHeaders(headers, true);
+  }
+
+  static Filters::Common::ExtAuthz::Response
+  response(Filters::Common::ExtAuthz::CheckStatus status) {
+    Filters::Common::ExtAuthz::Response response{};
+    response.status = status;
+    if (status == Filters::Common::ExtAuthz::CheckStatus::Denied) {
+      response.status_code = Http::Code::Forbidden;
+    }
+    return response;
+  }
+
+  static Filters::Common::ExtAuthz::Response okWithTtl(const ProtobufWkt::Value& ttl) {
+    Filters::Common::ExtAuthz::Response response =
+        DecisionCacheTest::response(Filters::Common::ExtAuthz::CheckStatus::OK);
+    (*response.dynamic_metadata.mutable_fields())["ttl"] = ttl;
+    return response;
+  }
+};
+
+TEST_F(DecisionCacheTest, CachesAllowedRequests) {
+  initializeCache(false);
+  const auto ok = response(Filters::Common::ExtAuthz::CheckStatus::OK);
+  EXPECT_EQ(Http::FilterHeadersStatus::Continue, decide("alice", ok));
+  EXPECT_EQ(Http::FilterHeadersStatus::Continue, decide("alice"));
+  EXPECT_EQ(Http::FilterHeadersStatus::Continue, decide("bob", ok));
+  EXPECT_EQ(1U, config_->stats().decision_cache_hit_.value());
+  EXPECT_EQ(2U, config_->stats().decision_cache_miss_.value());
+  EXPECT_EQ(3U, config_->stats().ok_.value());
+
+  // The decisions expire after the default TTL.
+  simTime().advanceTimeWait(std::chrono::seconds(9));
+  EXPECT_EQ(Http::FilterHeadersStatus::Continue, decide("alice"));
+  simTime().advanceTimeWait(std::chrono::seconds(1));
+  EXPECT_EQ(Http::FilterHeadersStatus::Continue, decide("alice", ok));
+}
+
+TEST_F(DecisionCacheTest, CachesDeniedRequestsForDeniedTtl) {
+  initializeCache(false);
+  EXPECT_EQ(Http::FilterHeadersStatus::StopAllIterationAndWatermark,
+            decide("alice", response(Filters::Common::ExtAuthz::CheckStatus::Denied)));
+  EXPECT_EQ(Http::FilterHeadersStatus::StopAllIterationAndWatermark, decide("alice"));
+  EXPECT_EQ(2U, config_->stats().denied_.value());
+  EXPECT_EQ("ext_authz_denied", decoder_filter_callbacks_.details());
+
+  simTime().advanceTimeWait(std::chrono::seconds(5));
+  EXPECT_EQ(Http::FilterHeadersStatus::Continue,
+            decide("alice", response(Filters::Common::ExtAuthz::CheckStatus::OK)));
+}
+
+TEST_F(DecisionCacheTest, ErrorsAreNotCached) {
+  initializeCache(false);
+  const auto error = response(Filters::Common::ExtAuthz::CheckStatus::Error);
+  EXPECT_EQ(Http::FilterHeadersStatus::Continue, decide("alice", error));
+  EXPECT_EQ(Http::FilterHeadersStatus::Continue, decide("alice", error));
+  EXPECT_EQ(0U, config_->stats().decision_cache_hit_.value());
+  EXPECT_EQ(2U, config_->stats().failure_mode_allowed_.value());
+}
+
+TEST_F(DecisionCacheTest, HonorsTtlOfAuthorizationServer) {
+  initializeCache(false);
+  EXPECT_EQ(Http::FilterHeadersStatus::Continue,
+            decide("alice", okWithTtl(ValueUtil::numberValue(0))));
+  EXPECT_EQ(Http::FilterHeadersStatus::Continue,
+            decide("alice", okWithTtl(ValueUtil::stringValue("30"))));
+  simTime().advanceTimeWait(std::chrono::seconds(20));
+  EXPECT_EQ(Http::FilterHeadersStatus::Continue, decide("alice"));
+  simTime().advanceTimeWait(std::chrono::seconds(10));
+  EXPECT_EQ(Http::FilterHeadersStatus::Continue,
+            decide("alice", okWithTtl(ValueUtil::stringValue("not a number"))));
+  // The default TTL applies to an invalid TTL.
+  EXPECT_EQ(Http::FilterHeadersStatus::Continue, decide("alice"));
+}
+
+TEST_F(DecisionCacheTest, IgnoresInvalidTtlsAndCapsLongOnes) {
+  initializeCache(false);
+  const std::vector<ProtobufWkt::Value> invalid_ttls = {
+      ValueUtil::numberValue(-1), ValueUtil::numberValue(std::numeric_limits<double>::infinity()),
+      ValueUtil::numberValue(std::numeric_limits<double>::quiet_NaN()),
+      ValueUtil::stringValue("nan"), ValueUtil::stringValue("-inf")};
+  for (const ProtobufWkt::Value& ttl : invalid_ttls) {
+    EXPECT_EQ(Http::FilterHeadersStatus::Continue, decide("alice", okWithTtl(ttl)));
+    // The default TTL applies.
+    simTime().advanceTimeWait(std::chrono::seconds(9));
+    EXPECT_EQ(Http::FilterHeadersStatus::Continue, decide("alice"));
+    simTime().advanceTimeWait(std::chrono::seconds(1));
+  }
+
+  EXPECT_EQ(Http::FilterHeadersStatus::Continue,
+            decide("alice", okWithTtl(ValueUtil::numberValue(1e300))));
+  simTime().advanceTimeWait(std::chrono::hours(24) - std::chrono::seconds(1));
+  EXPECT_EQ(Http::FilterHeadersStatus::Continue, decide("alice"));
+  simTime().advanceTimeWait(std::chrono::seconds(1));
+  EXPECT_EQ(Http::FilterHeadersStatus::Continue,
+            decide("alice", response(Filters::Common::ExtAuthz::CheckStatus::OK)));
+}
+
+TEST_F(DecisionCacheTest, SharedCache) {
+  initializeCache(true);
+  EXPECT_EQ(Http::FilterHeadersStatus::Continue,
+            decide("alice", response(Filters::Common::ExtAuthz::CheckStatus::OK)));
+  EXPECT_EQ(Http::FilterHeadersStatus::Continue, decide("alice"));
+  EXPECT_EQ(1U, config_->stats().decision_cache_hit_.value());
+}
+
+TEST_F(DecisionCacheTest, RequiresKey) {
+  EXPECT_THROW_WITH_MESSAGE(initialize(R"EOF(
+  grpc_service:
+    envoy_grpc:
+      cluster_name: "ext_authz_server"
+  decision_cache: {}
+  )EOF"),
+                            EnvoyException,
+                            "ext_authz decision cache requires key_headers or key_metadata.");
+}
+
+TEST(DecisionCacheKeyTest, KeyIsMadeOfHeadersAndMetadata) {
+  NiceMock<ThreadLocal::MockInstance> tls;
+  envoy::extensions::filters::http::ext_authz::v3::DecisionCache config;
+  TestUtility::loadFromYaml(R"EOF(
+  key_headers: ["x-user"]
+  key_metadata:
+  - key: envoy.filters.http.jwt_authn
+    path:
+    - key: sub
+  )EOF",
+                            config);
+  DecisionCache cache(config, tls);
+
+  envoy::config::core::v3::Metadata metadata;
+  const std::string missing_header = cache.key(Http::TestRequestHeaderMapImpl{}, metadata);
+  const std::string empty_header =
+      cache.key(Http::TestRequestHeaderMapImpl{{"x-user", ""}}, metadata);
+  const std::string header = cache.key(Http::TestRequestHeaderMapImpl{{"x-user", "a"}}, metadata);
+  EXPECT_NE(missing_header, empty_header);
+  EXPECT_NE(empty_header, header);
+
+  (*metadata.mutable_filter_metadata())["envoy.filters.http.jwt_authn"] =
+      MessageUtil::keyValueStruct("sub", "alice");
+  const std::string with_metadata =
+      cache.key(Http::TestRequestHeaderMapImpl{{"x-user", "a"}}, metadata);
+  EXPECT_NE(header, with_metadata);
+  EXPECT_EQ(with_metadata, cache.key(Http::TestRequestHeaderMapImpl{{"x-user", "a"}}, metadata));
+}
+
 } // namespace
 } // namespace ExtAuthz
 } // namespace HttpFilters
@@ -3,12 +3,15 @@
 #include "envoy/extensions/filters/http/jwt_authn/v3/config.pb.h"
 
 #include "source/common/protobuf/utility.h"
+#include "source/common/stats/isolated_store_impl.h"
 #include "source/extensions/filters/http/jwt_authn/jwt_cache.h"
 
 #include "test/extensions/filters/http/jwt_authn/test_common.h"
 #include "test/test_common/simulated_time_system.h"
 #include "test/test_common/utility.h"
 
+#include "absl/strings/str_cat.h"
+
 using ::google::jwt_verify::Status;
 
 namespace Envoy {
@@ -80,6 +83,81 @@ TEST_F(JwtCacheTest, TestExpiredToken) {
   EXPECT_TRUE(jwt == nullptr);
 }
 
+class SharedJwtCacheTest : public testing::Test {
+public:
+  SharedJwtCacheTest()
+      : stats_{ALL_JWT_AUTHN_FILTER_STATS(POOL_COUNTER_PREFIX(*store_.rootScope(), ""))} {}
+
+  // Creates the caches of two workers which share a cache of the given size.
+  void setupCaches(uint32_t size) {
+    envoy::extensions::filters::http::jwt_authn::v3::JwtCacheConfig config;
+    config.set_jwt_cache_size(size);
+    config.set_shared(true);
+    auto shared_cache = std::make_shared<SharedJwtCache>(config, time_system_, stats_);
+    cache1_ = JwtCache::create(true, config, time_system_, shared_cache);
+    cache2_ = JwtCache::create(true, config, time_system_, shared_cache);
+  }
+
+  static std::unique_ptr<::google::jwt_verify::Jwt> makeJwt(const char* jwt_str) {
+    auto jwt = std::make_unique<::google::jwt_verify::Jwt>();
+    EXPECT_EQ(jwt->parseFromString(jwt_str), Status::Ok);
+    return jwt;
+  }
+
+  Event::SimulatedTimeSystem time_system_;
+  Stats::IsolatedStoreImpl store_;
+  JwtAuthnFilterStats stats_;
+  JwtCachePtr cache1_;
+  JwtCachePtr cache2_;
+};
+
+TEST_F(SharedJwtCacheTest, JwtVerifiedByAnotherWorker) {
+  setupCaches(0);
+  auto* origin_jwt = makeJwt(GoodToken).release();
+  cache1_->insert(GoodToken, std::unique_ptr<::google::jwt_verify::Jwt>(origin_jwt));
+  EXPECT_EQ(origin_jwt, cache1_->lookup(GoodToken));
+  EXPECT_EQ(0U, stats_.jwt_cache_shared_hit_.value());
+
+  // The other worker gets a copy of the JWT from the shared cache, and caches it.
+  auto* jwt = cache2_->lookup(GoodToken);
+  ASSERT_NE(nullptr, jwt);
+  EXPECT_NE(origin_jwt, jwt);
+  EXPECT_EQ(origin_jwt->payload_str_base64url_, jwt->payload_str_base64url_);
+  EXPECT_EQ(1U, stats_.jwt_cache_shared_hit_.value());
+  EXPECT_EQ(jwt, cache2_->lookup(GoodToken));
+  EXPECT_EQ(1U, stats_.jwt_cache_shared_hit_.value());
+
+  EXPECT_EQ(nullptr, cache2_->lookup(OtherGoodToken));
+}
+
+TEST_F(SharedJwtCacheTest, ExpiredJwt) {
+  setupCaches(0);
+  cache1_->insert(ExpiredToken, makeJwt(ExpiredToken));
+  EXPECT_EQ(nullptr, cache2_->lookup(ExpiredToken));
+  EXPECT_EQ(0U, stats_.jwt_cache_shared_hit_.value());
+}
+
+TEST_F(SharedJwtCacheTest, EvictsLeastRecentlyUsedJwt) {
+  // Each of the shards holds a single JWT.
+  envoy::extensions::filters::http::jwt_authn::v3::JwtCacheConfig config;
+  config.set_jwt_cache_size(16);
+  SharedJwtCache shared_cache(config, time_system_, stats_);
+
+  std::shared_ptr<::google::jwt_verify::Jwt> jwt = makeJwt(GoodToken);
+  for (int i = 0; i < 100; ++i) {
+    shared_cache.insert(absl::StrCat("token-", i), jwt);
+    // The most recently inserted JWT is never evicted.
+    EXPECT_EQ(jwt, shared_cache.lookup(absl::StrCat("token-", i)));
+  }
+  int cached = 0;
+  for (int i = 0; i < 100; ++i) {
+    if (shared_cache.lookup(absl::StrCat("token-", i)) != nullptr) {
+      ++cached;
+    }
+  }
+  EXPECT_GE(16, cached);
+}
+
 } // namespace
 } // namespace JwtAuthn
 } // namespace HttpFilters
@@ -5,9 +5,11 @@
 #include <string>
 #include <vector>
 
+#include "source/common/buffer/buffer_impl.h"
 #include "source/common/common/fmt.h"
 #include "source/common/stats/isolated_store_impl.h"
 #include "source/extensions/filters/network/common/redis/client_impl.h"
+#include "source/extensions/filters/network/common/redis/codec_impl.h"
 #include "source/extensions/filters/network/common/redis/supported_commands.h"
 #include "source/extensions/filters/network/redis_proxy/command_splitter_impl.h"
 #include "source/extensions/filters/network/redis_proxy/router_impl.h"
@@ -82,6 +84,47 @@ public:
       single_mset.asArray()[2].asString() = request->asArray()[i + 1].asString();
     }
   }
+
+  Common::Redis::RespValueSharedPtr makeSharedMget(uint64_t batch_size, uint64_t key_size) {
+    Common::Redis::RespValueSharedPtr request{new Common::Redis::RespValue()};
+    std::vector<Common::Redis::RespValue> values(batch_size + 1);
+    values[0].type(Common::Redis::RespType::BulkString);
+    values[0].asString() = "mget";
+    for (uint64_t i = 1; i < batch_size + 1; i++) {
+      values[i].type(Common::Redis::RespType::BulkString);
+      values[i].asString() = std::string(key_size, 'k');
+    }
+
+    request->type(Common::Redis::RespType::Array);
+    request->asArray().swap(values);
+
+    return request;
+  }
+
+  // Splits and encodes an MGET as one GET per key.
+  void encodeGetFragments(Common::Redis::RespValueSharedPtr& request, Buffer::Instance& out) {
+    for (uint64_t i = 1; i < request->asArray().size(); i++) {
+      Common::Redis::RespValue single_get(request, Common::Redis::Utility::GetRequest::instance(),
+                                          i, i);
+      encoder_.encode(single_get, out);
+    }
+  }
+
+  // Encodes an MGET whose keys all have the same hash tag as a single merged fragment.
+  void encodeMergedMget(Common::Redis::RespValueSharedPtr& request, Buffer::Instance& out) {
+    std::vector<Common::Redis::RespValue> values(request->asArray().size());
+    values[0].type(Common::Redis::RespType::BulkString);
+    values[0].asString() = "mget";
+    for (uint64_t i = 1; i < request->asArray().size(); i++) {
+      values[i] = request->asArray()[i];
+    }
+    Common::Redis::RespValue merged_mget;
+    merged_mget.type(Common::Redis::RespType::Array);
+    merged_mget.asArray().swap(values);
+    encoder_.encode(merged_mget, out);
+  }
+
+  Common::Redis::EncoderImpl encoder_;
 };
 } // namespace RedisProxy
 } // namespace NetworkFilters
@@ -133,3 +176,29 @@ static void bmSplitCreateVariant(benchmark::State& state) {
   state.counters["use_count"] = request.use_count();
 }
 BENCHMARK(bmSplitCreateVariant)->Ranges({{1, 100}, {64, 8 << 14}});
+
+static void bmMgetEncodeGetFragments(benchmark::State& state) {
+  Envoy::Extensions::NetworkFilters::RedisProxy::CommandSplitSpeedTest context;
+  Envoy::Extensions::NetworkFilters::Common::Redis::RespValueSharedPtr request =
+      context.makeSharedMget(state.range(0), 36);
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    Envoy::Buffer::OwnedImpl out;
+    context.encodeGetFragments(request, out);
+    state.counters["bytes"] = out.length();
+  }
+}
+BENCHMARK(bmMgetEncodeGetFragments)->Range(1, 100);
+
+static void bmMgetEncodeMerged(benchmark::State& state) {
+  Envoy::Extensions::NetworkFilters::RedisProxy::CommandSplitSpeedTest context;
+  Envoy::Extensions::NetworkFilters::Common::Redis::RespValueSharedPtr request =
+      context.makeSharedMget(state.range(0), 36);
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    Envoy::Buffer::OwnedImpl out;
+    context.encodeMergedMget(request, out);
+    state.counters["bytes"] = out.length();
+  }
+}
+BENCHMARK(bmMgetEncodeMerged)->Range(1, 100);
@@ -16,10 +16,14 @@
 #include "test/mocks/stats/mocks.h"
 #include "test/mocks/stream_info/mocks.h"
 #include "test/test_common/simulated_time_system.h"
+#include "test/test_common/test_runtime.h"
+
+#include "absl/strings/match.h"
 
 using testing::_;
 using testing::DoAll;
 using testing::InSequence;
+using testing::Invoke;
 using testing::NiceMock;
 using testing::Property;
 using testing::Return;
@@ -62,6 +66,8 @@ public:
     return static_cast<MockFaultManager*>(fault_manager_ptr);
   }
 
+  MockRouter* getRouter() { return static_cast<MockRouter*>(splitter_.router_.get()); }
+
   const bool latency_in_micros_;
   ConnPool::MockInstance* conn_pool_{new ConnPool::MockInstance()};
   ConnPool::MockInstance* mirror_conn_pool_{new ConnPool::MockInstance()};
@@ -786,6 +792,168 @@ TEST_F(RedisMGETCommandHandlerTest, Cancel) {
   handle_->cancel();
 };
 
+MATCHER_P(ArrayEq, rhs, "Array should be equal") {
+  const ConnPool::RespVariant& obj = arg;
+  const auto& lhs = absl::get<const Common::Redis::RespValue>(obj);
+  EXPECT_TRUE(lhs.type() == Common::Redis::RespType::Array);
+  std::vector<std::string> array;
+  for (auto const& entry : lhs.asArray()) {
+    array.emplace_back(entry.asString());
+  }
+  EXPECT_EQ(array, rhs);
+  return true;
+}
+
+class RedisMGETMergedCommandHandlerTest : public RedisMGETCommandHandlerTest {
+public:
+  // Sends "mget {a}x 1 {a}y" by default, where both "{a}" keys have the same hash tag.
+  void makeMergedRequest(const std::vector<std::string>& request_strings = {"mget", "{a}x", "1",
+                                                                           "{a}y"}) {
+    ON_CALL(*conn_pool_, hashedKey(absl::string_view("{a}x"))).WillByDefault(Return("a"));
+    ON_CALL(*conn_pool_, hashedKey(absl::string_view("{a}y"))).WillByDefault(Return("a"));
+
+    Common::Redis::RespValuePtr request{new Common::Redis::RespValue()};
+    makeBulkStringArray(*request, request_strings);
+
+    pool_callbacks_.resize(2);
+    std::vector<Common::Redis::Client::MockPoolRequest> tmp_pool_requests(2);
+    pool_requests_.swap(tmp_pool_requests);
+
+    EXPECT_CALL(callbacks_, connectionAllowed()).WillOnce(Return(true));
+    EXPECT_CALL(*conn_pool_,
+                makeRequest_("{a}x", ArrayEq(std::vector<std::string>{"mget", "{a}x", "{a}y"}), _))
+        .WillOnce(DoAll(WithArg<2>(SaveArgAddress(&pool_callbacks_[0])),
+                        Return(&pool_requests_[0])));
+    EXPECT_CALL(*conn_pool_,
+                makeRequest_("1", CompositeArrayEq(std::vector<std::string>{"get", "1"}), _))
+        .WillOnce(DoAll(WithArg<2>(SaveArgAddress(&pool_callbacks_[1])),
+                        Return(&pool_requests_[1])));
+    handle_ = splitter_.makeRequest(std::move(request), callbacks_, dispatcher_, stream_info_);
+  }
+};
+
+TEST_F(RedisMGETMergedCommandHandlerTest, Normal) {
+  InSequence s;
+
+  makeMergedRequest();
+  EXPECT_NE(nullptr, handle_);
+
+  Common::Redis::RespValue expected_response;
+  expected_response.type(Common::Redis::RespType::Array);
+  std::vector<Common::Redis::RespValue> elements(3);
+  elements[0].type(Common::Redis::RespType::BulkString);
+  elements[0].asString() = "x";
+  elements[1].type(Common::Redis::RespType::BulkString);
+  elements[1].asString() = "5";
+  expected_response.asArray().swap(elements);
+
+  pool_callbacks_[1]->onResponse(response("5"));
+
+  Common::Redis::RespValuePtr merged_response = std::make_unique<Common::Redis::RespValue>();
+  merged_response->type(Common::Redis::RespType::Array);
+  std::vector<Common::Redis::RespValue> merged_elements(2);
+  merged_elements[0].type(Common::Redis::RespType::BulkString);
+  merged_elements[0].asString() = "x";
+  merged_response->asArray().swap(merged_elements);
+
+  time_system_.setMonotonicTime(std::chrono::milliseconds(10));
+  EXPECT_CALL(store_, deliverHistogramToSinks(
+                          Property(&Stats::Metric::name, "redis.foo.command.mget.latency"), 10));
+  EXPECT_CALL(callbacks_, onResponse_(PointeesEq(&expected_response)));
+  pool_callbacks_[0]->onResponse(std::move(merged_response));
+
+  EXPECT_EQ(1UL, store_.counter("redis.foo.command.mget.total").value());
+  EXPECT_EQ(1UL, store_.counter("redis.foo.command.mget.success").value());
+};
+
+TEST_F(RedisMGETMergedCommandHandlerTest, Failure) {
+  InSequence s;
+
+  makeMergedRequest();
+  EXPECT_NE(nullptr, handle_);
+
+  Common::Redis::RespValue expected_response;
+  expected_response.type(Common::Redis::RespType::Array);
+  std::vector<Common::Redis::RespValue> elements(3);
+  elements[0].type(Common::Redis::RespType::Error);
+  elements[0].asString() = Response::get().UpstreamFailure;
+  elements[1].type(Common::Redis::RespType::BulkString);
+  elements[1].asString() = "5";
+  elements[2].type(Common::Redis::RespType::Error);
+  elements[2].asString() = Response::get().UpstreamFailure;
+  expected_response.asArray().swap(elements);
+
+  pool_callbacks_[0]->onFailure();
+
+  time_system_.setMonotonicTime(std::chrono::milliseconds(5));
+  EXPECT_CALL(store_, deliverHistogramToSinks(
+                          Property(&Stats::Metric::name, "redis.foo.command.mget.latency"), 5));
+  EXPECT_CALL(callbacks_, onResponse_(PointeesEq(&expected_response)));
+  pool_callbacks_[1]->onResponse(response("5"));
+  EXPECT_EQ(1UL, store_.counter("redis.foo.command.mget.total").value());
+  EXPECT_EQ(1UL, store_.counter("redis.foo.command.mget.error").value());
+};
+
+TEST_F(RedisMGETMergedCommandHandlerTest, PrefixRoute) {
+  // The route removes the "p:" prefix of the keys, which are then grouped by their hash tag.
+  ON_CALL(*getRouter(), upstreamPool(_, _))
+      .WillByDefault(
+          Invoke([this](std::string& key, const StreamInfo::StreamInfo&) -> RouteSharedPtr {
+            if (absl::StartsWith(key, "p:")) {
+              key.erase(0, 2);
+            }
+            return route_;
+          }));
+  InSequence s;
+
+  makeMergedRequest({"mget", "p:{a}x", "p:1", "p:{a}y"});
+  EXPECT_NE(nullptr, handle_);
+
+  Common::Redis::RespValue expected_response;
+  expected_response.type(Common::Redis::RespType::Array);
+  std::vector<Common::Redis::RespValue> elements(3);
+  elements[0].type(Common::Redis::RespType::BulkString);
+  elements[0].asString() = "x";
+  elements[1].type(Common::Redis::RespType::BulkString);
+  elements[1].asString() = "5";
+  elements[2].type(Common::Redis::RespType::BulkString);
+  elements[2].asString() = "y";
+  expected_response.asArray().swap(elements);
+
+  pool_callbacks_[1]->onResponse(response("5"));
+
+  Common::Redis::RespValuePtr merged_response = std::make_unique<Common::Redis::RespValue>();
+  merged_response->type(Common::Redis::RespType::Array);
+  std::vector<Common::Redis::RespValue> merged_elements(2);
+  merged_elements[0].type(Common::Redis::RespType::BulkString);
+  merged_elements[0].asString() = "x";
+  merged_elements[1].type(Common::Redis::RespType::BulkString);
+  merged_elements[1].asString() = "y";
+  merged_response->asArray().swap(merged_elements);
+
+  time_system_.setMonotonicTime(std::chrono::milliseconds(10));
+  EXPECT_CALL(store_, deliverHistogramToSinks(
+                          Property(&Stats::Metric::name, "redis.foo.command.mget.latency"), 10));
+  EXPECT_CALL(callbacks_, onResponse_(PointeesEq(&expected_response)));
+  pool_callbacks_[0]->onResponse(std::move(merged_response));
+
+  EXPECT_EQ(1UL, store_.counter("redis.foo.command.mget.success").value());
+};
+
+TEST_F(RedisMGETCommandHandlerTest, SameHashTagNotMergedWhenDisabled) {
+  TestScopedRuntime scoped_runtime;
+  scoped_runtime.mergeValues({{"envoy.reloadable_features.redis_merge_mget_fragments", "false"}});
+  ON_CALL(*conn_pool_, hashedKey(_)).WillByDefault(Return("a"));
+  InSequence s;
+
+  setup(2, {});
+  EXPECT_NE(nullptr, handle_);
+
+  EXPECT_CALL(pool_requests_[0], cancel());
+  EXPECT_CALL(pool_requests_[1], cancel());
+  handle_->cancel();
+};
+
 class RedisMSETCommandHandlerTest : public FragmentedRequestCommandHandlerTest {
 public:
   void setup(uint32_t num_sets, const std::list<uint64_t>& null_handle_indexes,
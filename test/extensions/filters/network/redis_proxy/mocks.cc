@@ -2,6 +2,7 @@
 
 using testing::_;
 using testing::Return;
+using testing::ReturnArg;
 using testing::ReturnRef;
 
 namespace Envoy {
@@ -35,7 +36,9 @@ namespace ConnPool {
 MockPoolCallbacks::MockPoolCallbacks() = default;
 MockPoolCallbacks::~MockPoolCallbacks() = default;
 
-MockInstance::MockInstance() = default;
+MockInstance::MockInstance() {
+  ON_CALL(*this, hashedKey(_)).WillByDefault(ReturnArg<0>());
+}
 MockInstance::~MockInstance() = default;
 
 } // namespace ConnPool
@@ -970,6 +970,262 @@ TEST_F(UdpProxyFilterTest, SocketOptionForUseOriginalSrcIp) {
   ensureIpTransparentSocketOptions(upstream_address_, "10.0.0.2:80", 1, 0);
 }
 
+// Verify that datagrams written upstream in the same event loop iteration are sent with a single
+// GSO write, and that a shorter datagram ends the batch.
+TEST_F(UdpProxyFilterTest, BatchUpstreamWrites) {
+  if (!os_sys_calls_.supportsUdpGso()) {
+    // UDP GSO is not supported on this platform. Just skip the test.
+    GTEST_SKIP();
+  }
+
+  setup(readConfig(R"EOF(
+stat_prefix: foo
+matcher:
+  on_no_match:
+    action:
+      name: route
+      typed_config:
+        '@type': type.googleapis.com/envoy.extensions.filters.udp.udp_proxy.v3.Route
+        cluster: fake_cluster
+batch_upstream_writes: true
+  )EOF"));
+
+  expectSessionCreate(upstream_address_);
+  TestSession& session = test_sessions_[0];
+  auto* flush_cb =
+      new NiceMock<Event::MockSchedulableCallback>(&callbacks_.udp_listener_.dispatcher_);
+  EXPECT_CALL(*session.idle_timer_, enableTimer(config_->sessionTimeout(), nullptr)).Times(4);
+  EXPECT_CALL(*session.socket_->io_handle_, connect(_))
+      .WillOnce(Return(Api::SysCallIntResult{0, 0}));
+  EXPECT_CALL(*session.socket_->io_handle_, setOption(SOL_UDP, UDP_SEGMENT, _, sizeof(int)))
+      .WillOnce(Invoke([](int, int, const void* optval, socklen_t) -> Api::SysCallIntResult {
+        EXPECT_EQ(5, *static_cast<const int*>(optval));
+        return Api::SysCallIntResult{0, 0};
+      }));
+  std::vector<std::string> writes;
+  EXPECT_CALL(*session.socket_->io_handle_, sendmsg(_, _, 0, _, _))
+      .Times(2)
+      .WillRepeatedly(Invoke([&writes](const Buffer::RawSlice* slices, uint64_t num_slices, int,
+                                       const Network::Address::Ip*,
+                                       const Network::Address::Instance&)
+                                 -> Api::IoCallUint64Result {
+        std::string write;
+        for (uint64_t i = 0; i < num_slices; ++i) {
+          write.append(static_cast<const char*>(slices[i].mem_), slices[i].len_);
+        }
+        writes.push_back(write);
+        return makeNoError(write.size());
+      }));
+
+  // The first three datagrams are batched, and the third one is shorter, so it ends the batch.
+  recvDataFromDownstream("10.0.0.1:1000", "10.0.0.2:80", "hello");
+  recvDataFromDownstream("10.0.0.1:1000", "10.0.0.2:80", "world");
+  EXPECT_TRUE(writes.empty());
+  recvDataFromDownstream("10.0.0.1:1000", "10.0.0.2:80", "!");
+  ASSERT_EQ(1, writes.size());
+  EXPECT_EQ("helloworld!", writes[0]);
+
+  // The last datagram is sent once the event loop iteration is done.
+  recvDataFromDownstream("10.0.0.1:1000", "10.0.0.2:80", "again");
+  flush_cb->invokeCallback();
+  ASSERT_EQ(2, writes.size());
+  EXPECT_EQ("again", writes[1]);
+
+  Stats::Store& cluster_stats = factory_context_.server_factory_context_.cluster_manager_
+                                    .thread_local_cluster_.cluster_.info_->stats_store_;
+  EXPECT_EQ(2, TestUtility::findCounter(cluster_stats, "udp.sess_tx_batches")->value());
+  EXPECT_EQ(4, TestUtility::findCounter(cluster_stats, "udp.sess_tx_datagrams")->value());
+  EXPECT_EQ(16, factory_context_.server_factory_context_.cluster_manager_.thread_local_cluster_
+                    .cluster_.info_->traffic_stats_->upstream_cx_tx_bytes_total_.value());
+}
+
+// Verify that a datagram that would not fit the MTU as a GSO segment is written on its own,
+// without a segment size, so that the kernel can fragment it.
+TEST_F(UdpProxyFilterTest, BatchUpstreamWritesDatagramLargerThanMtu) {
+  if (!os_sys_calls_.supportsUdpGso()) {
+    // UDP GSO is not supported on this platform. Just skip the test.
+    GTEST_SKIP();
+  }
+
+  setup(readConfig(R"EOF(
+stat_prefix: foo
+matcher:
+  on_no_match:
+    action:
+      name: route
+      typed_config:
+        '@type': type.googleapis.com/envoy.extensions.filters.udp.udp_proxy.v3.Route
+        cluster: fake_cluster
+batch_upstream_writes: true
+  )EOF"));
+
+  expectSessionCreate(upstream_address_);
+  TestSession& session = test_sessions_[0];
+  auto* flush_cb =
+      new NiceMock<Event::MockSchedulableCallback>(&callbacks_.udp_listener_.dispatcher_);
+  EXPECT_CALL(*session.idle_timer_, enableTimer(config_->sessionTimeout(), nullptr)).Times(3);
+  EXPECT_CALL(*session.socket_->io_handle_, connect(_))
+      .WillOnce(Return(Api::SysCallIntResult{0, 0}));
+  std::vector<int> segment_sizes;
+  EXPECT_CALL(*session.socket_->io_handle_, setOption(SOL_UDP, UDP_SEGMENT, _, sizeof(int)))
+      .Times(2)
+      .WillRepeatedly(Invoke([&segment_sizes](int, int, const void* optval,
+                                              socklen_t) -> Api::SysCallIntResult {
+        segment_sizes.push_back(*static_cast<const int*>(optval));
+        return Api::SysCallIntResult{0, 0};
+      }));
+  std::vector<std::string> writes;
+  EXPECT_CALL(*session.socket_->io_handle_, sendmsg(_, _, 0, _, _))
+      .Times(2)
+      .WillRepeatedly(Invoke([&writes](const Buffer::RawSlice* slices, uint64_t num_slices, int,
+                                       const Network::Address::Ip*,
+                                       const Network::Address::Instance&)
+                                 -> Api::IoCallUint64Result {
+        std::string write;
+        for (uint64_t i = 0; i < num_slices; ++i) {
+          write.append(static_cast<const char*>(slices[i].mem_), slices[i].len_);
+        }
+        writes.push_back(write);
+        return makeNoError(write.size());
+      }));
+
+  recvDataFromDownstream("10.0.0.1:1000", "10.0.0.2:80", "hello");
+  recvDataFromDownstream("10.0.0.1:1000", "10.0.0.2:80", "world");
+  flush_cb->invokeCallback();
+  ASSERT_EQ(1, writes.size());
+  EXPECT_EQ("helloworld", writes[0]);
+
+  // The segment size is reset before the large datagram is written, without waiting for the end
+  // of the event loop iteration.
+  const std::string large_datagram(2000, 'a');
+  recvDataFromDownstream("10.0.0.1:1000", "10.0.0.2:80", large_datagram);
+  ASSERT_EQ(2, writes.size());
+  EXPECT_EQ(large_datagram, writes[1]);
+  EXPECT_EQ((std::vector<int>{5, 0}), segment_sizes);
+
+  Stats::Store& cluster_stats = factory_context_.server_factory_context_.cluster_manager_
+                                    .thread_local_cluster_.cluster_.info_->stats_store_;
+  EXPECT_EQ(3, TestUtility::findCounter(cluster_stats, "udp.sess_tx_datagrams")->value());
+}
+
+// Verify that when the kernel rejects a GSO write, the segment size is reset, the batch is resent
+// one datagram at a time and the session stops batching.
+TEST_F(UdpProxyFilterTest, BatchUpstreamWritesGsoRejected) {
+  if (!os_sys_calls_.supportsUdpGso()) {
+    // UDP GSO is not supported on this platform. Just skip the test.
+    GTEST_SKIP();
+  }
+
+  setup(readConfig(R"EOF(
+stat_prefix: foo
+matcher:
+  on_no_match:
+    action:
+      name: route
+      typed_config:
+        '@type': type.googleapis.com/envoy.extensions.filters.udp.udp_proxy.v3.Route
+        cluster: fake_cluster
+batch_upstream_writes: true
+  )EOF"));
+
+  expectSessionCreate(upstream_address_);
+  TestSession& session = test_sessions_[0];
+  auto* flush_cb =
+      new NiceMock<Event::MockSchedulableCallback>(&callbacks_.udp_listener_.dispatcher_);
+  EXPECT_CALL(*session.idle_timer_, enableTimer(config_->sessionTimeout(), nullptr)).Times(3);
+  EXPECT_CALL(*session.socket_->io_handle_, connect(_))
+      .WillOnce(Return(Api::SysCallIntResult{0, 0}));
+  std::vector<int> segment_sizes;
+  EXPECT_CALL(*session.socket_->io_handle_, setOption(SOL_UDP, UDP_SEGMENT, _, sizeof(int)))
+      .Times(2)
+      .WillRepeatedly(Invoke([&segment_sizes](int, int, const void* optval,
+                                              socklen_t) -> Api::SysCallIntResult {
+        segment_sizes.push_back(*static_cast<const int*>(optval));
+        return Api::SysCallIntResult{0, 0};
+      }));
+  std::vector<std::string> writes;
+  EXPECT_CALL(*session.socket_->io_handle_, sendmsg(_, _, 0, _, _))
+      .Times(4)
+      .WillRepeatedly(Invoke([&writes, &segment_sizes](const Buffer::RawSlice* slices,
+                                                       uint64_t num_slices, int,
+                                                       const Network::Address::Ip*,
+                                                       const Network::Address::Instance&)
+                                 -> Api::IoCallUint64Result {
+        if (segment_sizes.back() != 0) {
+          return makeError(EINVAL);
+        }
+        std::string write;
+        for (uint64_t i = 0; i < num_slices; ++i) {
+          write.append(static_cast<const char*>(slices[i].mem_), slices[i].len_);
+        }
+        writes.push_back(write);
+        return makeNoError(write.size());
+      }));
+
+  recvDataFromDownstream("10.0.0.1:1000", "10.0.0.2:80", "hello");
+  recvDataFromDownstream("10.0.0.1:1000", "10.0.0.2:80", "world");
+  flush_cb->invokeCallback();
+  EXPECT_EQ((std::vector<std::string>{"hello", "world"}), writes);
+  EXPECT_EQ((std::vector<int>{5, 0}), segment_sizes);
+
+  // The session no longer batches, so the datagram is written right away.
+  recvDataFromDownstream("10.0.0.1:1000", "10.0.0.2:80", "again");
+  EXPECT_EQ((std::vector<std::string>{"hello", "world", "again"}), writes);
+
+  Stats::Store& cluster_stats = factory_context_.server_factory_context_.cluster_manager_
+                                    .thread_local_cluster_.cluster_.info_->stats_store_;
+  EXPECT_EQ(3, TestUtility::findCounter(cluster_stats, "udp.sess_tx_datagrams")->value());
+  EXPECT_EQ(0, TestUtility::findCounter(cluster_stats, "udp.sess_tx_errors")->value());
+}
+
+// Verify that a session stops using GSO after it fails to set the segment size.
+TEST_F(UdpProxyFilterTest, BatchUpstreamWritesSetSegmentSizeFailure) {
+  if (!os_sys_calls_.supportsUdpGso()) {
+    // UDP GSO is not supported on this platform. Just skip the test.
+    GTEST_SKIP();
+  }
+
+  setup(readConfig(R"EOF(
+stat_prefix: foo
+matcher:
+  on_no_match:
+    action:
+      name: route
+      typed_config:
+        '@type': type.googleapis.com/envoy.extensions.filters.udp.udp_proxy.v3.Route
+        cluster: fake_cluster
+batch_upstream_writes: true
+  )EOF"));
+
+  expectSessionCreate(upstream_address_);
+  TestSession& session = test_sessions_[0];
+  auto* flush_cb =
+      new NiceMock<Event::MockSchedulableCallback>(&callbacks_.udp_listener_.dispatcher_);
+  EXPECT_CALL(*session.idle_timer_, enableTimer(config_->sessionTimeout(), nullptr)).Times(4);
+  EXPECT_CALL(*session.socket_->io_handle_, connect(_))
+      .WillOnce(Return(Api::SysCallIntResult{0, 0}));
+  // The segment size is only tried once.
+  EXPECT_CALL(*session.socket_->io_handle_, setOption(SOL_UDP, UDP_SEGMENT, _, sizeof(int)))
+      .WillOnce(Return(Api::SysCallIntResult{-1, ENOPROTOOPT}));
+  EXPECT_CALL(*session.socket_->io_handle_, sendmsg(_, _, 0, _, _))
+      .Times(4)
+      .WillRepeatedly(Invoke([](const Buffer::RawSlice* slices, uint64_t num_slices, int,
+                                const Network::Address::Ip*,
+                                const Network::Address::Instance&) -> Api::IoCallUint64Result {
+        uint64_t length = 0;
+        for (uint64_t i = 0; i < num_slices; ++i) {
+          length += slices[i].len_;
+        }
+        return makeNoError(length);
+      }));
+
+  recvDataFromDownstream("10.0.0.1:1000", "10.0.0.2:80", "hello");
+  recvDataFromDownstream("10.0.0.1:1000", "10.0.0.2:80", "world");
+  flush_cb->invokeCallback();
+  recvDataFromDownstream("10.0.0.1:1000", "10.0.0.2:80", "hello");
+  recvDataFromDownstream("10.0.0.1:1000", "10.0.0.2:80", "world");
+}
+
 TEST_F(UdpProxyFilterTest, MutualExcludePerPacketLoadBalancingAndSessionFilters) {
   auto config = R"EOF(
 stat_prefix: foo
@@ -0,0 +1,90 @@
+// Note: this should be run with --compilation_mode=opt, and would benefit from a
+// quiescent system with disabled cstate power management.
+
+#include "source/common/stats/isolated_store_impl.h"
+#include "source/extensions/http/cache/simple_http_cache/simple_http_cache.h"
+
+#include "test/test_common/simulated_time_system.h"
+#include "test/test_common/utility.h"
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/synchronization/mutex.h"
+#include "benchmark/benchmark.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace Cache {
+
+constexpr uint32_t NumKeys = 10000;
+
+// A cache pre-populated with NumKeys small responses, shared by all benchmark threads.
+class CacheSpeedTestContext {
+public:
+  explicit CacheSpeedTestContext(uint32_t num_shards) {
+    envoy::extensions::http::cache::simple_http_cache::v3::SimpleHttpCacheConfig config;
+    config.mutable_num_shards()->set_value(num_shards);
+    cache_ = std::make_unique<SimpleHttpCache>(config, *stats_store_.rootScope());
+
+    Http::TestRequestHeaderMapImpl request_headers{
+        {":method", "GET"}, {":scheme", "https"}, {":authority", "example.com"}};
+    Http::TestResponseHeaderMapImpl response_headers{{":status", "200"},
+                                                     {"cache-control", "public,max-age=3600"}};
+    for (uint32_t i = 0; i < NumKeys; i++) {
+      request_headers.setPath(absl::StrCat("/path/", i));
+      requests_.emplace_back(std::make_unique<LookupRequest>(
+          request_headers, time_system_.systemTime(), vary_allow_list_));
+      cache_->insert(requests_.back()->key(),
+                     Http::createHeaderMap<Http::ResponseHeaderMapImpl>(response_headers),
+                     ResponseMetadata{time_system_.systemTime()}, std::string(512, 'a'), nullptr);
+    }
+    response_headers_ = Http::createHeaderMap<Http::ResponseHeaderMapImpl>(response_headers);
+  }
+
+  Stats::IsolatedStoreImpl stats_store_;
+  Event::SimulatedTimeSystem time_system_;
+  VaryAllowList vary_allow_list_{
+      Protobuf::RepeatedPtrField<envoy::type::matcher::v3::StringMatcher>()};
+  std::vector<std::unique_ptr<LookupRequest>> requests_;
+  Http::ResponseHeaderMapPtr response_headers_;
+  std::unique_ptr<SimpleHttpCache> cache_;
+};
+
+CacheSpeedTestContext& context(uint32_t num_shards) {
+  // Contexts are intentionally leaked so that they outlive all benchmark threads.
+  static auto* contexts =
+      new absl::flat_hash_map<uint32_t, std::unique_ptr<CacheSpeedTestContext>>();
+  static absl::Mutex mutex;
+  absl::MutexLock lock(&mutex);
+  auto& ctx = (*contexts)[num_shards];
+  if (ctx == nullptr) {
+    ctx = std::make_unique<CacheSpeedTestContext>(num_shards);
+  }
+  return *ctx;
+}
+
+// Measures lookup throughput with a mix of 90% lookups and 10% inserts as the number of threads
+// grows, for a single-shard cache (equivalent to one global lock) and a sharded cache.
+static void bmLookupInsert(benchmark::State& state) {
+  CacheSpeedTestContext& ctx = context(state.range(0));
+  uint32_t i = state.thread_index() * 7919;
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    const LookupRequest& request = *ctx.requests_[i % NumKeys];
+    if (i % 10 == 0) {
+      ctx.cache_->insert(request.key(),
+                         Http::createHeaderMap<Http::ResponseHeaderMapImpl>(*ctx.response_headers_),
+                         ResponseMetadata{ctx.time_system_.systemTime()}, std::string(512, 'b'),
+                         nullptr);
+    } else {
+      benchmark::DoNotOptimize(ctx.cache_->lookup(request));
+    }
+    i++;
+  }
+}
+BENCHMARK(bmLookupInsert)->Arg(1)->Arg(16)->ThreadRange(1, 32)->UseRealTime();
+
+} // namespace Cache
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
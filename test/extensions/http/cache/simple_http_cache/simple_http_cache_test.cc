@@ -2,6 +2,7 @@
 #include "envoy/registry/registry.h"
 
 #include "source/common/buffer/buffer_impl.h"
+#include "source/common/stats/isolated_store_impl.h"
 #include "source/extensions/filters/http/cache/cache_entry_utils.h"
 #include "source/extensions/filters/http/cache/cache_headers_utils.h"
 #include "source/extensions/http/cache/simple_http_cache/simple_http_cache.h"
@@ -25,7 +26,10 @@ public:
   bool validationEnabled() const override { return true; }
 
 private:
-  std::shared_ptr<SimpleHttpCache> cache_ = std::make_shared<SimpleHttpCache>();
+  Stats::IsolatedStoreImpl stats_store_;
+  std::shared_ptr<SimpleHttpCache> cache_ = std::make_shared<SimpleHttpCache>(
+      envoy::extensions::http::cache::simple_http_cache::v3::SimpleHttpCacheConfig(),
+      *stats_store_.rootScope());
 };
 
 INSTANTIATE_TEST_SUITE_P(SimpleHttpCacheTest, HttpCacheImplementationTest,
@@ -45,6 +49,134 @@ TEST(Registration, GetFactory) {
             "envoy.extensions.http.cache.simple");
 }
 
+// The cache filters share one cache, so their configurations must not conflict.
+TEST(Registration, ConflictingConfig) {
+  HttpCacheFactory* factory = Registry::FactoryRegistry<HttpCacheFactory>::getFactoryByType(
+      "envoy.extensions.http.cache.simple_http_cache.v3.SimpleHttpCacheConfig");
+  ASSERT_NE(factory, nullptr);
+  testing::NiceMock<Server::Configuration::MockFactoryContext> factory_context;
+  envoy::extensions::http::cache::simple_http_cache::v3::SimpleHttpCacheConfig cache_config;
+  cache_config.set_max_bytes(1 << 20);
+  envoy::extensions::filters::http::cache::v3::CacheConfig config;
+  config.mutable_typed_config()->PackFrom(cache_config);
+  const std::shared_ptr<HttpCache> cache = factory->getCache(config, factory_context);
+
+  // The default shard count is the same configuration.
+  cache_config.mutable_num_shards()->set_value(16);
+  config.mutable_typed_config()->PackFrom(cache_config);
+  EXPECT_EQ(cache, factory->getCache(config, factory_context));
+
+  cache_config.set_max_bytes(2 << 20);
+  config.mutable_typed_config()->PackFrom(cache_config);
+  EXPECT_THROW_WITH_REGEX(factory->getCache(config, factory_context), EnvoyException,
+                          "must have the same num_shards and max_bytes");
+}
+
+class SimpleHttpCacheEvictionTest : public testing::Test {
+protected:
+  SimpleHttpCacheEvictionTest() {
+    request_headers_.setMethod("GET");
+    request_headers_.setHost("example.com");
+    request_headers_.setScheme("https");
+  }
+
+  void initialize(uint32_t num_shards, uint64_t max_bytes) {
+    envoy::extensions::http::cache::simple_http_cache::v3::SimpleHttpCacheConfig config;
+    config.mutable_num_shards()->set_value(num_shards);
+    config.set_max_bytes(max_bytes);
+    cache_ = std::make_unique<SimpleHttpCache>(config, *stats_store_.rootScope());
+  }
+
+  LookupRequest makeRequest(absl::string_view path) {
+    request_headers_.setPath(path);
+    return {request_headers_, time_system_.systemTime(), vary_allow_list_};
+  }
+
+  bool insert(absl::string_view path, std::string body) {
+    return cache_->insert(makeRequest(path).key(),
+                          Http::createHeaderMap<Http::ResponseHeaderMapImpl>(response_headers_),
+                          ResponseMetadata{time_system_.systemTime()}, std::move(body), nullptr);
+  }
+
+  bool lookup(absl::string_view path) {
+    return cache_->lookup(makeRequest(path)).response_headers_ != nullptr;
+  }
+
+  uint64_t counter(absl::string_view name) {
+    return TestUtility::findCounter(stats_store_, absl::StrCat("cache.simple.", name))->value();
+  }
+
+  uint64_t gauge(absl::string_view name) {
+    return TestUtility::findGauge(stats_store_, absl::StrCat("cache.simple.", name))->value();
+  }
+
+  Stats::IsolatedStoreImpl stats_store_;
+  Event::SimulatedTimeSystem time_system_;
+  Http::TestRequestHeaderMapImpl request_headers_;
+  Http::TestResponseHeaderMapImpl response_headers_{{":status", "200"},
+                                                    {"cache-control", "public,max-age=3600"}};
+  VaryAllowList vary_allow_list_{
+      Protobuf::RepeatedPtrField<envoy::type::matcher::v3::StringMatcher>()};
+  std::unique_ptr<SimpleHttpCache> cache_;
+};
+
+TEST_F(SimpleHttpCacheEvictionTest, UnboundedNeverEvicts) {
+  initialize(4, 0);
+  for (int i = 0; i < 100; i++) {
+    EXPECT_TRUE(insert(absl::StrCat("/", i), std::string(1000, 'a')));
+  }
+  for (int i = 0; i < 100; i++) {
+    EXPECT_TRUE(lookup(absl::StrCat("/", i)));
+  }
+  EXPECT_EQ(0, counter("eviction"));
+  EXPECT_EQ(100, counter("lookup_hit"));
+  EXPECT_EQ(100, gauge("size_count"));
+}
+
+TEST_F(SimpleHttpCacheEvictionTest, EvictsLeastRecentlyUsed) {
+  // A single shard that fits two entries of ~1000 bytes but not three.
+  initialize(1, 2500);
+  EXPECT_TRUE(insert("/a", std::string(1000, 'a')));
+  EXPECT_TRUE(insert("/b", std::string(1000, 'b')));
+  // Touch /a so that /b becomes the least recently used entry.
+  EXPECT_TRUE(lookup("/a"));
+  EXPECT_TRUE(insert("/c", std::string(1000, 'c')));
+
+  EXPECT_TRUE(lookup("/a"));
+  EXPECT_FALSE(lookup("/b"));
+  EXPECT_TRUE(lookup("/c"));
+  EXPECT_EQ(1, counter("eviction"));
+  EXPECT_EQ(2, gauge("size_count"));
+  EXPECT_LE(gauge("size_bytes"), 2500);
+  EXPECT_EQ(1, counter("lookup_miss"));
+}
+
+TEST_F(SimpleHttpCacheEvictionTest, RejectsEntryLargerThanShard) {
+  initialize(2, 2000);
+  EXPECT_FALSE(insert("/big", std::string(1500, 'a')));
+  EXPECT_FALSE(lookup("/big"));
+  EXPECT_EQ(1, counter("insert_rejected"));
+  EXPECT_EQ(0, gauge("size_count"));
+  EXPECT_EQ(0, gauge("size_bytes"));
+}
+
+TEST_F(SimpleHttpCacheEvictionTest, BudgetSmallerThanShardCountIsBounded) {
+  // Each shard gets a budget of 1 byte rather than an unbounded one.
+  initialize(16, 8);
+  EXPECT_FALSE(insert("/a", "a"));
+  EXPECT_EQ(1, counter("insert_rejected"));
+  EXPECT_EQ(0, gauge("size_count"));
+}
+
+TEST_F(SimpleHttpCacheEvictionTest, ReplaceUpdatesSize) {
+  initialize(1, 0);
+  EXPECT_TRUE(insert("/a", std::string(1000, 'a')));
+  const uint64_t size = gauge("size_bytes");
+  EXPECT_TRUE(insert("/a", std::string(10, 'a')));
+  EXPECT_EQ(size - 990, gauge("size_bytes"));
+  EXPECT_EQ(1, gauge("size_count"));
+}
+
 } // namespace
 } // namespace Cache
 } // namespace HttpFilters
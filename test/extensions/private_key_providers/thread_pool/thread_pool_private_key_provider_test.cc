@@ -0,0 +1,261 @@
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "envoy/extensions/private_key_providers/thread_pool/v3/thread_pool.pb.h"
+
+#include "source/common/singleton/manager_impl.h"
+#include "source/extensions/private_key_providers/thread_pool/thread_pool_private_key_provider.h"
+
+#include "test/common/stats/stat_test_utility.h"
+#include "test/test_common/environment.h"
+#include "test/test_common/thread_factory_for_test.h"
+#include "test/test_common/utility.h"
+
+#include "absl/synchronization/notification.h"
+#include "absl/time/clock.h"
+#include "gtest/gtest.h"
+#include "openssl/evp.h"
+#include "openssl/pem.h"
+#include "openssl/rsa.h"
+#include "openssl/ssl.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace PrivateKeyMethodProvider {
+namespace ThreadPool {
+namespace {
+
+class TestCallbacks : public Ssl::PrivateKeyConnectionCallbacks {
+public:
+  explicit TestCallbacks(Event::Dispatcher& dispatcher) : dispatcher_(dispatcher) {}
+
+  // Ssl::PrivateKeyConnectionCallbacks
+  void onPrivateKeyMethodComplete() override {
+    completed_ = true;
+    dispatcher_.exit();
+  }
+
+  Event::Dispatcher& dispatcher_;
+  bool completed_{};
+};
+
+class ThreadPoolPrivateKeyMethodProviderTest : public testing::Test {
+protected:
+  ThreadPoolPrivateKeyMethodProviderTest()
+      : api_(Api::createApiForTest(store_)), dispatcher_(api_->allocateDispatcher("test_thread")),
+        ssl_ctx_(SSL_CTX_new(TLS_method())), ssl_(SSL_new(ssl_ctx_.get())),
+        callbacks_(*dispatcher_) {}
+
+  ~ThreadPoolPrivateKeyMethodProviderTest() override {
+    if (provider_ != nullptr) {
+      provider_->unregisterPrivateKeyMethod(ssl_.get());
+    }
+  }
+
+  static std::string keyPath(const std::string& key_file) {
+    return TestEnvironment::substitute(
+        "{{ test_rundir }}/test/extensions/transport_sockets/tls/test_data/" + key_file);
+  }
+
+  void createProvider(const std::string& key_file) {
+    config_.mutable_private_key()->set_filename(keyPath(key_file));
+    config_.mutable_thread_count()->set_value(2);
+    provider_ = std::make_unique<ThreadPoolPrivateKeyMethodProvider>(
+        config_, *api_, singleton_manager_, *store_.rootScope());
+    provider_->registerPrivateKeyMethod(ssl_.get(), callbacks_, *dispatcher_);
+    pkey_ = readKey(key_file);
+  }
+
+  static bssl::UniquePtr<EVP_PKEY> readKey(const std::string& key_file) {
+    const std::string key = TestEnvironment::readFileToStringForTest(keyPath(key_file));
+    bssl::UniquePtr<BIO> bio(BIO_new_mem_buf(key.data(), key.size()));
+    return bssl::UniquePtr<EVP_PKEY>(PEM_read_bio_PrivateKey(bio.get(), nullptr, nullptr, nullptr));
+  }
+
+  // Waits for the pending operation, and completes it.
+  ssl_private_key_result_t complete() {
+    dispatcher_->run(Event::Dispatcher::RunType::Block);
+    EXPECT_TRUE(callbacks_.completed_);
+    return provider_->getBoringSslPrivateKeyMethod()->complete(ssl_.get(), out_, &out_len_,
+                                                               sizeof(out_));
+  }
+
+  ssl_private_key_result_t sign(uint16_t signature_algorithm) {
+    return provider_->getBoringSslPrivateKeyMethod()->sign(
+        ssl_.get(), out_, &out_len_, sizeof(out_), signature_algorithm, in_, sizeof(in_));
+  }
+
+  bool verify(uint16_t signature_algorithm) {
+    bssl::ScopedEVP_MD_CTX ctx;
+    EVP_PKEY_CTX* pctx;
+    if (!EVP_DigestVerifyInit(ctx.get(), &pctx,
+                              SSL_get_signature_algorithm_digest(signature_algorithm), nullptr,
+                              pkey_.get())) {
+      return false;
+    }
+    if (SSL_is_signature_algorithm_rsa_pss(signature_algorithm) &&
+        (!EVP_PKEY_CTX_set_rsa_padding(pctx, RSA_PKCS1_PSS_PADDING) ||
+         !EVP_PKEY_CTX_set_rsa_pss_saltlen(pctx, -1))) {
+      return false;
+    }
+    return EVP_DigestVerify(ctx.get(), out_, out_len_, in_, sizeof(in_));
+  }
+
+  Stats::TestUtil::TestStore store_;
+  Api::ApiPtr api_;
+  Event::DispatcherPtr dispatcher_;
+  Singleton::ManagerImpl singleton_manager_{Thread::threadFactoryForTest()};
+  bssl::UniquePtr<SSL_CTX> ssl_ctx_;
+  bssl::UniquePtr<SSL> ssl_;
+  TestCallbacks callbacks_;
+  envoy::extensions::private_key_providers::thread_pool::v3::ThreadPoolPrivateKeyMethodConfig
+      config_;
+  std::unique_ptr<ThreadPoolPrivateKeyMethodProvider> provider_;
+  bssl::UniquePtr<EVP_PKEY> pkey_;
+
+  const uint8_t in_[32] = {0x7f};
+  uint8_t out_[512] = {0};
+  size_t out_len_{};
+};
+
+TEST_F(ThreadPoolPrivateKeyMethodProviderTest, RsaPkcs1Sign) {
+  createProvider("unittest_key.pem");
+  EXPECT_TRUE(provider_->isAvailable());
+  EXPECT_EQ(ssl_private_key_retry, sign(SSL_SIGN_RSA_PKCS1_SHA256));
+  EXPECT_EQ(ssl_private_key_success, complete());
+  EXPECT_TRUE(verify(SSL_SIGN_RSA_PKCS1_SHA256));
+  EXPECT_EQ(1, store_.counter("thread_pool_private_key_provider.operations").value());
+  EXPECT_EQ(0, store_.counter("thread_pool_private_key_provider.operation_failures").value());
+}
+
+TEST_F(ThreadPoolPrivateKeyMethodProviderTest, RsaPssSign) {
+  createProvider("unittest_key.pem");
+  EXPECT_EQ(ssl_private_key_retry, sign(SSL_SIGN_RSA_PSS_RSAE_SHA256));
+  EXPECT_EQ(ssl_private_key_success, complete());
+  EXPECT_TRUE(verify(SSL_SIGN_RSA_PSS_RSAE_SHA256));
+}
+
+TEST_F(ThreadPoolPrivateKeyMethodProviderTest, EcdsaSign) {
+  createProvider("selfsigned_ecdsa_p256_key.pem");
+  EXPECT_EQ(ssl_private_key_retry, sign(SSL_SIGN_ECDSA_SECP256R1_SHA256));
+  EXPECT_EQ(ssl_private_key_success, complete());
+  EXPECT_TRUE(verify(SSL_SIGN_ECDSA_SECP256R1_SHA256));
+}
+
+TEST_F(ThreadPoolPrivateKeyMethodProviderTest, RsaDecrypt) {
+  createProvider("unittest_key.pem");
+  RSA* rsa = EVP_PKEY_get0_RSA(pkey_.get());
+  std::vector<uint8_t> plaintext(RSA_size(rsa), 0x7f);
+  plaintext[0] = 0;
+  std::vector<uint8_t> ciphertext(RSA_size(rsa));
+  size_t ciphertext_len;
+  ASSERT_TRUE(RSA_encrypt(rsa, &ciphertext_len, ciphertext.data(), ciphertext.size(),
+                          plaintext.data(), plaintext.size(), RSA_NO_PADDING));
+
+  EXPECT_EQ(ssl_private_key_retry,
+            provider_->getBoringSslPrivateKeyMethod()->decrypt(
+                ssl_.get(), out_, &out_len_, sizeof(out_), ciphertext.data(), ciphertext_len));
+  EXPECT_EQ(ssl_private_key_success, complete());
+  EXPECT_EQ(plaintext, std::vector<uint8_t>(out_, out_ + out_len_));
+}
+
+TEST_F(ThreadPoolPrivateKeyMethodProviderTest, EcdsaDecryptFails) {
+  createProvider("selfsigned_ecdsa_p256_key.pem");
+  EXPECT_EQ(ssl_private_key_failure, provider_->getBoringSslPrivateKeyMethod()->decrypt(
+                                         ssl_.get(), out_, &out_len_, sizeof(out_), in_,
+                                         sizeof(in_)));
+}
+
+TEST_F(ThreadPoolPrivateKeyMethodProviderTest, MismatchedSignatureAlgorithmFails) {
+  createProvider("unittest_key.pem");
+  EXPECT_EQ(ssl_private_key_failure, sign(SSL_SIGN_ECDSA_SECP256R1_SHA256));
+  EXPECT_EQ(0, store_.counter("thread_pool_private_key_provider.operations").value());
+}
+
+// The handshake may be resumed before the operation is done.
+TEST_F(ThreadPoolPrivateKeyMethodProviderTest, CompleteBeforeOperationIsDone) {
+  createProvider("unittest_key.pem");
+  EXPECT_EQ(ssl_private_key_retry, sign(SSL_SIGN_RSA_PKCS1_SHA256));
+  EXPECT_EQ(ssl_private_key_retry, provider_->getBoringSslPrivateKeyMethod()->complete(
+                                       ssl_.get(), out_, &out_len_, sizeof(out_)));
+  EXPECT_EQ(ssl_private_key_success, complete());
+  EXPECT_TRUE(verify(SSL_SIGN_RSA_PKCS1_SHA256));
+}
+
+TEST_F(ThreadPoolPrivateKeyMethodProviderTest, ConnectionClosedDuringOperation) {
+  createProvider("unittest_key.pem");
+  EXPECT_EQ(ssl_private_key_retry, sign(SSL_SIGN_RSA_PKCS1_SHA256));
+  provider_->unregisterPrivateKeyMethod(ssl_.get());
+  // The operation is either dropped, or skipped and never handed back to the dispatcher.
+  provider_.reset();
+  dispatcher_->run(Event::Dispatcher::RunType::NonBlock);
+  EXPECT_FALSE(callbacks_.completed_);
+}
+
+TEST_F(ThreadPoolPrivateKeyMethodProviderTest, InvalidKey) {
+  config_.mutable_private_key()->set_inline_string("not a key");
+  EXPECT_THROW_WITH_MESSAGE(
+      ThreadPoolPrivateKeyMethodProvider(config_, *api_, singleton_manager_, *store_.rootScope()),
+      EnvoyException, "Failed to read private key.");
+}
+
+// The providers with the same number of threads share a pool, and each bound their own queue.
+TEST_F(ThreadPoolPrivateKeyMethodProviderTest, ProvidersShareThePoolAndBoundTheirQueue) {
+  config_.mutable_private_key()->set_filename(keyPath("unittest_key.pem"));
+  config_.mutable_thread_count()->set_value(1);
+  config_.mutable_max_queue_depth()->set_value(1);
+  absl::Notification started;
+  absl::Notification release;
+  absl::Notification ran;
+  ThreadPoolPrivateKeyMethodProvider first(config_, *api_, singleton_manager_,
+                                           *store_.rootScope());
+  ThreadPoolPrivateKeyMethodProvider second(config_, *api_, singleton_manager_,
+                                            *store_.rootScope());
+  // Keep the only thread of the shared pool busy.
+  EXPECT_TRUE(first.post([&]() {
+    started.Notify();
+    release.WaitForNotification();
+  }));
+  started.WaitForNotification();
+
+  EXPECT_TRUE(second.post([&]() { ran.Notify(); }));
+  EXPECT_FALSE(second.post([]() {}));
+  EXPECT_EQ(1, store_.counter("thread_pool_private_key_provider.overflow").value());
+  // The queue of the first provider is empty.
+  EXPECT_TRUE(first.post([]() {}));
+  EXPECT_EQ(2, store_.gauge("thread_pool_private_key_provider.queue_depth",
+                            Stats::Gauge::ImportMode::Accumulate)
+                   .value());
+  EXPECT_FALSE(ran.HasBeenNotified());
+
+  release.Notify();
+  ran.WaitForNotification();
+}
+
+TEST(PrivateKeyThreadPoolTest, CancelDropsQueuedOperationsAndWaitsForRunningOnes) {
+  PrivateKeyThreadPool pool(Thread::threadFactoryForTest(), 1);
+  const int owner = 0;
+  const int other_owner = 1;
+  absl::Notification started;
+  absl::Notification ran;
+  bool done = false;
+  pool.post(&owner, [&]() {
+    started.Notify();
+    absl::SleepFor(absl::Milliseconds(10));
+    done = true;
+  });
+  pool.post(&owner, []() { FAIL(); });
+  pool.post(&other_owner, [&]() { ran.Notify(); });
+  started.WaitForNotification();
+
+  EXPECT_EQ(1, pool.cancel(&owner));
+  EXPECT_TRUE(done);
+  ran.WaitForNotification();
+}
+
+} // namespace
+} // namespace ThreadPool
+} // namespace PrivateKeyMethodProvider
+} // namespace Extensions
+} // namespace Envoy
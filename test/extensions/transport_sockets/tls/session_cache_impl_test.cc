@@ -0,0 +1,184 @@
+#include <chrono>
+#include <string>
+
+#include "envoy/extensions/transport_sockets/tls/v3/tls.pb.h"
+
+#include "source/extensions/transport_sockets/tls/session_cache_impl.h"
+
+#include "test/mocks/event/mocks.h"
+#include "test/test_common/environment.h"
+#include "test/test_common/file_system_for_test.h"
+#include "test/test_common/simulated_time_system.h"
+#include "test/test_common/utility.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+using testing::_;
+using testing::NiceMock;
+
+namespace Envoy {
+namespace Extensions {
+namespace TransportSockets {
+namespace Tls {
+namespace {
+
+class SessionCacheImplTest : public testing::Test {
+protected:
+  SessionCacheImplTest() { time_system_.setSystemTime(std::chrono::seconds(1000)); }
+
+  SystemTime inSeconds(uint64_t seconds) {
+    return time_system_.systemTime() + std::chrono::seconds(seconds);
+  }
+
+  Event::SimulatedTimeSystem time_system_;
+  SessionCacheImpl cache_{100, time_system_};
+};
+
+TEST_F(SessionCacheImplTest, InsertLookupRemove) {
+  EXPECT_EQ(absl::nullopt, cache_.lookup("id"));
+  cache_.insert("id", "session", inSeconds(10));
+  EXPECT_EQ("session", cache_.lookup("id"));
+  cache_.insert("id", "new_session", inSeconds(10));
+  EXPECT_EQ("new_session", cache_.lookup("id"));
+  cache_.remove("id");
+  EXPECT_EQ(absl::nullopt, cache_.lookup("id"));
+  cache_.remove("id");
+}
+
+TEST_F(SessionCacheImplTest, ExpiredSessionIsNotFound) {
+  cache_.insert("id", "session", inSeconds(10));
+  time_system_.advanceTimeWait(std::chrono::seconds(9));
+  EXPECT_EQ("session", cache_.lookup("id"));
+  time_system_.advanceTimeWait(std::chrono::seconds(1));
+  EXPECT_EQ(absl::nullopt, cache_.lookup("id"));
+}
+
+TEST_F(SessionCacheImplTest, EvictsOldestSessions) {
+  // Each shard keeps a single session.
+  SessionCacheImpl cache(SessionCacheImpl::NumShards, time_system_);
+  uint32_t found = 0;
+  for (uint32_t i = 0; i < 10 * SessionCacheImpl::NumShards; ++i) {
+    cache.insert(std::to_string(i), "session", inSeconds(10));
+    EXPECT_EQ("session", cache.lookup(std::to_string(i)));
+  }
+  for (uint32_t i = 0; i < 10 * SessionCacheImpl::NumShards; ++i) {
+    found += cache.lookup(std::to_string(i)).has_value();
+  }
+  EXPECT_GT(found, 0);
+  EXPECT_LE(found, SessionCacheImpl::NumShards);
+}
+
+TEST_F(SessionCacheImplTest, SerializeAndLoad) {
+  cache_.insert("id1", "session1", inSeconds(10));
+  cache_.insert("id2", "session2", inSeconds(20));
+  cache_.insert("id3", "session3", inSeconds(30));
+  const std::string serialized = cache_.serializeSessions();
+
+  time_system_.advanceTimeWait(std::chrono::seconds(15));
+  SessionCacheImpl loaded_cache(100, time_system_);
+  EXPECT_EQ(2, loaded_cache.loadSessions(serialized));
+  EXPECT_EQ(absl::nullopt, loaded_cache.lookup("id1"));
+  EXPECT_EQ("session2", loaded_cache.lookup("id2"));
+  EXPECT_EQ("session3", loaded_cache.lookup("id3"));
+
+  // A truncated session is ignored.
+  SessionCacheImpl truncated_cache(100, time_system_);
+  EXPECT_EQ(1, truncated_cache.loadSessions(serialized.substr(0, serialized.size() - 1)));
+  EXPECT_EQ(0, truncated_cache.loadSessions("garbage"));
+}
+
+class SessionCacheManagerImplTest : public testing::Test {
+protected:
+  SessionCacheManagerImplTest() : path_(TestEnvironment::temporaryPath("tls_session_cache")) {
+    TestEnvironment::removePath(path_);
+    time_system_.setSystemTime(std::chrono::seconds(1000));
+  }
+
+  std::unique_ptr<SessionCacheManagerImpl> createManager() {
+    return std::make_unique<SessionCacheManagerImpl>(dispatcher_, Filesystem::fileSystemForTest(),
+                                                     time_system_);
+  }
+
+  NiceMock<Event::MockDispatcher> dispatcher_;
+  Event::SimulatedTimeSystem time_system_;
+  const std::string path_;
+};
+
+TEST_F(SessionCacheManagerImplTest, CachesAreSharedByName) {
+  auto manager = createManager();
+  envoy::extensions::transport_sockets::tls::v3::TlsSharedSessionCache config;
+  config.set_name("a");
+  Ssl::SessionCacheSharedPtr cache_a = manager->getCache(config);
+  EXPECT_EQ(cache_a, manager->getCache(config));
+  config.set_name("b");
+  EXPECT_NE(cache_a, manager->getCache(config));
+}
+
+TEST_F(SessionCacheManagerImplTest, ConflictingSettingsAreRejected) {
+  auto manager = createManager();
+  envoy::extensions::transport_sockets::tls::v3::TlsSharedSessionCache config;
+  config.set_name("a");
+  manager->getCache(config);
+
+  envoy::extensions::transport_sockets::tls::v3::TlsSharedSessionCache conflicting = config;
+  conflicting.mutable_max_sessions()->set_value(10);
+  EXPECT_THROW_WITH_REGEX(manager->getCache(conflicting), EnvoyException,
+                          "TLS session cache 'a' is configured with different settings");
+
+  conflicting = config;
+  conflicting.set_persist_path(path_);
+  EXPECT_THROW(manager->getCache(conflicting), EnvoyException);
+
+  conflicting = config;
+  conflicting.mutable_persist_interval()->set_seconds(1);
+  EXPECT_THROW(manager->getCache(conflicting), EnvoyException);
+
+  // The defaults may also be set explicitly.
+  config.mutable_max_sessions()->set_value(20480);
+  config.mutable_persist_interval()->set_seconds(10);
+  EXPECT_NO_THROW(manager->getCache(config));
+}
+
+TEST_F(SessionCacheManagerImplTest, PersistAndLoad) {
+  envoy::extensions::transport_sockets::tls::v3::TlsSharedSessionCache config;
+  config.set_name("a");
+  config.set_persist_path(path_);
+
+  // The file is not created by Envoy.
+  {
+    auto* timer = new NiceMock<Event::MockTimer>(&dispatcher_);
+    auto manager = createManager();
+    manager->getCache(config)->insert("id", "session", time_system_.systemTime() +
+                                                           std::chrono::seconds(10));
+    timer->invokeCallback();
+    EXPECT_FALSE(Filesystem::fileSystemForTest().fileExists(path_));
+  }
+
+  TestEnvironment::writeStringToFileForTest(path_, "", true);
+  {
+    auto* timer = new NiceMock<Event::MockTimer>(&dispatcher_);
+    EXPECT_CALL(*timer, enableTimer(std::chrono::milliseconds(10000), _)).Times(2);
+    auto manager = createManager();
+    Ssl::SessionCacheSharedPtr cache = manager->getCache(config);
+    EXPECT_EQ(absl::nullopt, cache->lookup("id"));
+    cache->insert("id", "session", time_system_.systemTime() + std::chrono::seconds(10));
+    timer->invokeCallback();
+    EXPECT_NE("", TestEnvironment::readFileToStringForTest(path_));
+    // The sessions are written to a temporary file which replaces the persisted one.
+    EXPECT_FALSE(Filesystem::fileSystemForTest().fileExists(path_ + ".tmp"));
+  }
+
+  // As in the child of a hot restart.
+  {
+    new NiceMock<Event::MockTimer>(&dispatcher_);
+    auto manager = createManager();
+    EXPECT_EQ("session", manager->getCache(config)->lookup("id"));
+  }
+}
+
+} // namespace
+} // namespace Tls
+} // namespace TransportSockets
+} // namespace Extensions
+} // namespace Envoy
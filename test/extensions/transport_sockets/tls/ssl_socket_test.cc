@@ -4276,6 +4276,31 @@ TEST_P(SslSocketTest, SessionResumptionEnabledByDefault) {
   testSupportForSessionResumption(server_ctx_yaml, client_ctx_yaml, true, true, version_);
 }
 
+// Sessions established on one listener are resumed on another listener, which has a server context
+// of its own, when both share a session cache.
+TEST_P(SslSocketTest, StatefulSessionResumptionWithSharedSessionCache) {
+  const std::string server_ctx_yaml = R"EOF(
+  common_tls_context:
+    tls_params:
+      tls_maximum_protocol_version: TLSv1_2
+    tls_certificates:
+      certificate_chain:
+        filename: "{{ test_rundir }}/test/extensions/transport_sockets/tls/test_data/unittest_cert.pem"
+      private_key:
+        filename: "{{ test_rundir }}/test/extensions/transport_sockets/tls/test_data/unittest_key.pem"
+  disable_stateless_session_resumption: true
+  shared_session_cache:
+    name: test
+)EOF";
+
+  const std::string client_ctx_yaml = R"EOF(
+    common_tls_context:
+  )EOF";
+
+  testTicketSessionResumption(server_ctx_yaml, {}, server_ctx_yaml, {}, client_ctx_yaml, true,
+                              version_);
+}
+
 // Test that if two listeners use the same cert and session ticket key, but
 // different client CA, that sessions cannot be resumed.
 TEST_P(SslSocketTest, ClientAuthCrossListenerSessionResumption) {
@@ -41,6 +41,8 @@ public:
   ~MockOpaqueResourceDecoder() override;
 
   MOCK_METHOD(ProtobufTypes::MessagePtr, decodeResource, (const ProtobufWkt::Any& resource));
+  MOCK_METHOD(PreDecodedResource, preDecodeResource, (const ProtobufWkt::Any& resource));
+  MOCK_METHOD(ProtobufTypes::MessagePtr, finishDecodeResource, (PreDecodedResource && pre_decoded));
   MOCK_METHOD(std::string, resourceName, (const Protobuf::Message& resource));
 };
 
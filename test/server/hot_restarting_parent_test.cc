@@ -239,7 +239,8 @@ TEST_F(HotRestartingParentTest, ExportStatsToChild) {
     EXPECT_EQ(123, stats.gauges().at("g1"));
     EXPECT_EQ(456, stats.gauges().at("g2"));
   }
-  // When a counter has not changed since its last export, it should not be included in the message.
+  // When a counter or gauge has not changed since its last export, it should not be included in
+  // the message.
   {
     store.counter("c2").add(2);
     store.gauge("g1", Stats::Gauge::ImportMode::Accumulate).add(1);
@@ -248,10 +249,19 @@ TEST_F(HotRestartingParentTest, ExportStatsToChild) {
     hot_restarting_parent_.exportStatsToChild(&stats);
     EXPECT_EQ(stats.counter_deltas().end(), stats.counter_deltas().find("c1"));
     EXPECT_EQ(2, stats.counter_deltas().at("c2")); // 4 is the value, but 2 is the delta
-    EXPECT_EQ(0, stats.gauges().at("g0"));
+    EXPECT_EQ(stats.gauges().end(), stats.gauges().find("g0"));
     EXPECT_EQ(124, stats.gauges().at("g1"));
     EXPECT_EQ(455, stats.gauges().at("g2"));
   }
+  // A gauge which returns to an earlier value is still exported, as it changed since the last
+  // export.
+  {
+    store.gauge("g1", Stats::Gauge::ImportMode::Accumulate).sub(1);
+    HotRestartMessage::Reply::Stats stats;
+    hot_restarting_parent_.exportStatsToChild(&stats);
+    EXPECT_EQ(123, stats.gauges().at("g1"));
+    EXPECT_EQ(stats.gauges().end(), stats.gauges().find("g2"));
+  }
 
   // When a counter and gauge are not used, they should not be included in the message.
   {